@@ -96,57 +96,11 @@ inline void AdjList::read_edgelist(
     bool directed
 ) {
 
-    int i,j;
-    std::ifstream filei(fn);
-
-    if (!filei)
-        throw std::logic_error("The file " + fn + " was not found.");
-
-    int linenum = 0;
     std::vector< int > source_;
     std::vector< int > target_;
+    read_edgelist_text(fn, source_, target_, skip);
 
-    source_.reserve(1e5);
-    target_.reserve(1e5);
-
-    int max_id = size - 1;
-
-    while (!filei.eof())
-    {
-
-        if (linenum++ < skip)
-            continue;
-
-        filei >> i >> j;
-
-        // Looking for exceptions
-        if (filei.bad())
-            throw std::logic_error(
-                "I/O error while reading the file " +
-                fn
-            );
-
-        if (filei.fail())
-            break;
-
-        if (i > max_id)
-            throw std::range_error(
-                "The source["+std::to_string(linenum)+"] = " + std::to_string(i) +
-                " is above the max_id " + std::to_string(max_id)
-                );
-
-        if (j > max_id)
-            throw std::range_error(
-                "The target["+std::to_string(linenum)+"] = " + std::to_string(j) +
-                " is above the max_id " + std::to_string(max_id)
-                );
-
-        source_.push_back(i);
-        target_.push_back(j);
-
-    }
-
-    // Now using the right constructor
+    // Now using the right constructor (checks the ids)
     *this = AdjList(source_, target_, size, directed);
 
     return;
@@ -25,6 +25,9 @@ class Tools_const;
 template<typename TSeq>
 class Queue;
 
+template<typename TSeq>
+class StateSets;
+
 template<typename TSeq>
 struct Event;
 
@@ -70,6 +73,7 @@ class Agent {
     friend class Tools<TSeq>;
     friend class Tools_const<TSeq>;
     friend class Queue<TSeq>;
+    friend class StateSets<TSeq>;
     friend class Entities<TSeq>;
     friend class AgentsSample<TSeq>;
     friend void default_add_virus<TSeq>(Event<TSeq> & a, Model<TSeq> * m);
@@ -87,6 +91,14 @@ private:
     std::vector< size_t > neighbors_locations;
     size_t n_neighbors = 0u;
 
+    /**
+     * @brief Pointer to the ids of the neighbors
+     * 
+     * @details Points either to `neighbors` or, if the model uses the CSR
+     * network backend, to the agent's row in `Model::network_csr`.
+     */
+    const size_t * get_neighbors_ids() const;
+
     std::vector< size_t > entities;
     std::vector< size_t > entities_locations;
     size_t n_entities = 0u;
@@ -246,6 +258,13 @@ public:
     );
 
     std::vector< Agent<TSeq> * > get_neighbors();
+
+    /**
+     * @brief Non-allocating view of the neighbors
+     * 
+     * @return Neighbors<TSeq> Iterating over it yields `Agent<TSeq> *`.
+     */
+    Neighbors<TSeq> get_neighbors_view();
     size_t get_n_neighbors() const;
 
     void change_state(
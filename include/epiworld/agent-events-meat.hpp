@@ -23,6 +23,8 @@ inline void default_add_virus(Event<TSeq> & a, Model<TSeq> * m)
 
     }
     
+    // Each carrier gets its own infection record (agent, date, data), but
+    // the per-variant members are shared with v (see Virus::Shared)
     p->virus = std::make_shared< Virus<TSeq> >(*v);
     p->virus->set_date(m->today());
     p->virus->set_agent(p);
@@ -50,11 +50,11 @@ inline void default_update_exposed(Agent<TSeq> * p, Model<TSeq> * m) {
 
     // Die
     auto & virus = p->get_virus();
-    m->array_double_tmp[0u] = 
+    m->get_array_double_tmp()[0u] = 
         virus->get_prob_death(m) * (1.0 - p->get_death_reduction(virus, m)); 
 
     // Recover
-    m->array_double_tmp[1u] = 
+    m->get_array_double_tmp()[1u] = 
         1.0 - (1.0 - virus->get_prob_recovery(m)) * (1.0 - p->get_recovery_enhancer(virus, m)); 
     
 
@@ -80,4 +80,82 @@ inline void default_update_exposed(Agent<TSeq> * p, Model<TSeq> * m) {
 
 }
 
-#endif
\ No newline at end of file
+/**
+ * @brief Event-driven version of `default_update_exposed()`
+ * 
+ * @details `default_update_exposed()` runs a roulette between death and
+ * recovery every day, so the agent leaves the state with a constant daily
+ * probability `1 - P(none)`. `default_timer_exposed()` draws the number of
+ * days until that happens (geometric), and `default_transition_exposed()`
+ * picks the event on that day, conditional on one happening (with the
+ * weights of the roulette). See `Model::set_state_timer()`.
+ */
+///@{
+template<typename TSeq = EPI_DEFAULT_TSEQ>
+inline int default_timer_exposed(Agent<TSeq> * p, Model<TSeq> * m) {
+
+    if (p->get_virus() == nullptr)
+        throw std::logic_error(
+            std::string("Using the -default_timer_exposed- on agents WITHOUT viruses makes no sense! ") +
+            std::string("Agent id ") + std::to_string(p->get_id()) + std::string(" has no virus registered.")
+            );
+
+    auto & virus = p->get_virus();
+    epiworld_double p_die =
+        virus->get_prob_death(m) * (1.0 - p->get_death_reduction(virus, m));
+
+    epiworld_double p_rec =
+        1.0 - (1.0 - virus->get_prob_recovery(m)) * (1.0 - p->get_recovery_enhancer(virus, m));
+
+    if ((p_die >= 1.0) || (p_rec >= 1.0))
+        return 1;
+
+    // P(none) = 1 / (1 + sum of the odds), see roulette()
+    epiworld_double odds = p_die / (1.0 - p_die) + p_rec / (1.0 - p_rec);
+
+    return m->rgeom(odds / (1.0 + odds));
+
+}
+
+template<typename TSeq = EPI_DEFAULT_TSEQ>
+inline void default_transition_exposed(Agent<TSeq> * p, Model<TSeq> * m) {
+
+    if (p->get_virus() == nullptr)
+        throw std::logic_error(
+            std::string("Using the -default_transition_exposed- on agents WITHOUT viruses makes no sense! ") +
+            std::string("Agent id ") + std::to_string(p->get_id()) + std::string(" has no virus registered.")
+            );
+
+    auto & virus = p->get_virus();
+    epiworld_double p_die =
+        virus->get_prob_death(m) * (1.0 - p->get_death_reduction(virus, m));
+
+    epiworld_double p_rec =
+        1.0 - (1.0 - virus->get_prob_recovery(m)) * (1.0 - p->get_recovery_enhancer(virus, m));
+
+    // Certain events are drawn uniformly, the rest by their odds
+    bool die;
+    if ((p_die >= 1.0) && (p_rec >= 1.0))
+        die = m->runif() < 0.5;
+    else if ((p_die >= 1.0) || (p_rec >= 1.0))
+        die = p_die >= 1.0;
+    else
+    {
+
+        epiworld_double odds_die = p_die / (1.0 - p_die);
+        epiworld_double odds_rec = p_rec / (1.0 - p_rec);
+        die = (m->runif() * (odds_die + odds_rec)) < odds_die;
+
+    }
+
+    if (die)
+        p->rm_agent_by_virus(m);
+    else
+        p->rm_virus(m);
+
+    return ;
+
+}
+///@}
+
+#endif
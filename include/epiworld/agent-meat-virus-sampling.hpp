@@ -43,7 +43,7 @@ inline std::function<void(Agent<TSeq>*,Model<TSeq>*)> make_update_susceptible(
 
                 // This computes the prob of getting any neighbor variant
                 size_t nviruses_tmp = 0u;
-                for (auto & neighbor: p->get_neighbors()) 
+                for (auto * neighbor: p->get_neighbors_view()) 
                 {
                     
                     auto & v = neighbor->get_virus();
@@ -51,13 +51,13 @@ inline std::function<void(Agent<TSeq>*,Model<TSeq>*)> make_update_susceptible(
                         continue;
                     
                     /* And it is a function of susceptibility_reduction as well */ 
-                    m->array_double_tmp[nviruses_tmp] =
+                    m->get_array_double_tmp()[nviruses_tmp] =
                         (1.0 - p->get_susceptibility_reduction(v, m)) * 
                         v->get_prob_infecting(m) * 
                         (1.0 - neighbor->get_transmission_reduction(v, m)) 
                         ; 
                 
-                    m->array_virus_tmp[nviruses_tmp++] = &(*v);
+                    m->get_array_virus_tmp()[nviruses_tmp++] = &(*v);
                         
                 }
 
@@ -71,7 +71,7 @@ inline std::function<void(Agent<TSeq>*,Model<TSeq>*)> make_update_susceptible(
                 if (which < 0)
                     return;
 
-                p->set_virus(*m->array_virus_tmp[which], m);
+                p->set_virus(*m->get_array_virus_tmp()[which], m);
 
                 return; 
             };
@@ -121,7 +121,7 @@ inline std::function<void(Agent<TSeq>*,Model<TSeq>*)> make_update_susceptible(
 
                 // This computes the prob of getting any neighbor variant
                 size_t nviruses_tmp = 0u;
-                for (auto & neighbor: p->get_neighbors()) 
+                for (auto * neighbor: p->get_neighbors_view()) 
                 {
 
                     // If the state is in the list, exclude it
@@ -134,13 +134,13 @@ inline std::function<void(Agent<TSeq>*,Model<TSeq>*)> make_update_susceptible(
                             
                 
                     /* And it is a function of susceptibility_reduction as well */ 
-                    m->array_double_tmp[nviruses_tmp] =
+                    m->get_array_double_tmp()[nviruses_tmp] =
                         (1.0 - p->get_susceptibility_reduction(v, m)) * 
                         v->get_prob_infecting(m) * 
                         (1.0 - neighbor->get_transmission_reduction(v, m)) 
                         ; 
                 
-                    m->array_virus_tmp[nviruses_tmp++] = &(*v);
+                    m->get_array_virus_tmp()[nviruses_tmp++] = &(*v);
                     
                 }
 
@@ -154,7 +154,7 @@ inline std::function<void(Agent<TSeq>*,Model<TSeq>*)> make_update_susceptible(
                 if (which < 0)
                     return;
 
-                p->set_virus(*m->array_virus_tmp[which], m); 
+                p->set_virus(*m->get_array_virus_tmp()[which], m); 
 
                 return;
 
@@ -199,7 +199,7 @@ inline std::function<Virus<TSeq>*(Agent<TSeq>*,Model<TSeq>*)> make_sample_virus_
 
                 // This computes the prob of getting any neighbor variant
                 size_t nviruses_tmp = 0u;
-                for (auto & neighbor: p->get_neighbors()) 
+                for (auto * neighbor: p->get_neighbors_view()) 
                 {
                     
                     if (neighbor->get_virus() == nullptr)
@@ -208,18 +208,18 @@ inline std::function<Virus<TSeq>*(Agent<TSeq>*,Model<TSeq>*)> make_sample_virus_
                     auto & v = neighbor->get_virus();
 
                     #ifdef EPI_DEBUG
-                    if (nviruses_tmp >= static_cast<int>(m->array_virus_tmp.size()))
+                    if (nviruses_tmp >= static_cast<int>(m->get_array_virus_tmp().size()))
                         throw std::logic_error("Trying to add an extra element to a temporal array outside of the range.");
                     #endif
                         
                     /* And it is a function of susceptibility_reduction as well */ 
-                    m->array_double_tmp[nviruses_tmp] =
+                    m->get_array_double_tmp()[nviruses_tmp] =
                         (1.0 - p->get_susceptibility_reduction(v, m)) * 
                         v->get_prob_infecting(m) * 
                         (1.0 - neighbor->get_transmission_reduction(v, m)) 
                         ; 
                 
-                    m->array_virus_tmp[nviruses_tmp++] = &(*v);
+                    m->get_array_virus_tmp()[nviruses_tmp++] = &(*v);
                     
                 }
 
@@ -233,7 +233,7 @@ inline std::function<Virus<TSeq>*(Agent<TSeq>*,Model<TSeq>*)> make_sample_virus_
                 if (which < 0)
                     return nullptr;
 
-                return m->array_virus_tmp[which]; 
+                return m->get_array_virus_tmp()[which]; 
 
             };
 
@@ -283,7 +283,7 @@ inline std::function<Virus<TSeq>*(Agent<TSeq>*,Model<TSeq>*)> make_sample_virus_
 
                 // This computes the prob of getting any neighbor variant
                 size_t nviruses_tmp = 0u;
-                for (auto & neighbor: p->get_neighbors()) 
+                for (auto * neighbor: p->get_neighbors_view()) 
                 {
 
                     // If the state is in the list, exclude it
@@ -296,18 +296,18 @@ inline std::function<Virus<TSeq>*(Agent<TSeq>*,Model<TSeq>*)> make_sample_virus_
                     auto & v = neighbor->get_virus();
                             
                     #ifdef EPI_DEBUG
-                    if (nviruses_tmp >= static_cast<int>(m->array_virus_tmp.size()))
+                    if (nviruses_tmp >= static_cast<int>(m->get_array_virus_tmp().size()))
                         throw std::logic_error("Trying to add an extra element to a temporal array outside of the range.");
                     #endif
                         
                     /* And it is a function of susceptibility_reduction as well */ 
-                    m->array_double_tmp[nviruses_tmp] =
+                    m->get_array_double_tmp()[nviruses_tmp] =
                         (1.0 - p->get_susceptibility_reduction(v, m)) * 
                         v->get_prob_infecting(m) * 
                         (1.0 - neighbor->get_transmission_reduction(v, m)) 
                         ; 
                 
-                    m->array_virus_tmp[nviruses_tmp++] = &(*v);
+                    m->get_array_virus_tmp()[nviruses_tmp++] = &(*v);
                     
                 }
 
@@ -321,7 +321,7 @@ inline std::function<Virus<TSeq>*(Agent<TSeq>*,Model<TSeq>*)> make_sample_virus_
                 if (which < 0)
                     return nullptr;
 
-                return m->array_virus_tmp[which]; 
+                return m->get_array_virus_tmp()[which]; 
 
             };
 
@@ -360,7 +360,7 @@ inline Virus<TSeq> * sample_virus_single(Agent<TSeq> * p, Model<TSeq> * m)
 
     // This computes the prob of getting any neighbor variant
     size_t nviruses_tmp = 0u;
-    for (auto & neighbor: p->get_neighbors()) 
+    for (auto * neighbor: p->get_neighbors_view()) 
     {   
         #ifdef EPI_DEBUG
         int _vcount_neigh = 0;
@@ -372,30 +372,30 @@ inline Virus<TSeq> * sample_virus_single(Agent<TSeq> * p, Model<TSeq> * m)
         auto & v = neighbor->get_virus();
 
         #ifdef EPI_DEBUG
-        if (nviruses_tmp >= m->array_virus_tmp.size())
+        if (nviruses_tmp >= m->get_array_virus_tmp().size())
             throw std::logic_error("Trying to add an extra element to a temporal array outside of the range.");
         #endif
             
         /* And it is a function of susceptibility_reduction as well */ 
-        m->array_double_tmp[nviruses_tmp] =
+        m->get_array_double_tmp()[nviruses_tmp] =
             (1.0 - p->get_susceptibility_reduction(v, m)) * 
             v->get_prob_infecting(m) * 
             (1.0 - neighbor->get_transmission_reduction(v, m)) 
             ; 
     
-        m->array_virus_tmp[nviruses_tmp++] = &(*v);
+        m->get_array_virus_tmp()[nviruses_tmp++] = &(*v);
 
         #ifdef EPI_DEBUG
         if (
-            (m->array_double_tmp[nviruses_tmp - 1] < 0.0) |
-            (m->array_double_tmp[nviruses_tmp - 1] > 1.0)
+            (m->get_array_double_tmp()[nviruses_tmp - 1] < 0.0) |
+            (m->get_array_double_tmp()[nviruses_tmp - 1] > 1.0)
             )
         {
             printf_epiworld(
                 "[epi-debug] Agent %i's virus %i has transmission prob outside of [0, 1]: %.4f!\n",
                 static_cast<int>(neighbor->get_id()),
                 static_cast<int>(_vcount_neigh++),
-                m->array_double_tmp[nviruses_tmp - 1]
+                m->get_array_double_tmp()[nviruses_tmp - 1]
                 );
         }
         #endif
@@ -421,7 +421,7 @@ inline Virus<TSeq> * sample_virus_single(Agent<TSeq> * p, Model<TSeq> * m)
     m->get_db().n_transmissions_today++;
     #endif
 
-    return m->array_virus_tmp[which]; 
+    return m->get_array_virus_tmp()[which]; 
     
 }
 
@@ -192,8 +192,8 @@ inline void Agent<TSeq>::set_virus(
             " has not been registered. There are only " + std::to_string(model->get_n_viruses()) + 
             " included in the model.");
 
-    CHECK_COALESCE_(state_new, virus->state_init, state);
-    CHECK_COALESCE_(queue, virus->queue_init, Queue<TSeq>::NoOne);
+    CHECK_COALESCE_(state_new, virus->shared->state_init, state);
+    CHECK_COALESCE_(queue, virus->shared->queue_init, Queue<TSeq>::NoOne);
 
     model->events_add(
         this, virus, nullptr, nullptr, state_new, queue, default_add_virus<TSeq>, -1, -1
@@ -303,8 +303,8 @@ inline void Agent<TSeq>::rm_virus(
             "There is no virus to remove here!"
         );
 
-    CHECK_COALESCE_(state_new, virus->state_post, state);
-    CHECK_COALESCE_(queue, virus->queue_post, Queue<TSeq>::Everyone);
+    CHECK_COALESCE_(state_new, virus->shared->state_post, state);
+    CHECK_COALESCE_(queue, virus->shared->queue_post, Queue<TSeq>::Everyone);
 
     model->events_add(
         this, virus, nullptr, nullptr, state_new, queue,
@@ -401,8 +401,8 @@ inline void Agent<TSeq>::rm_agent_by_virus(
 )
 {
 
-    CHECK_COALESCE_(state_new, virus->state_removed, state);
-    CHECK_COALESCE_(queue, virus->queue_removed, Queue<TSeq>::Everyone);
+    CHECK_COALESCE_(state_new, virus->shared->state_removed, state);
+    CHECK_COALESCE_(queue, virus->shared->queue_removed, Queue<TSeq>::Everyone);
 
     model->events_add(
         this, virus, nullptr, nullptr, state_new, queue,
@@ -497,6 +497,17 @@ inline void Agent<TSeq>::add_neighbor(
     bool check_source,
     bool check_target
 ) {
+
+    if ((model != nullptr) && model->use_network_csr)
+        throw std::logic_error(
+            "Ties cannot be added to agents when the model uses the CSR " 
+            "network backend. Load the network with -agents_from_edgelist- "
+            "or -agents_from_adjlist- instead."
+            );
+
+    if (model != nullptr)
+        model->network_backup_touch();
+
     // Can we find the neighbor?
     bool found = false;
     if (check_source)
@@ -558,6 +569,24 @@ inline void Agent<TSeq>::swap_neighbors(
 )
 {
 
+    // Saving the ties before they change (if needed)
+    model->network_backup_touch();
+
+    // Under CSR, the ties are swapped in the model's network
+    if (model->use_network_csr)
+    {
+
+        auto & net = model->network_csr;
+        net.swap_ties(
+            net.location(id, n_this),
+            net.location(other.id, n_other),
+            model->directed
+            );
+
+        return;
+
+    }
+
     // Getting the agents
     auto & pop = model->population;
     auto & neigh_this  = pop[neighbors[n_this]];
@@ -588,19 +617,45 @@ inline void Agent<TSeq>::swap_neighbors(
 
 }
 
+template<typename TSeq>
+inline const size_t * Agent<TSeq>::get_neighbors_ids() const
+{
+
+    if ((model != nullptr) && model->use_network_csr)
+        return model->network_csr.neighbors(id);
+
+    return neighbors.data();
+
+}
+
 template<typename TSeq>
 inline std::vector< Agent<TSeq> *> Agent<TSeq>::get_neighbors()
 {
-    std::vector< Agent<TSeq> * > res(n_neighbors, nullptr);
-    for (size_t i = 0u; i < n_neighbors; ++i)
-        res[i] = &model->population[neighbors[i]];
+    size_t n = get_n_neighbors();
+    const size_t * ids = get_neighbors_ids();
+
+    std::vector< Agent<TSeq> * > res(n, nullptr);
+    for (size_t i = 0u; i < n; ++i)
+        res[i] = &model->population[ids[i]];
 
     return res;
 }
 
+template<typename TSeq>
+inline Neighbors<TSeq> Agent<TSeq>::get_neighbors_view()
+{
+    return Neighbors<TSeq>(
+        get_neighbors_ids(), get_n_neighbors(), &model->population
+        );
+}
+
 template<typename TSeq>
 inline size_t Agent<TSeq>::get_n_neighbors() const
 {
+
+    if ((model != nullptr) && model->use_network_csr)
+        return model->network_csr.degree(id);
+
     return n_neighbors;
 }
 
@@ -746,7 +801,7 @@ inline void Agent<TSeq>::print(
             static_cast<int>(state),
             virus == nullptr ? std::string("no").c_str() : std::string("yes").c_str(),
             static_cast<int>(n_tools),
-            static_cast<int>(neighbors.size())
+            static_cast<int>(get_n_neighbors())
         );
     }
     else {
@@ -758,7 +813,7 @@ inline void Agent<TSeq>::print(
         printf_epiworld("  Has virus    : %s\n", virus == nullptr ?
             std::string("no").c_str() : std::string("yes").c_str());
         printf_epiworld("  Tool count   : %i\n", static_cast<int>(n_tools));
-        printf_epiworld("  Neigh. count : %i\n", static_cast<int>(neighbors.size()));
+        printf_epiworld("  Neigh. count : %i\n", static_cast<int>(get_n_neighbors()));
 
         size_t nfeats = model->get_agents_data_ncols();
         if (nfeats > 0)
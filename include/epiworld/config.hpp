@@ -28,6 +28,18 @@
     #define epiworld_fast_uint unsigned long long int
 #endif
 
+/**
+ * @brief Random number engine used by `Model` and `LFMCMC`
+ *
+ * @details Any `UniformRandomBitGenerator` with a `seed()` member works. Set
+ * it to `epiworld::Philox4x32` (defined in `math/philox.hpp`) for a small
+ * counter-based engine that is cheap to copy and can jump ahead in constant
+ * time.
+ */
+#ifndef epiworld_rng_engine
+    #define epiworld_rng_engine std::mt19937
+#endif
+
 #define EPI_DEFAULT_TSEQ int
 
 template<typename TSeq = EPI_DEFAULT_TSEQ>
@@ -84,9 +96,15 @@ using VirusFun = std::function<epiworld_double(Agent<TSeq>*,Virus<TSeq>&,Model<T
 template<typename TSeq = EPI_DEFAULT_TSEQ>
 using UpdateFun = std::function<void(Agent<TSeq>*,Model<TSeq>*)>;
 
+template<typename TSeq = EPI_DEFAULT_TSEQ>
+using TimerFun = std::function<int(Agent<TSeq>*,Model<TSeq>*)>;
+
 template<typename TSeq = EPI_DEFAULT_TSEQ>
 using GlobalFun = std::function<void(Model<TSeq>*)>;
 
+template<typename TSeq = EPI_DEFAULT_TSEQ>
+using StopFun = std::function<bool(Model<TSeq>*)>;
+
 template<typename TSeq>
 struct Event;
 
@@ -111,6 +129,21 @@ using ToolToAgentFun = std::function<void(Tool<TSeq>&,Model<TSeq>*)>;
 template<typename TSeq = EPI_DEFAULT_TSEQ>
 using EntityToAgentFun = std::function<void(Entity<TSeq>&,Model<TSeq>*)>;
 
+/**
+ * @brief Handle to a parameter of the model
+ * 
+ * @details Handles are resolved once with `Model::get_param_handle()` and
+ * index the contiguous array of parameters of the model, so
+ * `Model::par(ParamHandle)` does not need to look up the parameter by name.
+ * A handle is valid for the model that created it and for its copies, also
+ * after more parameters are added (unlike pointers to the values).
+ */
+struct ParamHandle {
+    size_t id = 0u;
+    ParamHandle() {};
+    explicit ParamHandle(size_t id_) : id(id_) {};
+};
+
 /**
  * @brief Event data for update an agent
  * 
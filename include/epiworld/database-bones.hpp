@@ -10,6 +10,9 @@ class Virus;
 template<typename TSeq>
 class UserData;
 
+template<typename TSeq>
+class RunAggregator;
+
 template<typename TSeq>
 inline void default_add_virus(Event<TSeq> & a, Model<TSeq> * m);
 
@@ -33,6 +36,7 @@ inline void default_change_state(Event<TSeq> & a, Model<TSeq> * m);
 template<typename TSeq>
 class DataBase {
     friend class Model<TSeq>;
+    friend class RunAggregator<TSeq>;
     friend void default_add_virus<TSeq>(Event<TSeq> & a, Model<TSeq> * m);
     friend void default_add_tool<TSeq>(Event<TSeq> & a, Model<TSeq> * m);
     friend void default_rm_virus<TSeq>(Event<TSeq> & a, Model<TSeq> * m);
@@ -70,34 +74,47 @@ private:
     
     int sampling_freq = 1;
 
-    // Variants history
-    std::vector< int > hist_virus_date;
-    std::vector< int > hist_virus_id;
-    std::vector< epiworld_fast_uint > hist_virus_state;
+    // History. Each recorded step adds its date to `hist_date` and a dense
+    // block of counts to each of the `hist_*_counts` arrays. The long format
+    // (date, id, state, counts) is built by `get_hist_*()` and `write_data()`.
+    std::vector< int > hist_date;               ///< Date of each recorded step
+
+    // Variants history, counts by (step, virus, state)
+    std::vector< size_t > hist_virus_offset;    ///< Start of each step in hist_virus_counts
     std::vector< int > hist_virus_counts;
 
-    // Tools history
-    std::vector< int > hist_tool_date;
-    std::vector< int > hist_tool_id;
-    std::vector< epiworld_fast_uint > hist_tool_state;
+    // Tools history, counts by (step, tool, state)
+    std::vector< size_t > hist_tool_offset;     ///< Start of each step in hist_tool_counts
     std::vector< int > hist_tool_counts;
 
     // Overall hist
-    std::vector< int > hist_total_date;
-    std::vector< int > hist_total_nviruses_active;
-    std::vector< epiworld_fast_uint > hist_total_state;
-    std::vector< int > hist_total_counts;
-    std::vector< int > hist_transition_matrix;
+    std::vector< int > hist_total_nviruses_active; ///< One per step
+    std::vector< int > hist_total_counts;          ///< By (step, state)
+    std::vector< int > hist_transition_matrix;     ///< By (step, to, from)
+
+    /**
+     * @brief Number of viruses (tools) recorded at step `k`
+     */
+    ///@{
+    size_t hist_virus_n(size_t k) const;
+    size_t hist_tool_n(size_t k) const;
+    ///@}
 
     // Transmission network
-    std::vector< int > transmission_date;                 ///< Date of the transmission event
-    std::vector< int > transmission_source;               ///< Id of the source
-    std::vector< int > transmission_target;               ///< Id of the target
-    std::vector< int > transmission_virus;              ///< Id of the variant
-    std::vector< int > transmission_source_exposure_date; ///< Date when the source acquired the variant
+    TransmissionLog transmissions;
 
     std::vector< int > transition_matrix;
 
+    // Reproductive numbers and generation times. Transmissions are added as
+    // they are recorded (if incremental_stats, in which case they do not
+    // depend on what the log keeps) or from the log when the statistics are
+    // requested. The log only grows during a run, so the number of
+    // transmissions it has seen tells whether the statistics are up to date.
+    mutable TransmissionStats transmission_stats;
+    mutable size_t transmission_stats_seen = 0u;
+    bool incremental_stats = false;
+    void update_transmission_stats() const;
+
     UserData<TSeq> user_data;
 
     void update_state(
@@ -120,6 +137,25 @@ private:
 
     void record_transition(epiworld_fast_uint from, epiworld_fast_uint to, bool undo);
 
+    /**
+     * @brief Tables written by `write_data()`, one per file
+     * 
+     * @details `new_table()` returns an empty table with `nrows` rows (with
+     * the thread column if `EPI_DEBUG` is defined).
+     */
+    ///@{
+    DataTable new_table(size_t nrows) const;
+    DataTable table_virus_info() const;
+    DataTable table_virus_hist() const;
+    DataTable table_tool_info() const;
+    DataTable table_tool_hist() const;
+    DataTable table_total_hist() const;
+    DataTable table_transmission() const;
+    DataTable table_transition() const;
+    DataTable table_reproductive_number() const;
+    DataTable table_generation_time() const;
+    ///@}
+
 
 public:
 
@@ -238,6 +274,25 @@ public:
     ) const;
     ///@}
 
+    /**
+     * @brief The transmission log (to set its capacity, sampling, etc.)
+     */
+    ///@{
+    TransmissionLog & get_transmission_log();
+    const TransmissionLog & get_transmission_log() const;
+    ///@}
+
+    /**
+     * @brief Writes the recorded data to files
+     * 
+     * @details Files with an empty name are skipped. Each file is formatted
+     * into memory and written at once.
+     * 
+     * @param binary If `true`, the files are written in the binary columnar
+     * format of `DataTable` instead of as text.
+     * @param writer If not `nullptr`, the files are queued in `writer` (and
+     * written in the background) instead of written before returning.
+     */
     void write_data(
         std::string fn_virus_info,
         std::string fn_virus_hist,
@@ -247,7 +302,9 @@ public:
         std::string fn_transmission,
         std::string fn_transition,
         std::string fn_reproductive_number,
-        std::string fn_generation_time
+        std::string fn_generation_time,
+        bool binary = false,
+        DataWriter * writer = nullptr
         ) const;
     
     /***
@@ -281,6 +338,41 @@ public:
         ) const;
     ///@}
 
+    /**
+     * @brief Reproductive number of each case, as vectors
+     * 
+     * @details Same as `reproductive_number()`, but without building a map
+     * keyed by vectors. Cases are sorted by virus, source, and date.
+     * 
+     * Without incremental statistics, the reproductive numbers are computed
+     * from the transmission log. If the log did not keep every transmission
+     * (ring buffer, sampling, or a virus filter), they would only cover part
+     * of the cases, so a `std::logic_error` is thrown instead.
+     */
+    void reproductive_number(
+        std::vector< int > & virus_id,
+        std::vector< int > & source,
+        std::vector< int > & source_exposure_date,
+        std::vector< int > & rt
+        ) const;
+
+    /**
+     * @brief Updates the reproductive numbers and generation times as
+     * transmissions are recorded
+     * 
+     * @details By default, they are computed (in one pass over the
+     * transmissions) the first time they are requested after a run. With
+     * incremental statistics, each call to `record_transmission()` updates
+     * them, so they are ready at the end of the run and do not depend on what
+     * the transmission log keeps. Turn them on before the run: once the log
+     * dropped transmissions, the ones already recorded cannot be added.
+     */
+    ///@{
+    void incremental_stats_on();
+    void incremental_stats_off();
+    bool is_incremental_stats_on() const;
+    ///@}
+
     /**
      * @brief Calculates the transition probabilities
      * 
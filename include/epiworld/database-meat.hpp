@@ -30,15 +30,22 @@ inline void DataBase<TSeq>::reset()
     for (size_t s = 0u; s < model->nstates; ++s)
         transition_matrix[s + s * model->nstates] = today_total[s];
 
-    hist_virus_date.clear();
-    hist_virus_id.clear();
-    hist_virus_state.clear();
+    // Preallocating the history (new variants may still grow it)
+    size_t nsteps = static_cast< size_t >(model->get_ndays()) /
+        static_cast< size_t >(sampling_freq) + 1u;
+
+    hist_date.clear();
+    hist_date.reserve(nsteps);
+
+    hist_virus_offset.clear();
+    hist_virus_offset.reserve(nsteps);
     hist_virus_counts.clear();
+    hist_virus_counts.reserve(nsteps * get_n_viruses() * model->nstates);
 
-    hist_tool_date.clear();
-    hist_tool_id.clear();
-    hist_tool_state.clear();
-    hist_tool_counts.clear();    
+    hist_tool_offset.clear();
+    hist_tool_offset.reserve(nsteps);
+    hist_tool_counts.clear();
+    hist_tool_counts.reserve(nsteps * get_n_tools() * model->nstates);
 
     today_virus.resize(get_n_viruses());
     std::fill(today_virus.begin(), today_virus.begin(), std::vector<int>(model->nstates, 0));
@@ -46,17 +53,17 @@ inline void DataBase<TSeq>::reset()
     today_tool.resize(get_n_tools());
     std::fill(today_tool.begin(), today_tool.begin(), std::vector<int>(model->nstates, 0));
 
-    hist_total_date.clear();
-    hist_total_state.clear();
     hist_total_nviruses_active.clear();
+    hist_total_nviruses_active.reserve(nsteps);
     hist_total_counts.clear();
+    hist_total_counts.reserve(nsteps * model->nstates);
     hist_transition_matrix.clear();
+    hist_transition_matrix.reserve(nsteps * transition_matrix.size());
+
+    transmissions.clear();
 
-    transmission_date.clear();
-    transmission_virus.clear();
-    transmission_source.clear();
-    transmission_target.clear();
-    transmission_source_exposure_date.clear();
+    transmission_stats.clear();
+    transmission_stats_seen = 0u;
 
     return;
 
@@ -84,29 +91,23 @@ inline DataBase<TSeq>::DataBase(const DataBase<TSeq> & db) :
     // Totals
     today_total_nviruses_active(db.today_total_nviruses_active),
     sampling_freq(db.sampling_freq),
+    hist_date(db.hist_date),
     // Variants history
-    hist_virus_date(db.hist_virus_date),
-    hist_virus_id(db.hist_virus_id),
-    hist_virus_state(db.hist_virus_state),
+    hist_virus_offset(db.hist_virus_offset),
     hist_virus_counts(db.hist_virus_counts),
     // Tools history
-    hist_tool_date(db.hist_tool_date),
-    hist_tool_id(db.hist_tool_id),
-    hist_tool_state(db.hist_tool_state),
+    hist_tool_offset(db.hist_tool_offset),
     hist_tool_counts(db.hist_tool_counts),
     // Overall hist
-    hist_total_date(db.hist_total_date),
     hist_total_nviruses_active(db.hist_total_nviruses_active),
-    hist_total_state(db.hist_total_state),
     hist_total_counts(db.hist_total_counts),
     hist_transition_matrix(db.hist_transition_matrix),
     // Transmission network
-    transmission_date(db.transmission_date),
-    transmission_source(db.transmission_source),
-    transmission_target(db.transmission_target),
-    transmission_virus(db.transmission_virus),
-    transmission_source_exposure_date(db.transmission_source_exposure_date),
+    transmissions(db.transmissions),
     transition_matrix(db.transition_matrix),
+    transmission_stats(db.transmission_stats),
+    transmission_stats_seen(db.transmission_stats_seen),
+    incremental_stats(db.incremental_stats),
     user_data(nullptr)
 {}
 
@@ -148,30 +149,20 @@ inline void DataBase<TSeq>::record()
 
     if (model->today() == 0)
     {
-        if (hist_total_date.size() != 0)
-            EPI_DEBUG_ERROR(std::logic_error, "DataBase::record hist_total_date should be of length 0.")
-        if (hist_total_nviruses_active.size() != 0)
-            EPI_DEBUG_ERROR(std::logic_error, "DataBase::record hist_total_nviruses_active should be of length 0.")
-        if (hist_total_state.size() != 0)
-            EPI_DEBUG_ERROR(std::logic_error, "DataBase::record hist_total_state should be of length 0.")
-        if (hist_total_counts.size() != 0)
-            EPI_DEBUG_ERROR(std::logic_error, "DataBase::record hist_total_counts should be of length 0.")
-        if (hist_virus_date.size() != 0)
-            EPI_DEBUG_ERROR(std::logic_error, "DataBase::record hist_virus_date should be of length 0.")
-        if (hist_virus_id.size() != 0)
-            EPI_DEBUG_ERROR(std::logic_error, "DataBase::record hist_virus_id should be of length 0.")
-        if (hist_virus_state.size() != 0)
-            EPI_DEBUG_ERROR(std::logic_error, "DataBase::record hist_virus_state should be of length 0.")
+        if (hist_date.size() != 0)
+            EPI_DEBUG_ERROR(std::logic_error, "DataBase::record hist_date should be of length 0.")
+        if (hist_virus_offset.size() != 0)
+            EPI_DEBUG_ERROR(std::logic_error, "DataBase::record hist_virus_offset should be of length 0.")
         if (hist_virus_counts.size() != 0)
             EPI_DEBUG_ERROR(std::logic_error, "DataBase::record hist_virus_counts should be of length 0.")
-        if (hist_tool_date.size() != 0)
-            EPI_DEBUG_ERROR(std::logic_error, "DataBase::record hist_tool_date should be of length 0.")
-        if (hist_tool_id.size() != 0)
-            EPI_DEBUG_ERROR(std::logic_error, "DataBase::record hist_tool_id should be of length 0.")
-        if (hist_tool_state.size() != 0)
-            EPI_DEBUG_ERROR(std::logic_error, "DataBase::record hist_tool_state should be of length 0.")
+        if (hist_tool_offset.size() != 0)
+            EPI_DEBUG_ERROR(std::logic_error, "DataBase::record hist_tool_offset should be of length 0.")
         if (hist_tool_counts.size() != 0)
             EPI_DEBUG_ERROR(std::logic_error, "DataBase::record hist_tool_counts should be of length 0.")
+        if (hist_total_nviruses_active.size() != 0)
+            EPI_DEBUG_ERROR(std::logic_error, "DataBase::record hist_total_nviruses_active should be of length 0.")
+        if (hist_total_counts.size() != 0)
+            EPI_DEBUG_ERROR(std::logic_error, "DataBase::record hist_total_counts should be of length 0.")
     }
     #endif
     ////////////////////////////////////////////////////////////////////////////
@@ -180,49 +171,32 @@ inline void DataBase<TSeq>::record()
     if ((model->today() % sampling_freq) == 0)
     {
 
-        // Recording virus's history
-        for (auto & p : virus_id)
-        {
+        hist_date.push_back(model->today());
 
-            for (epiworld_fast_uint s = 0u; s < model->nstates; ++s)
-            {
-
-                hist_virus_date.push_back(model->today());
-                hist_virus_id.push_back(p.second);
-                hist_virus_state.push_back(s);
-                hist_virus_counts.push_back(today_virus[p.second][s]);
-
-            }
-
-        }
+        // Recording virus's history (ids go from 0 to n - 1)
+        hist_virus_offset.push_back(hist_virus_counts.size());
+        for (const auto & counts : today_virus)
+            hist_virus_counts.insert(
+                hist_virus_counts.end(), counts.begin(), counts.end()
+                );
 
         // Recording tool's history
-        for (auto & p : tool_id)
-        {
-
-            for (epiworld_fast_uint s = 0u; s < model->nstates; ++s)
-            {
-
-                hist_tool_date.push_back(model->today());
-                hist_tool_id.push_back(p.second);
-                hist_tool_state.push_back(s);
-                hist_tool_counts.push_back(today_tool[p.second][s]);
-
-            }
-
-        }
+        hist_tool_offset.push_back(hist_tool_counts.size());
+        for (const auto & counts : today_tool)
+            hist_tool_counts.insert(
+                hist_tool_counts.end(), counts.begin(), counts.end()
+                );
 
         // Recording the overall history
-        for (epiworld_fast_uint s = 0u; s < model->nstates; ++s)
-        {
-            hist_total_date.push_back(model->today());
-            hist_total_nviruses_active.push_back(today_total_nviruses_active);
-            hist_total_state.push_back(s);
-            hist_total_counts.push_back(today_total[s]);
-        }
+        hist_total_nviruses_active.push_back(today_total_nviruses_active);
+        hist_total_counts.insert(
+            hist_total_counts.end(), today_total.begin(), today_total.end()
+            );
 
-        for (auto cell : transition_matrix)
-            hist_transition_matrix.push_back(cell);
+        hist_transition_matrix.insert(
+            hist_transition_matrix.end(),
+            transition_matrix.begin(), transition_matrix.end()
+            );
 
         // Now the diagonal must reflect the state
         for (size_t s_i = 0u; s_i < model->nstates; ++s_i)
@@ -426,6 +400,28 @@ inline void DataBase<TSeq>::record_tool(Tool<TSeq> & t)
     return;
 } 
 
+template<typename TSeq>
+inline size_t DataBase<TSeq>::hist_virus_n(size_t k) const
+{
+
+    size_t end = (k + 1u) < hist_virus_offset.size() ?
+        hist_virus_offset[k + 1u] : hist_virus_counts.size();
+
+    return (end - hist_virus_offset[k]) / model->nstates;
+
+}
+
+template<typename TSeq>
+inline size_t DataBase<TSeq>::hist_tool_n(size_t k) const
+{
+
+    size_t end = (k + 1u) < hist_tool_offset.size() ?
+        hist_tool_offset[k + 1u] : hist_tool_counts.size();
+
+    return (end - hist_tool_offset[k]) / model->nstates;
+
+}
+
 template<typename TSeq>
 inline size_t DataBase<TSeq>::size() const
 {
@@ -551,9 +547,10 @@ inline void DataBase<TSeq>::get_today_virus(
     ) const
 {
       
-    state.resize(today_virus.size(), "");
-    id.resize(today_virus.size(), 0);
-    counts.resize(today_virus.size(),0);
+    size_t n_rows = today_virus.size() * model->states_labels.size();
+    state.resize(n_rows, "");
+    id.resize(n_rows, 0);
+    counts.resize(n_rows, 0);
 
     int n = 0u;
     for (epiworld_fast_uint v = 0u; v < today_virus.size(); ++v)
@@ -575,14 +572,20 @@ inline void DataBase<TSeq>::get_hist_total(
 ) const
 {
 
+    size_t nstates = model->nstates;
+
     if (date != nullptr)
-        *date = hist_total_date;
+    {
+        date->resize(hist_date.size() * nstates);
+        for (size_t k = 0u; k < hist_date.size(); ++k)
+            std::fill_n(date->begin() + k * nstates, nstates, hist_date[k]);
+    }
 
     if (state != nullptr)
     {
-        state->resize(hist_total_state.size(), "");
-        for (epiworld_fast_uint i = 0u; i < hist_total_state.size(); ++i)
-            state->operator[](i) = model->states_labels[hist_total_state[i]];
+        state->resize(hist_date.size() * nstates, "");
+        for (size_t i = 0u; i < state->size(); ++i)
+            state->operator[](i) = model->states_labels[i % nstates];
     }
 
     if (counts != nullptr)
@@ -600,14 +603,24 @@ inline void DataBase<TSeq>::get_hist_virus(
     std::vector< int > & counts
 ) const {
 
-    date = hist_virus_date;
-    std::vector< std::string > labels;
-    labels = model->states_labels;
-    
-    id = hist_virus_id;
-    state.resize(hist_virus_state.size(), "");
-    for (epiworld_fast_uint i = 0u; i < hist_virus_state.size(); ++i)
-        state[i] = labels[hist_virus_state[i]];
+    const auto & labels = model->states_labels;
+    size_t nstates = model->nstates;
+    size_t n = hist_virus_counts.size();
+
+    date.resize(n);
+    id.resize(n);
+    state.resize(n, "");
+
+    size_t i = 0u;
+    for (size_t k = 0u; k < hist_date.size(); ++k)
+        for (size_t v = 0u; v < hist_virus_n(k); ++v)
+            for (size_t s = 0u; s < nstates; ++s)
+            {
+                date[i]  = hist_date[k];
+                id[i]    = static_cast< int >(v);
+                state[i] = labels[s];
+                ++i;
+            }
 
     counts = hist_virus_counts;
 
@@ -624,14 +637,24 @@ inline void DataBase<TSeq>::get_hist_tool(
     std::vector< int > & counts
 ) const {
 
-    date = hist_tool_date;
-    std::vector< std::string > labels;
-    labels = model->states_labels;
-    
-    id = hist_tool_id;
-    state.resize(hist_tool_state.size(), "");
-    for (size_t i = 0u; i < hist_tool_state.size(); ++i)
-        state[i] = labels[hist_tool_state[i]];
+    const auto & labels = model->states_labels;
+    size_t nstates = model->nstates;
+    size_t n = hist_tool_counts.size();
+
+    date.resize(n);
+    id.resize(n);
+    state.resize(n, "");
+
+    size_t i = 0u;
+    for (size_t k = 0u; k < hist_date.size(); ++k)
+        for (size_t t = 0u; t < hist_tool_n(k); ++t)
+            for (size_t s = 0u; s < nstates; ++s)
+            {
+                date[i]  = hist_date[k];
+                id[i]    = static_cast< int >(t);
+                state[i] = labels[s];
+                ++i;
+            }
 
     counts = hist_tool_counts;
 
@@ -676,13 +699,13 @@ inline void DataBase<TSeq>::get_hist_transition_matrix(
     counts.reserve(n);
 
     size_t n_states = model->nstates;
-    size_t n_steps  = model->get_ndays();
+    size_t n_steps  = hist_date.size();
 
     // If n is zero, then we are done
     if (n == 0u)
         return;
 
-    for (size_t step = 0u; step <= n_steps; ++step) // The final step counts
+    for (size_t step = 0u; step < n_steps; ++step)
     {
         for (size_t j = 0u; j < n_states; ++j) // Column major storage
         {
@@ -701,7 +724,7 @@ inline void DataBase<TSeq>::get_hist_transition_matrix(
                                 
                 state_from.push_back(model->states_labels[i]);
                 state_to.push_back(model->states_labels[j]);
-                date.push_back(hist_total_date[step * n_states]);
+                date.push_back(hist_date[step]);
                 counts.push_back(v);
 
             }
@@ -724,7 +747,7 @@ inline void DataBase<TSeq>::get_transmissions(
 ) const 
 {
 
-    size_t nevents = transmission_date.size();
+    size_t nevents = transmissions.size();
 
     date.resize(nevents);
     source.resize(nevents);
@@ -733,11 +756,11 @@ inline void DataBase<TSeq>::get_transmissions(
     source_exposure_date.resize(nevents);
 
     get_transmissions(
-        &date[0u],
-        &source[0u],
-        &target[0u],
-        &virus[0u],
-        &source_exposure_date[0u]
+        date.data(),
+        source.data(),
+        target.data(),
+        virus.data(),
+        source_exposure_date.data()
     );
 
 }
@@ -752,275 +775,333 @@ inline void DataBase<TSeq>::get_transmissions(
 ) const 
 {
 
-    size_t nevents = transmission_date.size();
+    transmissions.get(date, source, target, virus, source_exposure_date);
 
-    for (size_t i = 0u; i < nevents; ++i)
-    {
+}
 
-        *(date + i) = transmission_date.at(i);
-        *(source + i) = transmission_source.at(i);
-        *(target + i) = transmission_target.at(i);
-        *(virus + i) = transmission_virus.at(i);
-        *(source_exposure_date + i) = transmission_source_exposure_date.at(i);
+template<typename TSeq>
+inline TransmissionLog & DataBase<TSeq>::get_transmission_log()
+{
+    return transmissions;
+}
 
-    }
+template<typename TSeq>
+inline const TransmissionLog & DataBase<TSeq>::get_transmission_log() const
+{
+    return transmissions;
+}
+
+template<typename TSeq>
+inline DataTable DataBase<TSeq>::new_table(size_t nrows) const
+{
+
+    DataTable tab(nrows);
+
+    #ifdef EPI_DEBUG
+    tab.add_column("thread", std::vector< int >(nrows, EPI_GET_THREAD_ID()));
+    #endif
+
+    return tab;
 
 }
 
 template<typename TSeq>
-inline void DataBase<TSeq>::write_data(
-    std::string fn_virus_info,
-    std::string fn_virus_hist,
-    std::string fn_tool_info,
-    std::string fn_tool_hist,
-    std::string fn_total_hist,
-    std::string fn_transmission,
-    std::string fn_transition,
-    std::string fn_reproductive_number,
-    std::string fn_generation_time
-) const
+inline DataTable DataBase<TSeq>::table_virus_info() const
 {
 
-    if (fn_virus_info != "")
+    size_t n = virus_id.size();
+    std::vector< int > id, seq_code, date, parent;
+    std::vector< std::string > seq;
+    id.reserve(n);
+    seq.reserve(n);
+    date.reserve(n);
+    parent.reserve(n);
+
+    for (const auto & v : virus_id)
     {
-        std::ofstream file_virus_info(fn_virus_info, std::ios_base::out);
+        int i = v.second;
+        id.push_back(i);
+        seq_code.push_back(static_cast< int >(seq.size()));
+        seq.push_back(seq_writer(virus_sequence[i]));
+        date.push_back(virus_origin_date[i]);
+        parent.push_back(virus_parent_id[i]);
+    }
 
-        // Check if the file exists and throw an error if it doesn't
-        if (!file_virus_info)
-        {
-            throw std::runtime_error(
-                "Could not open file \"" + fn_virus_info +
-                "\" for writing.")
-                ;
-        }
+    DataTable tab = new_table(n);
+    tab.add_column("virus_id", id);
+    tab.add_column("virus", std::move(id), virus_name);
+    tab.add_column(
+        "virus_sequence", std::move(seq_code), std::move(seq), false
+        );
+    tab.add_column("date_recorded", std::move(date));
+    tab.add_column("parent", std::move(parent));
 
+    return tab;
 
-        file_virus_info <<
-        #ifdef EPI_DEBUG
-            "thread" << "virus_id " << "virus " << "virus_sequence " << "date_recorded " << "parent\n";
-        #else
-            "virus_id " << "virus " << "virus_sequence " << "date_recorded " << "parent\n";
-        #endif
+}
 
-        for (const auto & v : virus_id)
-        {
-            int id = v.second;
-            file_virus_info <<
-                #ifdef EPI_DEBUG
-                EPI_GET_THREAD_ID() << " " <<
-                #endif
-                id << " \"" <<
-                virus_name[id] << "\" " <<
-                seq_writer(virus_sequence[id]) << " " <<
-                virus_origin_date[id] << " " <<
-                virus_parent_id[id] << "\n";
-        }
+template<typename TSeq>
+inline DataTable DataBase<TSeq>::table_virus_hist() const
+{
 
-    }
+    size_t n = hist_virus_counts.size();
+    std::vector< int > date, id, state;
+    date.reserve(n);
+    id.reserve(n);
+    state.reserve(n);
 
-    if (fn_virus_hist != "")
-    {
-        std::ofstream file_virus(fn_virus_hist, std::ios_base::out);
-        
-        // Repeat the same error if the file doesn't exists
-        if (!file_virus)
-        {
-            throw std::runtime_error(
-                "Could not open file \"" + fn_virus_hist +
-                "\" for writing.")
-                ;
-        }
+    int ns = static_cast< int >(model->nstates);
+    for (size_t k = 0u; k < hist_date.size(); ++k)
+        for (size_t v = 0u; v < hist_virus_n(k); ++v)
+            for (int s = 0; s < ns; ++s)
+            {
+                date.push_back(hist_date[k]);
+                id.push_back(static_cast< int >(v));
+                state.push_back(s);
+            }
 
-        file_virus <<
-            #ifdef EPI_DEBUG
-            "thread "<< "date " << "virus_id " << "virus " << "state " << "n\n";
-            #else
-            "date " << "virus_id " << "virus " << "state " << "n\n";
-            #endif
+    DataTable tab = new_table(n);
+    tab.add_column("date", std::move(date));
+    tab.add_column("virus_id", id);
+    tab.add_column("virus", std::move(id), virus_name);
+    tab.add_column("state", std::move(state), model->states_labels, false);
+    tab.add_column("n", hist_virus_counts);
 
-        for (epiworld_fast_uint i = 0; i < hist_virus_id.size(); ++i)
-            file_virus <<
-                #ifdef EPI_DEBUG
-                EPI_GET_THREAD_ID() << " " <<
-                #endif
-                hist_virus_date[i] << " " <<
-                hist_virus_id[i] << " \"" <<
-                virus_name[hist_virus_id[i]] << "\" " <<
-                model->states_labels[hist_virus_state[i]] << " " <<
-                hist_virus_counts[i] << "\n";
-    }
+    return tab;
+
+}
+
+template<typename TSeq>
+inline DataTable DataBase<TSeq>::table_tool_info() const
+{
+
+    size_t n = tool_id.size();
+    std::vector< int > id, seq_code, date;
+    std::vector< std::string > seq;
+    id.reserve(n);
+    seq.reserve(n);
+    date.reserve(n);
 
-    if (fn_tool_info != "")
+    for (const auto & t : tool_id)
     {
-        std::ofstream file_tool_info(fn_tool_info, std::ios_base::out);
+        int i = t.second;
+        id.push_back(i);
+        seq_code.push_back(static_cast< int >(seq.size()));
+        seq.push_back(seq_writer(tool_sequence[i]));
+        date.push_back(tool_origin_date[i]);
+    }
 
-        // Repeat the same error if the file doesn't exists
-        if (!file_tool_info)
-        {
-            throw std::runtime_error(
-                "Could not open file \"" + fn_tool_info +
-                "\" for writing.")
-                ;
-        }
+    DataTable tab = new_table(n);
+    tab.add_column("id", id);
+    tab.add_column("tool_name", std::move(id), tool_name);
+    tab.add_column(
+        "tool_sequence", std::move(seq_code), std::move(seq), false
+        );
+    tab.add_column("date_recorded", std::move(date));
 
-        file_tool_info <<
-            #ifdef EPI_DEBUG
-            "thread " << 
-            #endif
-            "id " << "tool_name " << "tool_sequence " << "date_recorded\n";
+    return tab;
 
-        for (const auto & t : tool_id)
-        {
-            int id = t.second;
-            file_tool_info <<
-                #ifdef EPI_DEBUG
-                EPI_GET_THREAD_ID() << " " <<
-                #endif
-                id << " \"" <<
-                tool_name[id] << "\" " <<
-                seq_writer(tool_sequence[id]) << " " <<
-                tool_origin_date[id] << "\n";
-        }
+}
 
-    }
+template<typename TSeq>
+inline DataTable DataBase<TSeq>::table_tool_hist() const
+{
 
-    if (fn_tool_hist != "")
-    {
-        std::ofstream file_tool_hist(fn_tool_hist, std::ios_base::out);
+    size_t n = hist_tool_counts.size();
+    std::vector< int > date, id, state;
+    date.reserve(n);
+    id.reserve(n);
+    state.reserve(n);
 
-        // Repeat the same error if the file doesn't exists
-        if (!file_tool_hist)
-        {
-            throw std::runtime_error(
-                "Could not open file \"" + fn_tool_hist +
-                "\" for writing.")
-                ;
-        }
-        
-        file_tool_hist <<
-            #ifdef EPI_DEBUG
-            "thread " << 
-            #endif
-            "date " << "id " << "state " << "n\n";
-
-        for (epiworld_fast_uint i = 0; i < hist_tool_id.size(); ++i)
-            file_tool_hist <<
-                #ifdef EPI_DEBUG
-                EPI_GET_THREAD_ID() << " " <<
-                #endif
-                hist_tool_date[i] << " " <<
-                hist_tool_id[i] << " " <<
-                model->states_labels[hist_tool_state[i]] << " " <<
-                hist_tool_counts[i] << "\n";
-    }
+    int ns = static_cast< int >(model->nstates);
+    for (size_t k = 0u; k < hist_date.size(); ++k)
+        for (size_t t = 0u; t < hist_tool_n(k); ++t)
+            for (int s = 0; s < ns; ++s)
+            {
+                date.push_back(hist_date[k]);
+                id.push_back(static_cast< int >(t));
+                state.push_back(s);
+            }
 
-    if (fn_total_hist != "")
-    {
-        std::ofstream file_total(fn_total_hist, std::ios_base::out);
+    DataTable tab = new_table(n);
+    tab.add_column("date", std::move(date));
+    tab.add_column("id", std::move(id));
+    tab.add_column("state", std::move(state), model->states_labels, false);
+    tab.add_column("n", hist_tool_counts);
 
-        // Repeat the same error if the file doesn't exists
-        if (!file_total)
-        {
-            throw std::runtime_error(
-                "Could not open file \"" + fn_total_hist +
-                "\" for writing.")
-                ;
-        }
+    return tab;
 
-        file_total <<
-            #ifdef EPI_DEBUG
-            "thread " << 
-            #endif
-            "date " << "nviruses " << "state " << "counts\n";
+}
 
-        for (epiworld_fast_uint i = 0; i < hist_total_date.size(); ++i)
-            file_total <<
-                #ifdef EPI_DEBUG
-                EPI_GET_THREAD_ID() << " " <<
-                #endif
-                hist_total_date[i] << " " <<
-                hist_total_nviruses_active[i] << " \"" <<
-                model->states_labels[hist_total_state[i]] << "\" " << 
-                hist_total_counts[i] << "\n";
-    }
+template<typename TSeq>
+inline DataTable DataBase<TSeq>::table_total_hist() const
+{
 
-    if (fn_transmission != "")
-    {
-        std::ofstream file_transmission(fn_transmission, std::ios_base::out);
+    size_t n = hist_total_counts.size();
+    std::vector< int > date, nviruses, state;
+    date.reserve(n);
+    nviruses.reserve(n);
+    state.reserve(n);
 
-        // Repeat the same error if the file doesn't exists
-        if (!file_transmission)
+    int ns = static_cast< int >(model->nstates);
+    for (size_t k = 0u; k < hist_date.size(); ++k)
+        for (int s = 0; s < ns; ++s)
         {
-            throw std::runtime_error(
-                "Could not open file \"" + fn_transmission +
-                "\" for writing.")
-                ;
+            date.push_back(hist_date[k]);
+            nviruses.push_back(hist_total_nviruses_active[k]);
+            state.push_back(s);
         }
 
-        file_transmission <<
-            #ifdef EPI_DEBUG
-            "thread " << 
-            #endif
-            "date " << "virus_id virus " << "source_exposure_date " << "source " << "target\n";
+    DataTable tab = new_table(n);
+    tab.add_column("date", std::move(date));
+    tab.add_column("nviruses", std::move(nviruses));
+    tab.add_column("state", std::move(state), model->states_labels);
+    tab.add_column("counts", hist_total_counts);
 
-        for (epiworld_fast_uint i = 0; i < transmission_target.size(); ++i)
-            file_transmission <<
-                #ifdef EPI_DEBUG
-                EPI_GET_THREAD_ID() << " " <<
-                #endif
-                transmission_date[i] << " " <<
-                transmission_virus[i] << " \"" <<
-                virus_name[transmission_virus[i]] << "\" " <<
-                transmission_source_exposure_date[i] << " " <<
-                transmission_source[i] << " " <<
-                transmission_target[i] << "\n";
-                
-    }
+    return tab;
 
-    if (fn_transition != "")
-    {
-        std::ofstream file_transition(fn_transition, std::ios_base::out);
+}
 
-        // Repeat the same error if the file doesn't exists
-        if (!file_transition)
-        {
-            throw std::runtime_error(
-                "Could not open file \"" + fn_transition +
-                "\" for writing.")
-                ;
-        }
+template<typename TSeq>
+inline DataTable DataBase<TSeq>::table_transmission() const
+{
 
-        file_transition <<
-            #ifdef EPI_DEBUG
-            "thread " << 
-            #endif
-            "date " << "from " << "to " << "counts\n";
+    std::vector< int > date, source, target, virus, source_exposure_date;
+    get_transmissions(date, source, target, virus, source_exposure_date);
 
-        int ns = model->nstates;
+    DataTable tab = new_table(date.size());
+    tab.add_column("date", std::move(date));
+    tab.add_column("virus_id", virus);
+    tab.add_column("virus", std::move(virus), virus_name);
+    tab.add_column("source_exposure_date", std::move(source_exposure_date));
+    tab.add_column("source", std::move(source));
+    tab.add_column("target", std::move(target));
 
-        for (int i = 0; i <= model->today(); ++i)
-        {
+    return tab;
 
-            for (int from = 0u; from < ns; ++from)
-                for (int to = 0u; to < ns; ++to)
-                    file_transition <<
-                        #ifdef EPI_DEBUG
-                        EPI_GET_THREAD_ID() << " " <<
-                        #endif
-                        i << " \"" <<
-                        model->states_labels[from] << "\" \"" <<
-                        model->states_labels[to] << "\" " <<
-                        hist_transition_matrix[i * (ns * ns) + to * ns + from] << "\n";
-                
-        }
-                
-    }
+}
+
+template<typename TSeq>
+inline DataTable DataBase<TSeq>::table_transition() const
+{
+
+    int ns = static_cast< int >(model->nstates);
+    size_t n = hist_date.size() * ns * ns;
+
+    std::vector< int > date, from, to, counts;
+    date.reserve(n);
+    from.reserve(n);
+    to.reserve(n);
+    counts.reserve(n);
+
+    for (size_t i = 0u; i < hist_date.size(); ++i)
+        for (int f = 0; f < ns; ++f)
+            for (int t = 0; t < ns; ++t)
+            {
+                date.push_back(hist_date[i]);
+                from.push_back(f);
+                to.push_back(t);
+                counts.push_back(
+                    hist_transition_matrix[i * (ns * ns) + t * ns + f]
+                    );
+            }
+
+    DataTable tab = new_table(n);
+    tab.add_column("date", std::move(date));
+    tab.add_column("from", std::move(from), model->states_labels);
+    tab.add_column("to", std::move(to), model->states_labels);
+    tab.add_column("counts", std::move(counts));
+
+    return tab;
+
+}
+
+template<typename TSeq>
+inline DataTable DataBase<TSeq>::table_reproductive_number() const
+{
 
-    if (fn_reproductive_number != "")
-        reproductive_number(fn_reproductive_number);
+    std::vector< int > id, source, date, rt;
+    reproductive_number(id, source, date, rt);
 
-    if (fn_generation_time != "")
-        generation_time(fn_generation_time);
+    size_t n = rt.size();
+
+    DataTable tab = new_table(n);
+    tab.add_column("virus_id", id);
+    tab.add_column("virus", std::move(id), virus_name);
+    tab.add_column("source", std::move(source));
+    tab.add_column("source_exposure_date", std::move(date));
+    tab.add_column("rt", std::move(rt));
+
+    return tab;
+
+}
+
+template<typename TSeq>
+inline DataTable DataBase<TSeq>::table_generation_time() const
+{
+
+    std::vector< int > agent_id;
+    std::vector< int > virus_id;
+    std::vector< int > time;
+    std::vector< int > gentime;
+
+    generation_time(agent_id, virus_id, time, gentime);
+
+    DataTable tab = new_table(agent_id.size());
+    tab.add_column("virus", std::move(virus_id));
+    tab.add_column("source", std::move(agent_id));
+    tab.add_column("source_exposure_date", std::move(time));
+    tab.add_column("gentime", std::move(gentime));
+
+    return tab;
+
+}
+
+template<typename TSeq>
+inline void DataBase<TSeq>::write_data(
+    std::string fn_virus_info,
+    std::string fn_virus_hist,
+    std::string fn_tool_info,
+    std::string fn_tool_hist,
+    std::string fn_total_hist,
+    std::string fn_transmission,
+    std::string fn_transition,
+    std::string fn_reproductive_number,
+    std::string fn_generation_time,
+    bool binary,
+    DataWriter * writer
+) const
+{
+
+    typedef DataTable (DataBase<TSeq>::*TableFun)() const;
+
+    const std::pair< const std::string *, TableFun > files[] = {
+        {&fn_virus_info, &DataBase<TSeq>::table_virus_info},
+        {&fn_virus_hist, &DataBase<TSeq>::table_virus_hist},
+        {&fn_tool_info, &DataBase<TSeq>::table_tool_info},
+        {&fn_tool_hist, &DataBase<TSeq>::table_tool_hist},
+        {&fn_total_hist, &DataBase<TSeq>::table_total_hist},
+        {&fn_transmission, &DataBase<TSeq>::table_transmission},
+        {&fn_transition, &DataBase<TSeq>::table_transition},
+        {&fn_reproductive_number, &DataBase<TSeq>::table_reproductive_number},
+        {&fn_generation_time, &DataBase<TSeq>::table_generation_time}
+    };
+
+    for (const auto & f : files)
+    {
+
+        if (*f.first == "")
+            continue;
+
+        DataTable tab = (this->*f.second)();
+        std::string contents = binary ? tab.to_binary() : tab.to_csv();
+
+        if (writer != nullptr)
+            writer->write(*f.first, std::move(contents));
+        else
+            write_file(*f.first, contents);
+
+    }
 
 }
 
@@ -1032,14 +1113,70 @@ inline void DataBase<TSeq>::record_transmission(
     int i_expo_date
 ) {
 
-    transmission_date.push_back(model->today());
-    transmission_source.push_back(i);
-    transmission_target.push_back(j);
-    transmission_virus.push_back(virus);
-    transmission_source_exposure_date.push_back(i_expo_date);
+    #ifndef EPI_NO_TRANSMISSION_LOG
+    transmissions.add(model->today(), i, j, virus, i_expo_date);
+    #endif
+
+    if (incremental_stats)
+        transmission_stats.add(model->today(), i, j, virus, i_expo_date);
 
 }
 
+template<typename TSeq>
+inline void DataBase<TSeq>::update_transmission_stats() const
+{
+
+    // With incremental statistics, every transmission was added already
+    if (incremental_stats)
+        return;
+
+    // Statistics from part of the transmissions would be silently off
+    if (!transmissions.is_complete())
+        throw std::logic_error(
+            "The transmission log only kept " +
+            std::to_string(transmissions.size()) + " of " +
+            std::to_string(transmissions.get_n_seen()) +
+            " transmissions, so the reproductive numbers and generation times "
+            "cannot be computed from it. Use incremental_stats_on() before the run."
+            );
+
+    if (transmission_stats_seen == transmissions.get_n_seen())
+        return;
+
+    transmission_stats.clear();
+    transmission_stats.reserve(transmissions.size());
+    transmissions.for_each([this](int d, int s, int t, int v, int e) -> void {
+        transmission_stats.add(d, s, t, v, e);
+    });
+
+    transmission_stats_seen = transmissions.get_n_seen();
+
+}
+
+template<typename TSeq>
+inline void DataBase<TSeq>::incremental_stats_on()
+{
+
+    // Catching up with what was already recorded (if the log kept it)
+    if (!incremental_stats && transmissions.is_complete())
+        update_transmission_stats();
+
+    incremental_stats = true;
+
+}
+
+template<typename TSeq>
+inline void DataBase<TSeq>::incremental_stats_off()
+{
+    incremental_stats = false;
+}
+
+template<typename TSeq>
+inline bool DataBase<TSeq>::is_incremental_stats_on() const
+{
+    return incremental_stats;
+}
+
 template<typename TSeq>
 inline size_t DataBase<TSeq>::get_n_viruses() const
 {
@@ -1093,35 +1230,13 @@ template<typename TSeq>
 inline MapVec_type<int,int> DataBase<TSeq>::reproductive_number()
 const {
 
-    // Checking size
-    MapVec_type<int,int> map;
+    std::vector< int > virus, source, date, rt;
+    reproductive_number(virus, source, date, rt);
 
-    // Number of digits of maxid
-    for (size_t i = 0u; i < transmission_date.size(); ++i)
-    {
-        // Fabricating id
-        std::vector< int > h = {
-            transmission_virus[i],
-            transmission_source[i],
-            transmission_source_exposure_date[i]
-        };
-
-        // Adding to counter
-        if (map.find(h) == map.end())
-            map[h] = 1;
-        else
-            map[h]++;
-
-        // The target is added
-        std::vector< int > h_target = {
-            transmission_virus[i],
-            transmission_target[i],
-            transmission_date[i]
-        };
-
-        map[h_target] = 0;
-        
-    }
+    MapVec_type<int,int> map;
+    map.reserve(rt.size());
+    for (size_t i = 0u; i < rt.size(); ++i)
+        map[{virus[i], source[i], date[i]}] = rt[i];
 
     return map;
 
@@ -1129,42 +1244,23 @@ const {
 
 template<typename TSeq>
 inline void DataBase<TSeq>::reproductive_number(
-    std::string fn
+    std::vector< int > & virus_id,
+    std::vector< int > & source,
+    std::vector< int > & source_exposure_date,
+    std::vector< int > & rt
 ) const {
 
+    update_transmission_stats();
+    transmission_stats.get_rt().get(virus_id, source, source_exposure_date, rt);
 
-    auto map = reproductive_number();
-
-    std::ofstream fn_file(fn, std::ios_base::out);
-
-    // Repeat the same error if the file doesn't exists
-    if (!fn_file)
-    {
-        throw std::runtime_error(
-            "Could not open file \"" + fn +
-            "\" for writing.")
-            ;
-    }
-
-    fn_file << 
-        #ifdef EPI_DEBUG
-        "thread " <<
-        #endif
-        "virus_id virus source source_exposure_date rt\n";
-
+}
 
-    for (auto & m : map)
-        fn_file <<
-            #ifdef EPI_DEBUG
-            EPI_GET_THREAD_ID() << " " <<
-            #endif
-            m.first[0u] << " \"" <<
-            virus_name[m.first[0u]] << "\" " <<
-            m.first[1u] << " " <<
-            m.first[2u] << " " <<
-            m.second << "\n";
+template<typename TSeq>
+inline void DataBase<TSeq>::reproductive_number(
+    std::string fn
+) const {
 
-    return;
+    write_file(fn, table_reproductive_number().to_csv());
 
 }
 
@@ -1324,23 +1420,17 @@ inline bool DataBase<std::vector<int>>::operator==(const DataBase<std::vector<in
         "DataBase:: sampling_freq don't match."
         )
 
-    // Variants history
-    VECT_MATCH(
-        hist_virus_date,
-        other.hist_virus_date,
-        "DataBase:: hist_virus_date[i] don't match"
-        )
-
+    // History
     VECT_MATCH(
-        hist_virus_id,
-        other.hist_virus_id,
-        "DataBase:: hist_virus_id[i] don't match"
+        hist_date,
+        other.hist_date,
+        "DataBase:: hist_date[i] don't match"
         )
 
     VECT_MATCH(
-        hist_virus_state,
-        other.hist_virus_state,
-        "DataBase:: hist_virus_state[i] don't match"
+        hist_virus_offset,
+        other.hist_virus_offset,
+        "DataBase:: hist_virus_offset[i] don't match"
         )
 
     VECT_MATCH(
@@ -1349,23 +1439,10 @@ inline bool DataBase<std::vector<int>>::operator==(const DataBase<std::vector<in
         "DataBase:: hist_virus_counts[i] don't match"
         )
 
-    // Tools history
-    VECT_MATCH(
-        hist_tool_date,
-        other.hist_tool_date,
-        "DataBase:: hist_tool_date[i] don't match"
-        )
-
-    VECT_MATCH(
-        hist_tool_id,
-        other.hist_tool_id,
-        "DataBase:: hist_tool_id[i] don't match"
-        )
-
     VECT_MATCH(
-        hist_tool_state,
-        other.hist_tool_state,
-        "DataBase:: hist_tool_state[i] don't match"
+        hist_tool_offset,
+        other.hist_tool_offset,
+        "DataBase:: hist_tool_offset[i] don't match"
         )
 
     VECT_MATCH(
@@ -1374,25 +1451,12 @@ inline bool DataBase<std::vector<int>>::operator==(const DataBase<std::vector<in
         "DataBase:: hist_tool_counts[i] don't match"
         )
 
-    // Overall hist
-    VECT_MATCH(
-        hist_total_date,
-        other.hist_total_date,
-        "DataBase:: hist_total_date[i] don't match"
-        )
-
     VECT_MATCH(
         hist_total_nviruses_active,
         other.hist_total_nviruses_active,
         "DataBase:: hist_total_nviruses_active[i] don't match"
         )
 
-    VECT_MATCH(
-        hist_total_state,
-        other.hist_total_state,
-        "DataBase:: hist_total_state[i] don't match"
-        )
-
     VECT_MATCH(
         hist_total_counts,
         other.hist_total_counts,
@@ -1444,34 +1508,9 @@ inline bool DataBase<std::vector<int>>::operator==(const DataBase<std::vector<in
         )
 
     // Transmission network
-    VECT_MATCH(
-        transmission_date,
-        other.transmission_date,                 ///< Date of the transmission eve,
-        "DataBase:: transmission_date[i] don't match"
-        )
-
-    VECT_MATCH(
-        transmission_source,
-        other.transmission_source,               ///< Id of the sour,
-        "DataBase:: transmission_source[i] don't match"
-        )
-
-    VECT_MATCH(
-        transmission_target,
-        other.transmission_target,               ///< Id of the targ,
-        "DataBase:: transmission_target[i] don't match"
-        )
-
-    VECT_MATCH(
-        transmission_virus,
-        other.transmission_virus,              ///< Id of the varia,
-        "DataBase:: transmission_virus[i] don't match"
-        )
-
-    VECT_MATCH(
-        transmission_source_exposure_date,
-        other.transmission_source_exposure_date, ///< Date when the source acquired the varia,
-        "DataBase:: transmission_source_exposure_date[i] don't match"
+    EPI_DEBUG_FAIL_AT_TRUE(
+        transmissions != other.transmissions,
+        "DataBase:: transmissions don't match."
         )
 
 
@@ -1537,23 +1576,17 @@ inline bool DataBase<TSeq>::operator==(const DataBase<TSeq> & other) const
         "DataBase:: sampling_freq don't match."
     )
 
-    // Variants history
+    // History
     VECT_MATCH(
-        hist_virus_date,
-        other.hist_virus_date,
-        "DataBase:: hist_virus_date[i] don't match"
+        hist_date,
+        other.hist_date,
+        "DataBase:: hist_date[i] don't match"
     )
 
     VECT_MATCH(
-        hist_virus_id,
-        other.hist_virus_id,
-        "DataBase:: hist_virus_id[i] don't match"
-    )
-
-    VECT_MATCH(
-        hist_virus_state,
-        other.hist_virus_state,
-        "DataBase:: hist_virus_state[i] don't match"
+        hist_virus_offset,
+        other.hist_virus_offset,
+        "DataBase:: hist_virus_offset[i] don't match"
     )
 
     VECT_MATCH(
@@ -1562,23 +1595,10 @@ inline bool DataBase<TSeq>::operator==(const DataBase<TSeq> & other) const
         "DataBase:: hist_virus_counts[i] don't match"
     )
 
-    // Tools history
-    VECT_MATCH(
-        hist_tool_date,
-        other.hist_tool_date,
-        "DataBase:: hist_tool_date[i] don't match"
-    )
-
     VECT_MATCH(
-        hist_tool_id,
-        other.hist_tool_id,
-        "DataBase:: hist_tool_id[i] don't match"
-    )
-
-    VECT_MATCH(
-        hist_tool_state,
-        other.hist_tool_state,
-        "DataBase:: hist_tool_state[i] don't match"
+        hist_tool_offset,
+        other.hist_tool_offset,
+        "DataBase:: hist_tool_offset[i] don't match"
     )
 
     VECT_MATCH(
@@ -1587,25 +1607,12 @@ inline bool DataBase<TSeq>::operator==(const DataBase<TSeq> & other) const
         "DataBase:: hist_tool_counts[i] don't match"
     )
 
-    // Overall hist
-    VECT_MATCH(
-        hist_total_date,
-        other.hist_total_date,
-        "DataBase:: hist_total_date[i] don't match"
-    )
-
     VECT_MATCH(
         hist_total_nviruses_active,
         other.hist_total_nviruses_active,
         "DataBase:: hist_total_nviruses_active[i] don't match"
     )
 
-    VECT_MATCH(
-        hist_total_state,
-        other.hist_total_state,
-        "DataBase:: hist_total_state[i] don't match"
-    )
-
     VECT_MATCH(
         hist_total_counts,
         other.hist_total_counts,
@@ -1659,34 +1666,9 @@ inline bool DataBase<TSeq>::operator==(const DataBase<TSeq> & other) const
     )
 
     // Transmission network
-    VECT_MATCH( ///< Date of the transmission eve
-        transmission_date,
-        other.transmission_date,
-        "DataBase:: transmission_date[i] don't match"
-    )
-
-    VECT_MATCH( ///< Id of the sour
-        transmission_source,
-        other.transmission_source,
-        "DataBase:: transmission_source[i] don't match"
-    )
-
-    VECT_MATCH( ///< Id of the targ
-        transmission_target,
-        other.transmission_target,
-        "DataBase:: transmission_target[i] don't match"
-    )
-
-    VECT_MATCH( ///< Id of the varia
-        transmission_virus,
-        other.transmission_virus,
-        "DataBase:: transmission_virus[i] don't match"
-    )
-
-    VECT_MATCH( ///< Date when the source acquired the varia
-        transmission_source_exposure_date,
-        other.transmission_source_exposure_date,
-        "DataBase:: transmission_source_exposure_date[i] don't match"
+    EPI_DEBUG_FAIL_AT_TRUE(
+        transmissions != other.transmissions,
+        "DataBase:: transmissions don't match."
     )
 
     VECT_MATCH(
@@ -1707,40 +1689,28 @@ inline void DataBase<TSeq>::generation_time(
     std::vector< int > & gentime
 ) const {
     
-    size_t nevents = transmission_date.size();
-
-    agent_id.reserve(nevents);
-    virus_id.reserve(nevents);
-    time.reserve(nevents);
-    gentime.reserve(nevents);
-
-    // Iterating through the individuals
-    for (size_t i = 0u; i < nevents; ++i)
-    {
-        int agent_id_i = transmission_target[i];
-        agent_id.push_back(agent_id_i);
-        virus_id.push_back(transmission_virus[i]);
-        time.push_back(transmission_date[i]);
-
-        bool found = false;
-        for (size_t j = i; j < nevents; ++j)
-        {
-
-            if (transmission_source[j] == agent_id_i)
-            {
-                gentime.push_back(transmission_date[j] - time[i]);
-                found = true;
-                break;
-            }
-
-        }
-
-        // If there's no transmission, we set the generation time to
-        // minus 1;
-        if (!found)
-            gentime.push_back(-1);
-
-    }
+    update_transmission_stats();
+
+    if (transmission_stats.size() != transmissions.size())
+        throw std::logic_error(
+            "The generation times were computed from all the transmissions, "
+            "but the transmission log only kept " +
+            std::to_string(transmissions.size()) + " of " +
+            std::to_string(transmission_stats.size()) + "."
+            );
+
+    // The generation times are appended to the vectors
+    std::vector< int > date, source, target, virus, source_exposure_date;
+    get_transmissions(date, source, target, virus, source_exposure_date);
+
+    agent_id.insert(agent_id.end(), target.begin(), target.end());
+    virus_id.insert(virus_id.end(), virus.begin(), virus.end());
+    time.insert(time.end(), date.begin(), date.end());
+    gentime.insert(
+        gentime.end(),
+        transmission_stats.get_gentime().begin(),
+        transmission_stats.get_gentime().end()
+        );
 
     agent_id.shrink_to_fit();
     virus_id.shrink_to_fit();
@@ -1757,44 +1727,7 @@ inline void DataBase<TSeq>::generation_time(
 ) const
 {
 
-    std::vector< int > agent_id;
-    std::vector< int > virus_id;
-    std::vector< int > time;
-    std::vector< int > gentime;
-
-    generation_time(agent_id, virus_id, time, gentime);
-
-    std::ofstream fn_file(fn, std::ios_base::out);
-
-    // Throw an error if the file doesn't exists using throw
-    if (!fn_file)
-    {
-        throw std::runtime_error(
-            "DataBase::generation_time: "
-            "Cannot open file " + fn + "."
-        );
-    }
-
-
-
-    fn_file << 
-        #ifdef EPI_DEBUG
-        "thread " <<
-        #endif
-        "virus source source_exposure_date gentime\n";
-
-    size_t n = agent_id.size();
-    for (size_t i = 0u; i < n; ++i)
-        fn_file <<
-            #ifdef EPI_DEBUG
-            EPI_GET_THREAD_ID() << " " <<
-            #endif
-            virus_id[i] << " " <<
-            agent_id[i] << " " <<
-            time[i] << " " <<
-            gentime[i] << "\n";
-
-    return;
+    write_file(fn, table_generation_time().to_csv());
 
 }
 
@@ -0,0 +1,157 @@
+#ifndef EPIWORLD_DATATABLE_BONES_HPP
+#define EPIWORLD_DATATABLE_BONES_HPP
+
+/**
+ * @brief Column-oriented table used to export data
+ *
+ * @details Columns hold 32-bit integers. String columns are dictionary
+ * encoded: they store one code per row pointing to a vector of levels (e.g.,
+ * the state labels), so formatting a row never copies strings around.
+ *
+ * Tables can be written as space-separated text (`to_csv()`, the format used
+ * by `DataBase::write_data()`) or in a binary columnar format (`to_binary()`),
+ * which is the in-memory data plus a small header:
+ *
+ * | Content                                  | Type                     |
+ * |------------------------------------------|--------------------------|
+ * | `EPIWDATA`                               | 8 bytes                  |
+ * | Format version (currently `1`)           | uint32                   |
+ * | Number of columns                        | uint32                   |
+ * | Number of rows `n`                       | uint64                   |
+ * | For each column:                         |                          |
+ * | - Flags (bit 0: string, bit 1: quoted)   | uint32                   |
+ * | - Name                                   | uint32 length + bytes    |
+ * | - Levels (string columns only)           | uint32 count, then each level as uint32 length + bytes |
+ * | - Values (codes for string columns)      | `n` int32                |
+ *
+ * Numbers are stored in the machine's byte order.
+ */
+class DataTable {
+private:
+
+    struct Column {
+        std::string name;
+        bool is_string = false;
+        bool quoted    = false;
+        std::vector< int > values;           ///< Values or codes.
+        std::vector< std::string > levels;   ///< Only for string columns.
+    };
+
+    std::vector< Column > cols;
+    size_t n = 0u;
+
+    void check_size(const std::string & name, size_t size) const;
+    const Column & get_column_(const std::string & name) const;
+    void to_csv_rows(std::string & out, size_t from, size_t to) const;
+
+    static void append_int(std::string & out, int x);
+
+public:
+
+    DataTable(size_t nrows = 0u) : n(nrows) {};
+
+    /**
+     * @brief Adds a column
+     *
+     * @param name Name of the column.
+     * @param values One value per row (for string columns, the position of
+     * the row's value in `levels`).
+     * @param levels Possible values of a string column.
+     * @param quoted If `true`, the values are written between double quotes.
+     */
+    ///@{
+    void add_column(std::string name, std::vector< int > values);
+    void add_column(
+        std::string name,
+        std::vector< int > codes,
+        std::vector< std::string > levels,
+        bool quoted = true
+        );
+    ///@}
+
+    size_t nrows() const {return n;};
+    size_t ncols() const {return cols.size();};
+    std::vector< std::string > get_names() const;
+
+    /**
+     * @brief Retrieves a column
+     *
+     * @details `get_column()` returns the values (or codes, for string
+     * columns) and `get_column_str()` the decoded strings.
+     */
+    ///@{
+    const std::vector< int > & get_column(const std::string & name) const;
+    std::vector< std::string > get_column_str(const std::string & name) const;
+    ///@}
+
+    /**
+     * @brief Serializes the table
+     *
+     * @details Large tables are formatted in blocks of rows in parallel
+     * (when OpenMP is available and the call is not already inside a
+     * parallel region).
+     */
+    ///@{
+    std::string to_csv() const;
+    std::string to_binary() const;
+    ///@}
+
+    static DataTable read_binary(const std::string & fn);
+
+    bool operator==(const DataTable & other) const;
+    bool operator!=(const DataTable & other) const {return !operator==(other);};
+
+};
+
+/**
+ * @brief Writes `contents` to the file `fn` (replacing it)
+ */
+void write_file(const std::string & fn, const std::string & contents);
+
+/**
+ * @brief Writes files from a background thread
+ *
+ * @details `write()` queues the contents of a file and returns right away,
+ * so the caller (e.g., a replicate in `Model::run_multiple()`) does not wait
+ * for the disk. Files are written in the order they are queued. If more
+ * than `max_pending` bytes are waiting, `write()` blocks until the
+ * backlog drops below the limit.
+ *
+ * I/O errors are reported by the next call to `write()` or `wait()`. The
+ * destructor waits for the pending files but discards errors, so call
+ * `wait()` before reading the files back.
+ *
+ * `write()` can be called from several threads at the same time.
+ */
+class DataWriter {
+private:
+
+    std::deque< std::pair< std::string, std::string > > jobs;
+    size_t pending = 0u;      ///< Bytes queued or being written.
+    bool busy = false;        ///< A file is being written.
+    bool stop = false;
+    size_t max_pending;
+    std::exception_ptr error = nullptr;
+
+    std::mutex mtx;
+    std::condition_variable cv_jobs;
+    std::condition_variable cv_done;
+    std::thread worker;
+
+    void loop();
+    void rethrow_error();
+
+public:
+
+    DataWriter(size_t max_pending = 268435456u);
+    ~DataWriter();
+
+    DataWriter(const DataWriter &) = delete;
+    DataWriter & operator=(const DataWriter &) = delete;
+
+    void write(std::string fn, std::string contents);
+    void wait();
+
+};
+
+#endif
@@ -0,0 +1,495 @@
+#ifndef EPIWORLD_DATATABLE_MEAT_HPP
+#define EPIWORLD_DATATABLE_MEAT_HPP
+
+inline void DataTable::check_size(const std::string & name, size_t size) const
+{
+
+    if (size != n)
+        throw std::length_error(
+            "The column \"" + name + "\" has " + std::to_string(size) +
+            " rows but the table has " + std::to_string(n) + "."
+            );
+
+}
+
+inline const DataTable::Column & DataTable::get_column_(
+    const std::string & name
+) const
+{
+
+    for (const auto & c : cols)
+        if (c.name == name)
+            return c;
+
+    throw std::range_error("The table has no column \"" + name + "\".");
+
+}
+
+inline void DataTable::add_column(std::string name, std::vector< int > values)
+{
+
+    check_size(name, values.size());
+
+    Column c;
+    c.name   = std::move(name);
+    c.values = std::move(values);
+    cols.push_back(std::move(c));
+
+}
+
+inline void DataTable::add_column(
+    std::string name,
+    std::vector< int > codes,
+    std::vector< std::string > levels,
+    bool quoted
+)
+{
+
+    check_size(name, codes.size());
+
+    int nlevels = static_cast< int >(levels.size());
+    for (auto & code : codes)
+        if ((code < 0) || (code >= nlevels))
+            throw std::range_error(
+                "The column \"" + name + "\" has the code " +
+                std::to_string(code) + " but only " + std::to_string(nlevels) +
+                " levels."
+                );
+
+    Column c;
+    c.name      = std::move(name);
+    c.is_string = true;
+    c.quoted    = quoted;
+    c.values    = std::move(codes);
+    c.levels    = std::move(levels);
+    cols.push_back(std::move(c));
+
+}
+
+inline std::vector< std::string > DataTable::get_names() const
+{
+
+    std::vector< std::string > res;
+    for (const auto & c : cols)
+        res.push_back(c.name);
+
+    return res;
+
+}
+
+inline const std::vector< int > & DataTable::get_column(
+    const std::string & name
+) const
+{
+    return get_column_(name).values;
+}
+
+inline std::vector< std::string > DataTable::get_column_str(
+    const std::string & name
+) const
+{
+
+    const Column & c = get_column_(name);
+    std::vector< std::string > res;
+    res.reserve(n);
+
+    if (c.is_string)
+    {
+        for (auto code : c.values)
+            res.push_back(c.levels[code]);
+    }
+    else
+    {
+        for (auto v : c.values)
+            res.push_back(std::to_string(v));
+    }
+
+    return res;
+
+}
+
+inline void DataTable::append_int(std::string & out, int x)
+{
+
+    char buff[12u];
+    char * end = buff + sizeof(buff);
+    char * p   = end;
+
+    unsigned int u = (x < 0) ?
+        0u - static_cast< unsigned int >(x) : static_cast< unsigned int >(x);
+
+    do
+    {
+        *--p = static_cast< char >('0' + (u % 10u));
+        u /= 10u;
+    } while (u != 0u);
+
+    if (x < 0)
+        *--p = '-';
+
+    out.append(p, end);
+
+}
+
+inline void DataTable::to_csv_rows(
+    std::string & out,
+    size_t from,
+    size_t to
+) const
+{
+
+    size_t nc = cols.size();
+    for (size_t i = from; i < to; ++i)
+    {
+
+        for (size_t j = 0u; j < nc; ++j)
+        {
+
+            const Column & c = cols[j];
+
+            if (j > 0u)
+                out.push_back(' ');
+
+            if (!c.is_string)
+                append_int(out, c.values[i]);
+            else if (c.quoted)
+            {
+                out.push_back('"');
+                out.append(c.levels[c.values[i]]);
+                out.push_back('"');
+            }
+            else
+                out.append(c.levels[c.values[i]]);
+
+        }
+
+        out.push_back('\n');
+
+    }
+
+}
+
+inline std::string DataTable::to_csv() const
+{
+
+    std::string out;
+
+    for (size_t j = 0u; j < cols.size(); ++j)
+    {
+        if (j > 0u)
+            out.push_back(' ');
+
+        out.append(cols[j].name);
+    }
+    out.push_back('\n');
+
+    // Blocks of rows, formatted independently
+    static const size_t block_size = 65536u;
+    size_t nblocks = (n + block_size - 1u) / block_size;
+
+    if (nblocks <= 1u)
+    {
+        out.reserve(out.size() + n * cols.size() * 8u);
+        to_csv_rows(out, 0u, n);
+        return out;
+    }
+
+    std::vector< std::string > blocks(nblocks);
+    int nblocks_int = static_cast< int >(nblocks);
+
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) if(!omp_in_parallel())
+    #endif
+    for (int b = 0; b < nblocks_int; ++b)
+    {
+
+        size_t from = static_cast< size_t >(b) * block_size;
+        size_t to   = std::min(from + block_size, n);
+
+        blocks[b].reserve((to - from) * cols.size() * 8u);
+        to_csv_rows(blocks[b], from, to);
+
+    }
+
+    size_t total = out.size();
+    for (const auto & b : blocks)
+        total += b.size();
+
+    out.reserve(total);
+    for (const auto & b : blocks)
+        out.append(b);
+
+    return out;
+
+}
+
+inline std::string DataTable::to_binary() const
+{
+
+    std::string out("EPIWDATA", 8u);
+
+    auto append_u32 = [&out](std::uint32_t x) -> void {
+        out.append(reinterpret_cast< const char * >(&x), 4u);
+    };
+
+    auto append_str = [&out, &append_u32](const std::string & s) -> void {
+        append_u32(static_cast< std::uint32_t >(s.size()));
+        out.append(s);
+    };
+
+    std::uint64_t nrows = static_cast< std::uint64_t >(n);
+
+    append_u32(1u);
+    append_u32(static_cast< std::uint32_t >(cols.size()));
+    out.append(reinterpret_cast< const char * >(&nrows), 8u);
+
+    for (const auto & c : cols)
+    {
+
+        append_u32((c.is_string ? 1u : 0u) | (c.quoted ? 2u : 0u));
+        append_str(c.name);
+
+        if (c.is_string)
+        {
+            append_u32(static_cast< std::uint32_t >(c.levels.size()));
+            for (const auto & l : c.levels)
+                append_str(l);
+        }
+
+        out.append(
+            reinterpret_cast< const char * >(c.values.data()),
+            c.values.size() * sizeof(int)
+            );
+
+    }
+
+    return out;
+
+}
+
+inline DataTable DataTable::read_binary(const std::string & fn)
+{
+
+    MappedFile file(fn);
+    const char * p   = file.data();
+    const char * end = p + file.size();
+
+    auto need = [&](size_t k) -> void {
+        if (static_cast< size_t >(end - p) < k)
+            throw std::logic_error("The file " + fn + " is truncated.");
+    };
+
+    auto read_u32 = [&]() -> std::uint32_t {
+        need(4u);
+        std::uint32_t x;
+        std::memcpy(&x, p, 4u);
+        p += 4u;
+        return x;
+    };
+
+    auto read_str = [&]() -> std::string {
+        std::uint32_t len = read_u32();
+        need(len);
+        std::string s(p, len);
+        p += len;
+        return s;
+    };
+
+    if ((file.size() < 24u) || (std::memcmp(p, "EPIWDATA", 8u) != 0))
+        throw std::logic_error("The file " + fn + " is not a data table.");
+
+    p += 8u;
+
+    std::uint32_t version = read_u32();
+    if (version != 1u)
+        throw std::logic_error(
+            "Unsupported data table version " + std::to_string(version) +
+            " in " + fn
+            );
+
+    std::uint32_t ncols = read_u32();
+    std::uint64_t nrows;
+    std::memcpy(&nrows, p, 8u);
+    p += 8u;
+
+    DataTable res(static_cast< size_t >(nrows));
+    for (std::uint32_t j = 0u; j < ncols; ++j)
+    {
+
+        std::uint32_t flags = read_u32();
+        std::string name = read_str();
+
+        std::vector< std::string > levels;
+        if (flags & 1u)
+        {
+            std::uint32_t nlevels = read_u32();
+            for (std::uint32_t l = 0u; l < nlevels; ++l)
+                levels.push_back(read_str());
+        }
+
+        if (static_cast< std::uint64_t >(end - p) / sizeof(int) < nrows)
+            throw std::logic_error("The file " + fn + " is truncated.");
+
+        std::vector< int > values(static_cast< size_t >(nrows));
+        if (nrows > 0u)
+            std::memcpy(values.data(), p, values.size() * sizeof(int));
+
+        p += values.size() * sizeof(int);
+
+        if (flags & 1u)
+            res.add_column(
+                std::move(name), std::move(values), std::move(levels),
+                (flags & 2u) != 0u
+                );
+        else
+            res.add_column(std::move(name), std::move(values));
+
+    }
+
+    return res;
+
+}
+
+inline bool DataTable::operator==(const DataTable & other) const
+{
+
+    if ((n != other.n) || (cols.size() != other.cols.size()))
+        return false;
+
+    for (size_t j = 0u; j < cols.size(); ++j)
+    {
+
+        const Column & a = cols[j];
+        const Column & b = other.cols[j];
+
+        if ((a.name != b.name) || (a.is_string != b.is_string) ||
+            (a.quoted != b.quoted) || (a.values != b.values) ||
+            (a.levels != b.levels))
+            return false;
+
+    }
+
+    return true;
+
+}
+
+inline void write_file(const std::string & fn, const std::string & contents)
+{
+
+    std::FILE * file = std::fopen(fn.c_str(), "wb");
+
+    if (file == nullptr)
+        throw std::runtime_error(
+            "Could not open file \"" + fn + "\" for writing."
+            );
+
+    size_t nwritten = std::fwrite(contents.data(), 1u, contents.size(), file);
+
+    if ((std::fclose(file) != 0) || (nwritten != contents.size()))
+        throw std::runtime_error("I/O error while writing the file " + fn);
+
+}
+
+inline DataWriter::DataWriter(size_t max_pending) :
+    max_pending(max_pending)
+{
+    worker = std::thread(&DataWriter::loop, this);
+}
+
+inline DataWriter::~DataWriter()
+{
+
+    {
+        std::lock_guard< std::mutex > lock(mtx);
+        stop = true;
+    }
+
+    cv_jobs.notify_all();
+    worker.join();
+
+}
+
+inline void DataWriter::loop()
+{
+
+    std::unique_lock< std::mutex > lock(mtx);
+    while (true)
+    {
+
+        cv_jobs.wait(lock, [this]{return stop || !jobs.empty();});
+
+        // Only stops once everything has been written
+        if (jobs.empty())
+            return;
+
+        auto job = std::move(jobs.front());
+        jobs.pop_front();
+        busy = true;
+        lock.unlock();
+
+        std::exception_ptr err = nullptr;
+        try
+        {
+            write_file(job.first, job.second);
+        }
+        catch (...)
+        {
+            err = std::current_exception();
+        }
+
+        lock.lock();
+
+        if ((err != nullptr) && (error == nullptr))
+            error = err;
+
+        pending -= job.second.size();
+        busy = false;
+        cv_done.notify_all();
+
+    }
+
+}
+
+inline void DataWriter::rethrow_error()
+{
+
+    if (error != nullptr)
+    {
+        std::exception_ptr err = error;
+        error = nullptr;
+        std::rethrow_exception(err);
+    }
+
+}
+
+inline void DataWriter::write(std::string fn, std::string contents)
+{
+
+    std::unique_lock< std::mutex > lock(mtx);
+
+    // Waiting for the backlog to shrink
+    cv_done.wait(lock, [this]{
+        return (pending < max_pending) || (jobs.empty() && !busy);
+    });
+
+    rethrow_error();
+
+    pending += contents.size();
+    jobs.emplace_back(std::move(fn), std::move(contents));
+    lock.unlock();
+
+    cv_jobs.notify_one();
+
+}
+
+inline void DataWriter::wait()
+{
+
+    std::unique_lock< std::mutex > lock(mtx);
+    cv_done.wait(lock, [this]{return jobs.empty() && !busy;});
+
+    rethrow_error();
+
+}
+
+#endif
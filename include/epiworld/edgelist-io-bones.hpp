@@ -0,0 +1,90 @@
+#ifndef EPIWORLD_EDGELIST_IO_BONES_HPP
+#define EPIWORLD_EDGELIST_IO_BONES_HPP
+
+/**
+ * @brief Read-only view of the contents of a file
+ *
+ * @details Where available (POSIX), the file is memory-mapped, so the pages
+ * are read by the OS on demand and no copy is made. Otherwise (or if
+ * `EPI_NO_MMAP` is defined) the file is read into a buffer.
+ */
+class MappedFile {
+private:
+
+    const char * dat = nullptr;
+    size_t dat_size  = 0u;
+
+    #ifdef EPI_HAS_MMAP
+    void * map = nullptr;
+    #endif
+
+    std::vector< char > buffer; ///< Used if the file is not mapped.
+
+public:
+
+    MappedFile(const std::string & fn);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile & operator=(const MappedFile &) = delete;
+
+    const char * data() const noexcept {return dat;};
+    size_t size() const noexcept {return dat_size;};
+
+};
+
+/**
+ * @name Reading and writing edgelists
+ *
+ * @details `read_edgelist_text()` reads a text file with two integer
+ * columns (source and target) separated by whitespace. The file is split
+ * into chunks (at line breaks) that are parsed in parallel twice: once to
+ * count the ties, and once to write them straight into `source` and
+ * `target`, in the order of the file. As in `AdjList::read_edgelist()`,
+ * reading stops at the first token that is not an integer.
+ *
+ * The binary format is a 32-byte header followed by the ids (as 32-bit
+ * integers, in the machine's byte order) of the sources and then the
+ * targets:
+ *
+ * | Bytes  | Content                                  |
+ * |--------|------------------------------------------|
+ * | 0-7    | `EPIWEDGE`                               |
+ * | 8-11   | Format version (uint32, currently `1`)   |
+ * | 12-15  | Flags (uint32, bit 0: directed)          |
+ * | 16-23  | Number of vertices `N` (uint64)          |
+ * | 24-31  | Number of ties `E` (uint64)              |
+ * | 32-... | `E` sources, then `E` targets (int32)    |
+ *
+ * @param fn Path to the file.
+ * @param source,target Vectors where to store the ties (replaced).
+ * @param skip Number of lines to skip (e.g., 1 if there's a header).
+ * @param n,directed If not `nullptr`, the number of vertices and whether
+ * the graph is directed, as stored in the header.
+ */
+///@{
+void read_edgelist_text(
+    const std::string & fn,
+    std::vector< int > & source,
+    std::vector< int > & target,
+    int skip = 0
+    );
+
+void read_edgelist_binary(
+    const std::string & fn,
+    std::vector< int > & source,
+    std::vector< int > & target,
+    size_t * n = nullptr,
+    bool * directed = nullptr
+    );
+
+void write_edgelist_binary(
+    const std::string & fn,
+    const std::vector< int > & source,
+    const std::vector< int > & target,
+    size_t n,
+    bool directed
+    );
+///@}
+
+#endif
@@ -0,0 +1,354 @@
+#ifndef EPIWORLD_EDGELIST_IO_MEAT_HPP
+#define EPIWORLD_EDGELIST_IO_MEAT_HPP
+
+static_assert(
+    sizeof(int) == 4u,
+    "The binary edgelist format stores ids as 32-bit integers."
+    );
+
+inline MappedFile::MappedFile(const std::string & fn)
+{
+
+    #ifdef EPI_HAS_MMAP
+    int fd = ::open(fn.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::logic_error("The file " + fn + " was not found.");
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0)
+    {
+        ::close(fd);
+        throw std::logic_error("I/O error while reading the file " + fn);
+    }
+
+    dat_size = static_cast< size_t >(info.st_size);
+
+    // Empty files cannot be mapped
+    if (dat_size > 0u)
+    {
+
+        map = ::mmap(nullptr, dat_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED)
+        {
+            map = nullptr;
+            ::close(fd);
+            throw std::logic_error("Could not map the file " + fn);
+        }
+
+        // The file is read front to back
+        ::madvise(map, dat_size, MADV_SEQUENTIAL);
+        dat = static_cast< const char * >(map);
+
+    }
+
+    ::close(fd);
+    #else
+    std::ifstream filei(fn, std::ios::binary | std::ios::ate);
+    if (!filei)
+        throw std::logic_error("The file " + fn + " was not found.");
+
+    buffer.resize(static_cast< size_t >(filei.tellg()));
+    filei.seekg(0);
+    filei.read(buffer.data(), buffer.size());
+
+    if (filei.bad())
+        throw std::logic_error("I/O error while reading the file " + fn);
+
+    dat      = buffer.data();
+    dat_size = buffer.size();
+    #endif
+
+}
+
+inline MappedFile::~MappedFile()
+{
+
+    #ifdef EPI_HAS_MMAP
+    if (map != nullptr)
+        ::munmap(map, dat_size);
+    #endif
+
+}
+
+/**
+ * @brief Parses the pairs of integers in [begin, end)
+ * @details If `source` and `target` are `nullptr`, the pairs are only
+ * counted, so the output can be sized before they are written.
+ * @param npairs Number of pairs parsed (and written).
+ * @return `false` if it found a token that is not an integer, or an id
+ * without its pair (what was parsed until then is kept).
+ */
+inline bool read_edgelist_text_chunk(
+    const char * begin,
+    const char * end,
+    int * source,
+    int * target,
+    size_t & npairs
+)
+{
+
+    npairs = 0u;
+    bool has_first = false;
+    int first = 0;
+
+    const char * p = begin;
+    while (true)
+    {
+
+        while ((p != end) &&
+            ((*p == ' ') || (*p == '\t') || (*p == '\n') || (*p == '\r')))
+            ++p;
+
+        if (p == end)
+            return !has_first;
+
+        bool negative = (*p == '-');
+        if (negative)
+            ++p;
+
+        if ((p == end) || (*p < '0') || (*p > '9'))
+            return false;
+
+        long long int v = 0;
+        while ((p != end) && (*p >= '0') && (*p <= '9'))
+        {
+            v = v * 10 + (*p++ - '0');
+            if (v > INT_MAX)
+                throw std::range_error(
+                    "The edgelist has an id above " + std::to_string(INT_MAX)
+                    );
+        }
+
+        // The token must end here
+        if ((p != end) && (*p != ' ') && (*p != '\t') && (*p != '\n') &&
+            (*p != '\r'))
+            return false;
+
+        int val = static_cast< int >(negative ? -v : v);
+        if (!has_first)
+        {
+            first     = val;
+            has_first = true;
+            continue;
+        }
+
+        if (source != nullptr)
+        {
+            source[npairs] = first;
+            target[npairs] = val;
+        }
+
+        ++npairs;
+        has_first = false;
+
+    }
+
+}
+
+inline void read_edgelist_text(
+    const std::string & fn,
+    std::vector< int > & source,
+    std::vector< int > & target,
+    int skip
+)
+{
+
+    MappedFile file(fn);
+    const char * begin = file.data();
+    const char * end   = begin + file.size();
+
+    // Skipping the first lines
+    while ((skip-- > 0) && (begin != end))
+    {
+        const char * eol = static_cast< const char * >(
+            std::memchr(begin, '\n', end - begin)
+            );
+
+        begin = (eol == nullptr) ? end : eol + 1;
+    }
+
+    // Chunks of about 4MB. Their boundaries are moved to the beginning of
+    // the next line, so the result does not depend on the number of threads.
+    size_t len = static_cast< size_t >(end - begin);
+    size_t nchunks = std::max(static_cast< size_t >(1u), len >> 22u);
+
+    std::vector< const char * > bounds(nchunks + 1u, end);
+    bounds[0u] = begin;
+    for (size_t c = 1u; c < nchunks; ++c)
+    {
+
+        const char * b = std::max(begin + c * (len / nchunks), bounds[c - 1u]);
+        const char * eol = static_cast< const char * >(
+            std::memchr(b, '\n', end - b)
+            );
+
+        bounds[c] = (eol == nullptr) ? end : eol + 1;
+
+    }
+
+    // First pass: counting the pairs of each chunk
+    std::vector< size_t > npairs(nchunks, 0u);
+    std::vector< char > ok(nchunks, 1);
+    std::vector< std::exception_ptr > errors(nchunks, nullptr);
+
+    int nchunks_int = static_cast< int >(nchunks);
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic)
+    #endif
+    for (int c = 0; c < nchunks_int; ++c)
+    {
+
+        try
+        {
+            ok[c] = read_edgelist_text_chunk(
+                bounds[c], bounds[c + 1], nullptr, nullptr, npairs[c]
+                ) ? 1 : 0;
+        }
+        catch (...)
+        {
+            errors[c] = std::current_exception();
+        }
+
+    }
+
+    // Reading stops at the first chunk with a problem
+    size_t nused = nchunks;
+    for (size_t c = 0u; c < nchunks; ++c)
+    {
+
+        if (errors[c] != nullptr)
+            std::rethrow_exception(errors[c]);
+
+        if (!ok[c])
+        {
+            nused = c + 1u;
+            break;
+        }
+
+    }
+
+    std::vector< size_t > offsets(nused + 1u, 0u);
+    for (size_t c = 0u; c < nused; ++c)
+        offsets[c + 1u] = offsets[c] + npairs[c];
+
+    // Second pass: parsing straight into the output
+    source.resize(offsets[nused]);
+    target.resize(offsets[nused]);
+
+    int nused_int = static_cast< int >(nused);
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic)
+    #endif
+    for (int c = 0; c < nused_int; ++c)
+    {
+
+        size_t n = 0u;
+        read_edgelist_text_chunk(
+            bounds[c], bounds[c + 1],
+            source.data() + offsets[c], target.data() + offsets[c], n
+            );
+
+    }
+
+}
+
+inline void read_edgelist_binary(
+    const std::string & fn,
+    std::vector< int > & source,
+    std::vector< int > & target,
+    size_t * n,
+    bool * directed
+)
+{
+
+    MappedFile file(fn);
+    const char * dat = file.data();
+
+    if ((file.size() < 32u) || (std::memcmp(dat, "EPIWEDGE", 8u) != 0))
+        throw std::logic_error(
+            "The file " + fn + " is not a binary edgelist."
+            );
+
+    std::uint32_t version, flags;
+    std::uint64_t nvertices, nties;
+    std::memcpy(&version, dat + 8u, 4u);
+    std::memcpy(&flags, dat + 12u, 4u);
+    std::memcpy(&nvertices, dat + 16u, 8u);
+    std::memcpy(&nties, dat + 24u, 8u);
+
+    if (version != 1u)
+        throw std::logic_error(
+            "Unsupported binary edgelist version " + std::to_string(version) +
+            " in " + fn
+            );
+
+    if ((file.size() - 32u) / 8u < nties)
+        throw std::logic_error(
+            "The file " + fn + " is truncated (expected " +
+            std::to_string(nties) + " ties)."
+            );
+
+    source.resize(nties);
+    target.resize(nties);
+
+    if (nties > 0u)
+    {
+        std::memcpy(source.data(), dat + 32u, nties * 4u);
+        std::memcpy(target.data(), dat + 32u + nties * 4u, nties * 4u);
+    }
+
+    if (n != nullptr)
+        *n = static_cast< size_t >(nvertices);
+
+    if (directed != nullptr)
+        *directed = (flags & 1u) != 0u;
+
+}
+
+inline void write_edgelist_binary(
+    const std::string & fn,
+    const std::vector< int > & source,
+    const std::vector< int > & target,
+    size_t n,
+    bool directed
+)
+{
+
+    if (source.size() != target.size())
+        throw std::length_error(
+            "The source (" + std::to_string(source.size()) +
+            ") and target (" + std::to_string(target.size()) +
+            ") vectors must have the same length."
+            );
+
+    std::ofstream fileo(fn, std::ios::binary);
+    if (!fileo)
+        throw std::runtime_error(
+            "Could not open file \"" + fn + "\" for writing."
+            );
+
+    std::uint32_t version = 1u;
+    std::uint32_t flags   = directed ? 1u : 0u;
+    std::uint64_t nvertices = static_cast< std::uint64_t >(n);
+    std::uint64_t nties     = static_cast< std::uint64_t >(source.size());
+
+    fileo.write("EPIWEDGE", 8u);
+    fileo.write(reinterpret_cast< const char * >(&version), 4u);
+    fileo.write(reinterpret_cast< const char * >(&flags), 4u);
+    fileo.write(reinterpret_cast< const char * >(&nvertices), 8u);
+    fileo.write(reinterpret_cast< const char * >(&nties), 8u);
+    fileo.write(
+        reinterpret_cast< const char * >(source.data()),
+        static_cast< std::streamsize >(nties * 4u)
+        );
+    fileo.write(
+        reinterpret_cast< const char * >(target.data()),
+        static_cast< std::streamsize >(nties * 4u)
+        );
+
+    if (!fileo)
+        throw std::runtime_error("I/O error while writing the file " + fn);
+
+}
+
+#endif
@@ -60,11 +60,14 @@ inline EntityToAgentFun<TSeq> distribute_entity_randomly(
                     std::to_string(n_to_sample));
         }
 
+        std::vector< epiworld_double > u(n_to_sample);
+        m->runif_n(u.data(), u.size());
+
         int n_left = n;
         for (int i = 0; i < n_to_sample; ++i)
         {
             int loc = static_cast<epiworld_fast_uint>(
-                floor(m->runif() * n_left--)
+                floor(u[i] * n_left--)
                 );
 
             // Correcting for possible overflow
@@ -7,15 +7,33 @@
 #include <string>
 #include <map>
 #include <unordered_map>
+#include <unordered_set>
+#include <limits>
 #include <chrono>
 #include <climits>
 #include <cstdint>
 #include <algorithm>
 #include <regex>
+#include <iterator>
+#include <cstring>
+#include <exception>
+#include <cstdio>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 #ifndef EPIWORLD_HPP
 #define EPIWORLD_HPP
 
+#if !defined(EPI_NO_MMAP) && (defined(__unix__) || defined(__APPLE__))
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #define EPI_HAS_MMAP
+#endif
+
 /* Versioning */
 #define EPIWORLD_VERSION_MAJOR 0
 #define EPIWORLD_VERSION_MINOR 6
@@ -34,6 +52,8 @@ namespace epiworld {
     #include "progress.hpp"
 
     #include "math/distributions.hpp"
+    #include "math/philox.hpp"
+    #include "math/quantile-sketch.hpp"
 
     #include "math/lfmcmc.hpp"
 
@@ -42,14 +62,24 @@ namespace epiworld {
 
     #include "seq_processing.hpp"
 
+    #include "edgelist-io-bones.hpp"
+    #include "edgelist-io-meat.hpp"
+    #include "datatable-bones.hpp"
+    #include "datatable-meat.hpp"
+    #include "transmissionlog.hpp"
+    #include "transmissionstats.hpp"
     #include "database-bones.hpp"
     #include "database-meat.hpp"
     #include "adjlist-bones.hpp"
     #include "adjlist-meat.hpp"
+    #include "network-csr-bones.hpp"
+    #include "network-csr-meat.hpp"
 
     #include "randgraph.hpp"
 
     #include "queue-bones.hpp"
+    #include "statesets-bones.hpp"
+    #include "statetimers-bones.hpp"
 
     #include "globalevent-bones.hpp"
     #include "globalevent-meat.hpp"
@@ -57,6 +87,9 @@ namespace epiworld {
     #include "model-bones.hpp"
     #include "model-meat.hpp"
 
+    #include "runaggregator-bones.hpp"
+    #include "runaggregator-meat.hpp"
+
     #include "viruses-bones.hpp"
 
     #include "virus-bones.hpp"
@@ -64,6 +97,7 @@ namespace epiworld {
     #include "virus-meat.hpp"
     
     #include "tools-bones.hpp"
+    #include "neighbors-bones.hpp"
 
     #include "tool-bones.hpp"
     #include "tool-distribute-meat.hpp"
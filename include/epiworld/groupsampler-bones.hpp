@@ -2,58 +2,93 @@
 #define GROUPSAMPLER_BONES_HPP
 
 /**
- * @brief Weighted sampling of groups
+ * @brief Samples the contacts of an agent with the infected of each group
+ *
+ * @details An agent of group `a` has `n_g ~ Binom(I_g, r_ag)` contacts with
+ * the `I_g` infected agents of group `g`, where `r_ag` is the contact rate
+ * times the entry `(a, g)` of the contact matrix. Drawing each `n_g` with
+ * `Model::rbinom(n, p)` sets up a new binomial distribution for every agent
+ * and group. Instead, `update()` precomputes (once per day) the binomial
+ * parameters of every pair of groups, the groups each group can reach, and
+ * the probability of not having contacts at all. Then `sample()`:
+ *
+ * 1. Uses a single uniform draw to decide whether the agent has any
+ *    contacts (most agents don't when prevalence is low).
+ * 2. Otherwise, goes through the reachable groups drawing `n_g` conditional
+ *    on having at least one contact in the remaining groups, until one is
+ *    positive (drawn from a zero-truncated binomial), and the rest
+ *    unconditionally with the precomputed parameters.
+ *
+ * The counts have the same distribution as independent binomial draws.
+ *
+ * @tparam TSeq
  */
-template<typename TSeq> 
+template<typename TSeq>
 class GroupSampler {
 
 private:
-    
-    std::vector< double > contact_matrix; ///< Contact matrix between groups
-    std::vector< size_t > group_sizes;    ///< Sizes of the groups
-    std::vector< double > cumulate;       ///< Cumulative sum of the contact matrix (row-major for faster access)
+
+    size_t ngroups = 0u;
 
     /**
-     * @brief Get the index of the contact matrix
-     * 
-     * The matrix is a vector stored in column-major order.
-     * 
-     * @param i Index of the row
-     * @param j Index of the column
-     * @return Index of the contact matrix
+     * @name Daily parameters (row-major, `[a * ngroups + g]`)
      */
-    inline int idx(const int i, const int j, bool rowmajor = false) const
-    {
-        
-        if (rowmajor)
-            return i * group_sizes.size() + j;
-        
-        return j * group_sizes.size() + i; 
+    ///@{
+    std::vector< std::binomial_distribution<>::param_type > binom;
+    std::vector< double > prob_zero;      ///< P(n_g = 0)
+    ///@}
 
-    }
+    /**
+     * @name Reachable groups of each group
+     * @details The targets of `a` are stored in `targets[offsets[a]]` to
+     * `targets[offsets[a + 1] - 1]`, and `tail_zero[offsets[a] + k]` is the
+     * probability of no contacts with the targets `k, k + 1, ...` of `a`
+     * (the extra element of each group is 1).
+     */
+    ///@{
+    std::vector< size_t > targets;
+    std::vector< size_t > offsets;
+    std::vector< double > tail_zero;
+    ///@}
+
+    int sample_positive(Model<TSeq> * model, size_t a, size_t g) const;
 
 public:
 
     GroupSampler() {};
 
-    GroupSampler(
-        const std::vector< double > & contact_matrix_,
-        const std::vector< size_t > & group_sizes_,
-        bool normalize = true
+    /**
+     * @brief Sets the parameters of the day
+     *
+     * @param contact_matrix Contact matrix (column-major, rows add to one.)
+     * @param ninfected Number of infected agents in each group.
+     * @param contact_rate Contact rate per agent (e.g., the contact rate of
+     * the model divided by the population size.)
+     */
+    void update(
+        const std::vector< double > & contact_matrix,
+        const std::vector< size_t > & ninfected,
+        double contact_rate
     );
 
-    int sample_1(
+    /**
+     * @brief Samples the contacts of an agent
+     *
+     * @param model The model (source of random numbers.)
+     * @param origin_group Group of the agent.
+     * @param fun Called as `fun(g, n)` for every group `g` with `n > 0`
+     * contacts, in increasing order of `g`.
+     * @return The total number of contacts.
+     */
+    template<typename TFun>
+    int sample(
         Model<TSeq> * model,
-        const int origin_group
-        );
+        size_t origin_group,
+        TFun fun
+    ) const;
 
-    void sample_n(
-        Model<TSeq> * model,
-        std::vector< int > & sample,
-        const int origin_group,
-        const int nsamples
-    );
+    size_t get_ngroups() const {return ngroups;};
 
 };
 
-#endif
\ No newline at end of file
+#endif
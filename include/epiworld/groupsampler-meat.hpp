@@ -2,83 +2,171 @@
 #define GROUPSAMPLER_MEAT_HPP
 
 template<typename TSeq>
-inline GroupSampler<TSeq>::GroupSampler(
-        const std::vector< double > & contact_matrix_,
-        const std::vector< size_t > & group_sizes_,
-        bool normalize
-    ): contact_matrix(contact_matrix_), group_sizes(group_sizes_) {
+inline void GroupSampler<TSeq>::update(
+    const std::vector< double > & contact_matrix,
+    const std::vector< size_t > & ninfected,
+    double contact_rate
+)
+{
 
+    ngroups = ninfected.size();
+    if (contact_matrix.size() != ngroups * ngroups)
+        throw std::length_error(
+            "The contact matrix must be of size ngroups x ngroups (" +
+            std::to_string(ngroups) + " x " + std::to_string(ngroups) + ")."
+            );
 
-        this->cumulate.resize(contact_matrix.size());
-        std::fill(cumulate.begin(), cumulate.end(), 0.0);
+    binom.resize(ngroups * ngroups);
+    prob_zero.assign(ngroups * ngroups, 1.0);
 
-        // Cumulative sum
-        for (size_t j = 0; j < group_sizes.size(); ++j)
-        {
-            for (size_t i = 0; i < group_sizes.size(); ++i)
-                cumulate[idx(i, j, true)] += 
-                    cumulate[idx(i, j - 1, true)] +
-                    contact_matrix[idx(i, j)];
-        }
+    targets.clear();
+    offsets.assign(1u, 0u);
+    tail_zero.clear();
 
-        if (normalize)
+    for (size_t a = 0u; a < ngroups; ++a)
+    {
+
+        size_t start = targets.size();
+        for (size_t g = 0u; g < ngroups; ++g)
         {
-            for (size_t i = 0; i < group_sizes.size(); ++i)
-            {
-                double sum = 0.0;
-                for (size_t j = 0; j < group_sizes.size(); ++j)
-                    sum += contact_matrix[idx(i, j, true)];
-                for (size_t j = 0; j < group_sizes.size(); ++j)
-                    contact_matrix[idx(i, j, true)] /= sum;
-            }
+
+            // Column-major
+            double r = std::min(contact_rate * contact_matrix[g * ngroups + a], 1.0);
+            if ((ninfected[g] == 0u) || (r <= 0.0))
+                continue;
+
+            binom[a * ngroups + g] = std::binomial_distribution<>::param_type(
+                static_cast< int >(ninfected[g]), r
+                );
+
+            prob_zero[a * ngroups + g] = std::exp(
+                static_cast< double >(ninfected[g]) * std::log1p(-r)
+                );
+
+            targets.push_back(g);
+
         }
 
-    };
+        // Probability of no contacts from the k-th target on
+        tail_zero.resize(targets.size() + a + 1u);
+        tail_zero[targets.size() + a] = 1.0;
+        for (size_t k = targets.size(); k-- > start;)
+            tail_zero[k + a] = tail_zero[k + a + 1u] *
+                prob_zero[a * ngroups + targets[k]];
+
+        offsets.push_back(targets.size());
+
+    }
+
+}
 
 template<typename TSeq>
-int GroupSampler<TSeq>::sample_1(
+inline int GroupSampler<TSeq>::sample_positive(
     Model<TSeq> * model,
-    const int origin_group
-    )
+    size_t a,
+    size_t g
+) const
 {
 
-    // Random number
-    double r = model->runif();
+    const auto & par = binom[a * ngroups + g];
+    int n    = par.t();
+    double r = par.p();
+
+    if (r >= 1.0)
+        return n;
+
+    // Many expected contacts: zero is rare
+    if ((static_cast< double >(n) * r) > 10.0)
+    {
 
-    // Finding the group
-    size_t j = 0;
-    while (r > cumulate[idx(origin_group, j, true)])
-        ++j;
+        int res;
+        do
+            res = model->rbinom(par);
+        while (res == 0);
 
-    // Adjusting the prob
-    r = r - (j == 0 ? 0.0 : cumulate[idx(origin_group, j - 1, true)]);
+        return res;
 
-    int res = static_cast<int>(
-        std::floor(r * group_sizes[j])
-    );
+    }
 
-    // Making sure we are not picking outside of the group
-    if (res >= static_cast<int>(group_sizes[j]))
-        res = static_cast<int>(group_sizes[j]) - 1;
+    // Few expected contacts: inverting the CDF from one
+    double odds   = r / (1.0 - r);
+    double pmf    = static_cast< double >(n) * r * std::exp(
+        static_cast< double >(n - 1) * std::log1p(-r)
+        );
 
-    return model->get_entities()[j][res]->get_id();
+    double target = model->runif() * (1.0 - prob_zero[a * ngroups + g]);
+    double cdf    = pmf;
+    int k = 1;
+    while ((target > cdf) && (k < n))
+    {
+        pmf *= static_cast< double >(n - k) / static_cast< double >(k + 1) * odds;
+        cdf += pmf;
+        ++k;
+    }
+
+    return k;
 
 }
 
 template<typename TSeq>
-void GroupSampler<TSeq>::sample_n(
+template<typename TFun>
+inline int GroupSampler<TSeq>::sample(
     Model<TSeq> * model,
-    std::vector< int > & sample,
-    const int origin_group,
-    const int nsamples
-)
+    size_t origin_group,
+    TFun fun
+) const
 {
 
-    for (int i = 0; i < nsamples; ++i)
-        sample[i] = sample_1(model, origin_group);
+    size_t a     = origin_group;
+    size_t start = offsets[a];
+    size_t end   = offsets[a + 1u];
+    if (start == end)
+        return 0;
+
+    // Tails are shifted by one per group (see update())
+    const double * tail = &tail_zero[start + a];
+
+    // No contacts at all
+    if (model->runif() < tail[0u])
+        return 0;
+
+    int total = 0;
+    bool need = true;
+    for (size_t k = 0u; k < (end - start); ++k)
+    {
+
+        size_t g = targets[start + k];
+        int n;
+        if (need)
+        {
+
+            // P(n_g = 0 | some contact in the targets k, k + 1, ...)
+            double p0 = 0.0;
+            if (tail[k] < 1.0)
+                p0 = prob_zero[a * ngroups + g] * (1.0 - tail[k + 1u]) /
+                    (1.0 - tail[k]);
+
+            if (model->runif() < p0)
+                continue;
+
+            n = sample_positive(model, a, g);
+            need = false;
+
+        } else {
+
+            n = model->rbinom(binom[a * ngroups + g]);
+            if (n == 0)
+                continue;
+
+        }
+
+        total += n;
+        fun(g, n);
+
+    }
 
-    return;
+    return total;
 
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -1,7 +1,10 @@
 #ifndef EPIWORLD_LFMCMC_HPP
 #define EPIWORLD_LFMCMC_HPP
 
+#include "lfmcmc/lfmcmc-cache.hpp"
 #include "lfmcmc/lfmcmc-bones.hpp"
 #include "lfmcmc/lfmcmc-meat.hpp"
+#include "lfmcmc/abcsmc-bones.hpp"
+#include "lfmcmc/abcsmc-meat.hpp"
 
 #endif
\ No newline at end of file
@@ -0,0 +1,155 @@
+#ifndef EPIWORLD_ABCSMC_BONES_HPP
+#define EPIWORLD_ABCSMC_BONES_HPP
+
+template<typename TData>
+using ABCSMCPriorFun = std::function<void(std::vector< epiworld_double >&,LFMCMC<TData>*)>;
+
+using ABCSMCDensityFun = std::function<epiworld_double(const std::vector< epiworld_double >&)>;
+
+/**
+ * @brief Approximate Bayesian Computation Sequential Monte Carlo
+ *
+ * @details Adaptive ABC-SMC (Del Moral, Doucet, and Jasra, 2012). A
+ * population of particles drawn from the prior is moved towards the
+ * posterior while epsilon shrinks:
+ *
+ * 1. The next epsilon is the one that keeps a fraction `alpha` (see
+ *   `set_ess_fraction()`) of the effective sample size (ESS). This only
+ *   re-evaluates the kernel on the statistics already simulated.
+ * 2. If the ESS drops below half the particles, the population is
+ *   resampled.
+ * 3. Each particle makes one ABC Metropolis-Hastings move (a normal
+ *   proposal scaled by the variance of the population), which takes one
+ *   simulation per particle. The moves run in parallel.
+ *
+ * The algorithm stops when epsilon reaches its target, when the acceptance
+ * rate of the moves drops below `set_min_acceptance()`, or after
+ * `set_max_iter()` iterations.
+ *
+ * The observed data, simulation, summary, and kernel functions, and the
+ * random number engine are taken from an `LFMCMC` object, so the same
+ * functions serve both samplers. The functions receive the `LFMCMC` object
+ * of the thread running them; `m->get_chain_id()` is the thread number,
+ * so simulation functions can use one (pre-forked) model copy per thread.
+ * Every move is seeded on its own, so results do not depend on the number
+ * of threads as long as the simulation only uses the random numbers of
+ * `m` (e.g., by seeding the model with `m->runif()`).
+ *
+ * Moves support early rejection as in `LFMCMC` (see
+ * `LFMCMC::reject_proposal()`).
+ *
+ * @tparam TData Type of data that is generated
+ */
+template<typename TData>
+class ABCSMC {
+private:
+
+    LFMCMC<TData> m_sampler;                        ///< Data, functions, and RNG
+
+    ABCSMCPriorFun<TData> m_prior_fun;              ///< Draws from the prior
+    ABCSMCDensityFun m_prior_density_fun;           ///< Prior density
+
+    epiworld_double m_alpha          = 0.9;
+    epiworld_double m_min_acceptance = 0.015;
+    size_t m_max_iter                = 100u;
+
+    size_t m_n_particles = 0u;
+    size_t m_n_params    = 0u;
+    size_t m_n_stats     = 0u;
+
+    std::vector< epiworld_double > m_observed_stats;
+
+    std::vector< epiworld_double > m_particles;     ///< Parameters (particle-major)
+    std::vector< epiworld_double > m_stats;         ///< Statistics (particle-major)
+    std::vector< epiworld_double > m_weights;       ///< Normalized weights
+    std::vector< epiworld_double > m_kernel_scores; ///< At the current epsilon
+    std::vector< epiworld_double > m_prior_density;
+
+    std::vector< epiworld_double > m_epsilons;      ///< Epsilon of each iteration
+    std::vector< epiworld_double > m_acceptance;    ///< Acceptance rate of each iteration
+    std::vector< epiworld_double > m_ess;           ///< ESS of each iteration
+    size_t m_n_simulations = 0u;
+    size_t m_n_rejected_early = 0u;
+
+    std::vector< epiworld_fast_uint > draw_seeds(size_t n);
+    epiworld_double ess() const;
+    void update_epsilon(epiworld_double epsilon, LFMCMC<TData> & worker);
+    void resample();
+
+    template<typename TFun>
+    void for_each_particle(
+        std::vector< LFMCMC<TData> > & workers,
+        int nthreads,
+        TFun fun
+        );
+
+public:
+
+    ABCSMC(const LFMCMC<TData> & sampler);
+
+    /**
+     * @name Prior distribution
+     *
+     * @param sampler Writes a draw from the prior in its first argument.
+     * @param density Density of the prior (up to a constant).
+     * @param lb,ub Bounds of independent uniform priors.
+     */
+    ///@{
+    void set_prior(ABCSMCPriorFun<TData> sampler, ABCSMCDensityFun density);
+    void set_prior_uniform(
+        std::vector< epiworld_double > lb,
+        std::vector< epiworld_double > ub
+        );
+    ///@}
+
+    /**
+     * @name Tuning
+     *
+     * @param alpha Fraction of the ESS kept by each new epsilon (in (0, 1)).
+     * @param rate Minimum acceptance rate of the moves.
+     * @param n Maximum number of iterations.
+     */
+    ///@{
+    void set_ess_fraction(epiworld_double alpha);
+    void set_min_acceptance(epiworld_double rate);
+    void set_max_iter(size_t n);
+    ///@}
+
+    /**
+     * @brief Runs the algorithm
+     *
+     * @param n_particles Size of the population.
+     * @param epsilon Target epsilon.
+     * @param seed Seed (ignored if negative).
+     * @param nthreads Number of threads (only with OpenMP).
+     */
+    void run(
+        size_t n_particles,
+        epiworld_double epsilon,
+        int seed = -1,
+        int nthreads = 1
+        );
+
+    size_t get_n_particles() const {return m_n_particles;};
+    size_t get_n_params() const {return m_n_params;};
+    size_t get_n_stats() const {return m_n_stats;};
+    size_t get_n_simulations() const {return m_n_simulations;}; ///< Model evaluations
+    size_t get_n_rejected_early() const {return m_n_rejected_early;}; ///< See `LFMCMC::reject_proposal()`
+    epiworld_double get_epsilon() const; ///< Final epsilon
+
+    const std::vector< epiworld_double > & get_observed_stats() const {return m_observed_stats;};
+    const std::vector< epiworld_double > & get_particles() const {return m_particles;};
+    const std::vector< epiworld_double > & get_stats() const {return m_stats;};
+    const std::vector< epiworld_double > & get_weights() const {return m_weights;};
+    const std::vector< epiworld_double > & get_epsilons() const {return m_epsilons;};
+    const std::vector< epiworld_double > & get_acceptance() const {return m_acceptance;};
+    const std::vector< epiworld_double > & get_ess() const {return m_ess;};
+
+    std::vector< epiworld_double > get_mean_params() const; ///< Weighted means
+    std::vector< epiworld_double > get_mean_stats() const;  ///< Weighted means
+
+    void print() const;
+
+};
+
+#endif
@@ -0,0 +1,707 @@
+#ifndef EPIWORLD_ABCSMC_MEAT_HPP
+#define EPIWORLD_ABCSMC_MEAT_HPP
+
+#include "abcsmc-bones.hpp"
+
+template<typename TData>
+inline ABCSMC<TData>::ABCSMC(const LFMCMC<TData> & sampler) :
+    m_sampler(sampler)
+{
+
+    // Only the data and the functions are needed
+    m_sampler.clear_samples();
+
+}
+
+template<typename TData>
+inline void ABCSMC<TData>::set_prior(
+    ABCSMCPriorFun<TData> sampler,
+    ABCSMCDensityFun density
+)
+{
+
+    m_prior_fun         = sampler;
+    m_prior_density_fun = density;
+
+}
+
+template<typename TData>
+inline void ABCSMC<TData>::set_prior_uniform(
+    std::vector< epiworld_double > lb,
+    std::vector< epiworld_double > ub
+)
+{
+
+    if (lb.size() != ub.size())
+        throw std::length_error("-lb- and -ub- must have the same length.");
+
+    for (size_t k = 0u; k < lb.size(); ++k)
+        if (!(lb[k] < ub[k]))
+            throw std::range_error(
+                "The lower bound of parameter " + std::to_string(k) +
+                " is not below its upper bound."
+                );
+
+    m_prior_fun = [lb, ub](
+        std::vector< epiworld_double > & params,
+        LFMCMC<TData> * m
+    ) -> void {
+
+        params.resize(lb.size());
+        for (size_t k = 0u; k < lb.size(); ++k)
+            params[k] = m->runif(lb[k], ub[k]);
+
+    };
+
+    m_prior_density_fun = [lb, ub](
+        const std::vector< epiworld_double > & params
+    ) -> epiworld_double {
+
+        for (size_t k = 0u; k < lb.size(); ++k)
+            if ((params[k] < lb[k]) || (params[k] > ub[k]))
+                return 0.0;
+
+        return 1.0;
+
+    };
+
+}
+
+template<typename TData>
+inline void ABCSMC<TData>::set_ess_fraction(epiworld_double alpha)
+{
+
+    if ((alpha <= 0.0) || (alpha >= 1.0))
+        throw std::range_error("-alpha- must be in (0, 1).");
+
+    m_alpha = alpha;
+
+}
+
+template<typename TData>
+inline void ABCSMC<TData>::set_min_acceptance(epiworld_double rate)
+{
+
+    if ((rate < 0.0) || (rate > 1.0))
+        throw std::range_error("-rate- must be in [0, 1].");
+
+    m_min_acceptance = rate;
+
+}
+
+template<typename TData>
+inline void ABCSMC<TData>::set_max_iter(size_t n)
+{
+    m_max_iter = n;
+}
+
+template<typename TData>
+inline std::vector< epiworld_fast_uint > ABCSMC<TData>::draw_seeds(size_t n)
+{
+
+    std::vector< epiworld_fast_uint > seeds(n);
+    for (auto & s : seeds)
+        s = static_cast< epiworld_fast_uint >(std::floor(
+            m_sampler.runif() * static_cast< epiworld_double >(
+                std::numeric_limits< int >::max()
+                )
+        ));
+
+    return seeds;
+
+}
+
+template<typename TData>
+inline epiworld_double ABCSMC<TData>::ess() const
+{
+
+    epiworld_double sum2 = 0.0;
+    for (auto & w : m_weights)
+        sum2 += w * w;
+
+    return (sum2 > 0.0) ? 1.0 / sum2 : 0.0;
+
+}
+
+template<typename TData>
+inline void ABCSMC<TData>::update_epsilon(
+    epiworld_double epsilon,
+    LFMCMC<TData> & worker
+)
+{
+
+    // Weights and kernel scores at a candidate epsilon
+    std::vector< epiworld_double > weights(m_n_particles);
+    std::vector< epiworld_double > scores(m_n_particles);
+    auto reweight = [&](epiworld_double eps) -> epiworld_double {
+
+        worker.m_epsilon = eps;
+
+        std::vector< epiworld_double > stats(m_n_stats);
+        epiworld_double sum = 0.0;
+        epiworld_double sum2 = 0.0;
+        for (size_t i = 0u; i < m_n_particles; ++i)
+        {
+
+            weights[i] = 0.0;
+            scores[i]  = 0.0;
+            if (m_weights[i] <= 0.0)
+                continue;
+
+            stats.assign(
+                m_stats.begin() + i * m_n_stats,
+                m_stats.begin() + (i + 1u) * m_n_stats
+                );
+
+            scores[i] = m_sampler.m_kernel_fun(
+                stats, m_observed_stats, eps, &worker
+                );
+
+            weights[i] = m_weights[i] * scores[i] / m_kernel_scores[i];
+            sum  += weights[i];
+            sum2 += weights[i] * weights[i];
+
+        }
+
+        return (sum2 > 0.0) ? sum * sum / sum2 : 0.0;
+
+    };
+
+    epiworld_double target = m_alpha * ess();
+
+    // Upper bound (the first one is found by doubling)
+    epiworld_double hi;
+    if (m_epsilons.size() > 0u)
+        hi = m_epsilons.back();
+    else
+    {
+
+        hi = std::max(static_cast< epiworld_double >(1.0), epsilon);
+        for (int i = 0; (i < 1000) && (reweight(hi) < target); ++i)
+            hi *= 2.0;
+
+        if (reweight(hi) < target)
+            throw std::runtime_error(
+                "Could not find an initial epsilon. Check the kernel function."
+                );
+
+    }
+
+    epiworld_double lo = epsilon;
+    if ((lo < hi) && (reweight(lo) < target))
+    {
+
+        for (int i = 0; i < 60; ++i)
+        {
+
+            epiworld_double mid = (lo + hi) / 2.0;
+            if (reweight(mid) >= target)
+                hi = mid;
+            else
+                lo = mid;
+
+        }
+
+        lo = hi;
+
+    }
+
+    reweight(lo);
+
+    epiworld_double sum = 0.0;
+    for (auto & w : weights)
+        sum += w;
+
+    // If the kernel is zero for every particle, the weights stay at zero
+    if (sum > 0.0)
+        for (auto & w : weights)
+            w /= sum;
+
+    m_weights.swap(weights);
+    m_kernel_scores.swap(scores);
+    m_epsilons.push_back(lo);
+
+}
+
+template<typename TData>
+inline void ABCSMC<TData>::resample()
+{
+
+    // Systematic resampling
+    epiworld_double step = 1.0 / static_cast< epiworld_double >(m_n_particles);
+    epiworld_double u    = m_sampler.runif() * step;
+    epiworld_double cum  = m_weights[0u];
+
+    std::vector< size_t > idx(m_n_particles);
+    size_t j = 0u;
+    for (size_t i = 0u; i < m_n_particles; ++i)
+    {
+
+        while ((u > cum) && (j < m_n_particles - 1u))
+            cum += m_weights[++j];
+
+        idx[i] = j;
+        u += step;
+
+    }
+
+    std::vector< epiworld_double > particles(m_particles.size());
+    std::vector< epiworld_double > stats(m_stats.size());
+    std::vector< epiworld_double > scores(m_n_particles);
+    std::vector< epiworld_double > density(m_n_particles);
+    for (size_t i = 0u; i < m_n_particles; ++i)
+    {
+
+        std::copy_n(
+            m_particles.begin() + idx[i] * m_n_params, m_n_params,
+            particles.begin() + i * m_n_params
+            );
+
+        std::copy_n(
+            m_stats.begin() + idx[i] * m_n_stats, m_n_stats,
+            stats.begin() + i * m_n_stats
+            );
+
+        scores[i]  = m_kernel_scores[idx[i]];
+        density[i] = m_prior_density[idx[i]];
+
+    }
+
+    m_particles.swap(particles);
+    m_stats.swap(stats);
+    m_kernel_scores.swap(scores);
+    m_prior_density.swap(density);
+    m_weights.assign(m_n_particles, step);
+
+}
+
+template<typename TData>
+template<typename TFun>
+inline void ABCSMC<TData>::for_each_particle(
+    std::vector< LFMCMC<TData> > & workers,
+    #ifdef _OPENMP
+    int nthreads,
+    #else
+    int,
+    #endif
+    TFun fun
+)
+{
+
+    std::exception_ptr error = nullptr;
+
+    #ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads) schedule(dynamic, 1)
+    #endif
+    for (int i = 0; i < static_cast< int >(m_n_particles); ++i)
+    {
+
+        try
+        {
+            fun(static_cast< size_t >(i), workers[EPI_GET_THREAD_ID()]);
+        }
+        catch (...)
+        {
+            #ifdef _OPENMP
+            #pragma omp critical
+            #endif
+            {
+                if (!error)
+                    error = std::current_exception();
+            }
+        }
+
+    }
+
+    if (error)
+        std::rethrow_exception(error);
+
+}
+
+template<typename TData>
+inline void ABCSMC<TData>::run(
+    size_t n_particles,
+    epiworld_double epsilon,
+    int seed,
+    int nthreads
+)
+{
+
+    if (!m_prior_fun || !m_prior_density_fun)
+        throw std::logic_error(
+            "The prior is not set. Use set_prior() or set_prior_uniform()."
+            );
+
+    if (n_particles < 2u)
+        throw std::logic_error("At least two particles are needed.");
+
+    m_sampler.m_elapsed_time =
+        std::chrono::duration<epiworld_double,std::micro>::zero();
+    m_sampler.chrono_start();
+
+    if (seed >= 0)
+        m_sampler.seed(seed);
+
+    #ifdef _OPENMP
+    nthreads = std::max(nthreads, 1);
+    #else
+    nthreads = 1;
+    #endif
+
+    // One sampler per thread (the chain id is the thread number)
+    std::vector< LFMCMC<TData> > workers;
+    for (int k = 0; k < nthreads; ++k)
+        workers.push_back(m_sampler.fork(static_cast< size_t >(k)));
+
+    m_n_particles = n_particles;
+    m_epsilons.clear();
+    m_acceptance.clear();
+    m_ess.clear();
+    m_n_rejected_early = 0u;
+
+    // Every proposal is kept while drawing the initial population
+    for (auto & w : workers)
+    {
+        w.m_epsilon          = std::numeric_limits< epiworld_double >::infinity();
+        w.m_kernel_threshold = -std::numeric_limits< epiworld_double >::infinity();
+    }
+
+    m_sampler.m_summary_fun(
+        m_observed_stats, m_sampler.m_observed_data, &workers[0u]
+        );
+    m_n_stats = m_observed_stats.size();
+
+    // Initial population, drawn from the prior
+    std::vector< std::vector< epiworld_double > > params0(n_particles);
+    std::vector< std::vector< epiworld_double > > stats0(n_particles);
+    std::vector< epiworld_fast_uint > seeds = draw_seeds(n_particles);
+    for_each_particle(workers, nthreads,
+        [&](size_t i, LFMCMC<TData> & w) -> void {
+
+        w.seed(seeds[i]);
+        m_prior_fun(params0[i], &w);
+
+        w.m_n_params       = params0[i].size();
+        w.m_current_params = params0[i];
+        TData data = m_sampler.m_simulation_fun(params0[i], &w);
+        m_sampler.m_summary_fun(stats0[i], data, &w);
+
+    });
+
+    m_n_params = params0[0u].size();
+    m_n_simulations = n_particles;
+
+    m_particles.resize(n_particles * m_n_params);
+    m_stats.resize(n_particles * m_n_stats);
+    m_prior_density.resize(n_particles);
+    for (size_t i = 0u; i < n_particles; ++i)
+    {
+
+        if ((params0[i].size() != m_n_params) || (stats0[i].size() != m_n_stats))
+            throw std::length_error(
+                "The number of parameters or statistics differs across particles."
+                );
+
+        std::copy(
+            params0[i].begin(), params0[i].end(),
+            m_particles.begin() + i * m_n_params
+            );
+
+        std::copy(
+            stats0[i].begin(), stats0[i].end(),
+            m_stats.begin() + i * m_n_stats
+            );
+
+        m_prior_density[i] = m_prior_density_fun(params0[i]);
+
+    }
+
+    m_weights.assign(n_particles, 1.0 / static_cast< epiworld_double >(n_particles));
+    m_kernel_scores.assign(n_particles, 1.0);
+
+    for (auto & w : workers)
+    {
+        w.m_n_params       = m_n_params;
+        w.m_n_stats        = m_n_stats;
+        w.m_observed_stats = m_observed_stats;
+    }
+
+    std::vector< epiworld_double > sd(m_n_params);
+    std::vector< char > accepted(n_particles);
+    std::vector< char > simulated(n_particles);
+    std::vector< char > rejected(n_particles);
+    for (size_t iter = 0u; iter < m_max_iter; ++iter)
+    {
+
+        // Step 1: Shrinking epsilon
+        update_epsilon(epsilon, workers[0u]);
+        epiworld_double eps = m_epsilons.back();
+
+        // No particle is left to resample or move
+        if (!(ess() > 0.0))
+        {
+            m_acceptance.push_back(0.0);
+            break;
+        }
+
+        // Step 2: Resampling
+        if (ess() < static_cast< epiworld_double >(n_particles) / 2.0)
+            resample();
+
+        m_ess.push_back(ess());
+
+        // Step 3: Moving the particles. The proposal is scaled by twice the
+        // variance of the population.
+        for (size_t k = 0u; k < m_n_params; ++k)
+        {
+
+            epiworld_double mean = 0.0;
+            for (size_t i = 0u; i < n_particles; ++i)
+                mean += m_weights[i] * m_particles[i * m_n_params + k];
+
+            epiworld_double var = 0.0;
+            for (size_t i = 0u; i < n_particles; ++i)
+                var += m_weights[i] *
+                    std::pow(m_particles[i * m_n_params + k] - mean, 2.0);
+
+            sd[k] = std::sqrt(2.0 * var);
+
+        }
+
+        for (auto & w : workers)
+            w.m_epsilon = eps;
+
+        seeds = draw_seeds(n_particles);
+        std::fill(accepted.begin(), accepted.end(), 0);
+        std::fill(simulated.begin(), simulated.end(), 0);
+        std::fill(rejected.begin(), rejected.end(), 0);
+        for_each_particle(workers, nthreads,
+            [&](size_t i, LFMCMC<TData> & w) -> void {
+
+            if (m_weights[i] <= 0.0)
+                return;
+
+            w.seed(seeds[i]);
+
+            epiworld_double * particle = &m_particles[i * m_n_params];
+            w.m_previous_params.assign(particle, particle + m_n_params);
+            w.m_current_params.resize(m_n_params);
+            for (size_t k = 0u; k < m_n_params; ++k)
+                w.m_current_params[k] = particle[k] + sd[k] * w.rnorm();
+
+            epiworld_double u = w.runif();
+
+            // Proposals outside of the prior are rejected without simulating
+            epiworld_double density = m_prior_density_fun(w.m_current_params);
+            if (!(density > 0.0))
+                return;
+
+            simulated[i] = 1;
+            w.m_kernel_threshold =
+                u * m_kernel_scores[i] * m_prior_density[i] / density;
+            w.m_rejected = false;
+
+            TData data = m_sampler.m_simulation_fun(w.m_current_params, &w);
+
+            if (w.m_rejected)
+            {
+                rejected[i] = 1;
+                return;
+            }
+
+            std::vector< epiworld_double > stats;
+            m_sampler.m_summary_fun(stats, data, &w);
+
+            epiworld_double score = m_sampler.m_kernel_fun(
+                stats, m_observed_stats, eps, &w
+                );
+
+            if (u * m_kernel_scores[i] * m_prior_density[i] < score * density)
+            {
+
+                std::copy(
+                    w.m_current_params.begin(), w.m_current_params.end(),
+                    particle
+                    );
+
+                std::copy(
+                    stats.begin(), stats.end(),
+                    m_stats.begin() + i * m_n_stats
+                    );
+
+                m_kernel_scores[i] = score;
+                m_prior_density[i] = density;
+                accepted[i] = 1;
+
+            }
+
+        });
+
+        size_t n_alive = 0u, n_accepted = 0u;
+        for (size_t i = 0u; i < n_particles; ++i)
+        {
+            n_alive         += (m_weights[i] > 0.0) ? 1u : 0u;
+            n_accepted      += static_cast< size_t >(accepted[i]);
+            m_n_simulations += static_cast< size_t >(simulated[i]);
+            m_n_rejected_early += static_cast< size_t >(rejected[i]);
+        }
+
+        m_acceptance.push_back((n_alive > 0u) ?
+            static_cast< epiworld_double >(n_accepted) /
+            static_cast< epiworld_double >(n_alive) : 0.0
+            );
+
+        if ((eps <= epsilon) || (m_acceptance.back() < m_min_acceptance))
+            break;
+
+    }
+
+    m_sampler.chrono_end();
+
+}
+
+template<typename TData>
+inline epiworld_double ABCSMC<TData>::get_epsilon() const
+{
+
+    if (m_epsilons.size() == 0u)
+        return std::numeric_limits< epiworld_double >::infinity();
+
+    return m_epsilons.back();
+
+}
+
+template<typename TData>
+inline std::vector< epiworld_double > ABCSMC<TData>::get_mean_params() const
+{
+
+    std::vector< epiworld_double > res(m_n_params, 0.0);
+    for (size_t i = 0u; i < m_n_particles; ++i)
+        for (size_t k = 0u; k < m_n_params; ++k)
+            res[k] += m_weights[i] * m_particles[i * m_n_params + k];
+
+    return res;
+
+}
+
+template<typename TData>
+inline std::vector< epiworld_double > ABCSMC<TData>::get_mean_stats() const
+{
+
+    std::vector< epiworld_double > res(m_n_stats, 0.0);
+    for (size_t i = 0u; i < m_n_particles; ++i)
+        for (size_t k = 0u; k < m_n_stats; ++k)
+            res[k] += m_weights[i] * m_stats[i * m_n_stats + k];
+
+    return res;
+
+}
+
+template<typename TData>
+inline void ABCSMC<TData>::print() const
+{
+
+    // Weighted mean and 95% credible interval of each column
+    auto summarize = [this](
+        const std::vector< epiworld_double > & x,
+        size_t ncols,
+        size_t k
+    ) -> std::vector< epiworld_double > {
+
+        std::vector< std::pair< epiworld_double, epiworld_double > > values;
+        epiworld_double mean = 0.0;
+        for (size_t i = 0u; i < m_n_particles; ++i)
+        {
+            values.emplace_back(x[i * ncols + k], m_weights[i]);
+            mean += m_weights[i] * x[i * ncols + k];
+        }
+
+        std::sort(values.begin(), values.end());
+
+        std::vector< epiworld_double > res = {mean, values.back().first, values.back().first};
+        epiworld_double cum = 0.0;
+        bool lower = false;
+        for (auto & v : values)
+        {
+
+            cum += v.second;
+            if (!lower && (cum >= .025))
+            {
+                res[1u] = v.first;
+                lower = true;
+            }
+
+            if (cum >= .975)
+            {
+                res[2u] = v.first;
+                break;
+            }
+
+        }
+
+        return res;
+
+    };
+
+    printf_epiworld("___________________________________________\n\n");
+    printf_epiworld("APPROXIMATE BAYESIAN COMPUTATION - SEQUENTIAL MONTE CARLO\n\n");
+
+    printf_epiworld("N Particles   : %zu\n", m_n_particles);
+    printf_epiworld("N Iterations  : %zu\n", m_epsilons.size());
+    printf_epiworld("N Simulations : %zu\n", m_n_simulations);
+    printf_epiworld("Epsilon       : %.4f\n", get_epsilon());
+    printf_epiworld("ESS           : %.2f\n", ess());
+
+    std::string abbr;
+    epiworld_double elapsed;
+    m_sampler.get_elapsed_time("auto", &elapsed, &abbr, false);
+    printf_epiworld("Elapsed t : %.2f%s\n\n", elapsed, abbr.c_str());
+
+    const std::vector< std::string > & par_names  = m_sampler.m_param_names;
+    const std::vector< std::string > & stat_names = m_sampler.m_stat_names;
+
+    printf_epiworld("Parameters:\n");
+    for (size_t k = 0u; k < m_n_params; ++k)
+    {
+
+        auto s = summarize(m_particles, m_n_params, k);
+        if (par_names.size() == m_n_params)
+        {
+            printf_epiworld(
+                "  -%s : % .2f [% .2f, % .2f]\n",
+                par_names[k].c_str(), s[0u], s[1u], s[2u]
+                );
+        } else {
+            printf_epiworld(
+                "  [%-2ld]: % .2f [% .2f, % .2f]\n",
+                k, s[0u], s[1u], s[2u]
+                );
+        }
+
+    }
+
+    printf_epiworld("\nStatistics:\n");
+    for (size_t k = 0u; k < m_n_stats; ++k)
+    {
+
+        auto s = summarize(m_stats, m_n_stats, k);
+        if (stat_names.size() == m_n_stats)
+        {
+            printf_epiworld(
+                "  -%s : % .2f [% .2f, % .2f] (Observed: % .2f)\n",
+                stat_names[k].c_str(), s[0u], s[1u], s[2u], m_observed_stats[k]
+                );
+        } else {
+            printf_epiworld(
+                "  [%-2ld] : % .2f [% .2f, % .2f] (Observed: % .2f)\n",
+                k, s[0u], s[1u], s[2u], m_observed_stats[k]
+                );
+        }
+
+    }
+
+    printf_epiworld("___________________________________________\n\n");
+
+}
+
+#endif
@@ -9,6 +9,9 @@
 template<typename TData>
 class LFMCMC;
 
+template<typename TData>
+class ABCSMC;
+
 template<typename TData>
 using LFMCMCSimFun = std::function<TData(const std::vector< epiworld_double >&,LFMCMC<TData>*)>;
 
@@ -116,10 +119,11 @@ inline epiworld_double kernel_fun_gaussian(
  */
 template<typename TData>
 class LFMCMC {
+    friend class ABCSMC<TData>;
 private:
 
     // Random number sampling
-    std::shared_ptr< std::mt19937 > m_engine = nullptr;
+    std::shared_ptr< epiworld_rng_engine > m_engine = nullptr;
     
     std::shared_ptr< std::uniform_real_distribution<> > runifd =
         std::make_shared< std::uniform_real_distribution<> >(0.0, 1.0);
@@ -157,6 +161,17 @@ private:
     std::vector< epiworld_double > m_accepted_stats;            ///< Posterior distribution of statistics from accepted samples
     std::vector< epiworld_double > m_accepted_kernel_scores;    ///< Kernel scores for each accepted sample
 
+    size_t m_n_chains = 1u;                                     ///< Number of chains (see `run_chains()`)
+    size_t m_chain_id = 0u;                                     ///< Chain run by this object
+    std::vector< size_t >          m_sample_chain;              ///< Chain of each sample
+
+    epiworld_double m_kernel_threshold = 0.0;                   ///< Score needed to accept the current proposal
+    bool m_rejected = false;                                    ///< The current proposal was rejected early
+    size_t m_n_rejected_early = 0u;                             ///< Proposals rejected early
+
+    LFMCMCCache m_cache;                                        ///< Summary statistics of past simulations
+    size_t m_n_cache_hits = 0u;                                 ///< Proposals answered by the cache
+
     // Functions
     LFMCMCSimFun<TData> m_simulation_fun;
     LFMCMCSummaryFun<TData> m_summary_fun;
@@ -183,6 +198,14 @@ private:
 
     void chrono_start();
     void chrono_end();
+
+    void clear_samples();
+
+    /**
+     * @brief Copy of the sampler with its own random number generation
+     * @param chain_id Value of `get_chain_id()` in the copy.
+     */
+    LFMCMC<TData> fork(size_t chain_id) const;
     
 public:
 
@@ -193,6 +216,47 @@ public:
         int seed = -1
         );
 
+    /**
+     * @brief Runs several chains in parallel
+     * 
+     * @details Each chain is run by a copy of this object with its own random
+     * number engine, seeded from `seed`, so the results do not depend on
+     * the number of threads. The samples of all the chains are stored one
+     * chain after the other (`get_n_samples()` returns the total), and
+     * `get_sample_chain()` gives the chain of each sample.
+     * 
+     * The simulation, summary, proposal, and kernel functions are called
+     * from several threads at once. Simulation functions that use a model
+     * should keep one copy of the model per chain and pick it with
+     * `m->get_chain_id()`.
+     * 
+     * @param params_init_ Initial parameters of each chain (all chains start
+     * at the same point in the first version).
+     * @param n_samples_ Number of samples per chain.
+     * @param epsilon_ Epsilon parameter of the kernel.
+     * @param n_chains Number of chains.
+     * @param seed Seed (ignored if negative).
+     * @param nthreads Number of threads (only with OpenMP).
+     */
+    ///@{
+    void run_chains(
+        std::vector< epiworld_double > params_init_,
+        size_t n_samples_,
+        epiworld_double epsilon_,
+        size_t n_chains,
+        int seed = -1,
+        int nthreads = 1
+        );
+
+    void run_chains(
+        std::vector< std::vector< epiworld_double > > params_init_,
+        size_t n_samples_,
+        epiworld_double epsilon_,
+        int seed = -1,
+        int nthreads = 1
+        );
+    ///@}
+
     LFMCMC() {};
     LFMCMC(const TData & observed_data_) : m_observed_data(observed_data_) {};
     ~LFMCMC() {};
@@ -214,14 +278,15 @@ public:
      * @param eng 
      */
     ///@{
-    void set_rand_engine(std::shared_ptr< std::mt19937 > & eng);
-    std::shared_ptr< std::mt19937 > & get_rand_endgine();
+    void set_rand_engine(std::shared_ptr< epiworld_rng_engine > & eng);
+    std::shared_ptr< epiworld_rng_engine > & get_rand_endgine();
     void seed(epiworld_fast_uint s);
     void set_rand_gamma(epiworld_double alpha, epiworld_double beta);
     epiworld_double runif();
     epiworld_double rnorm();
     epiworld_double rgamma();
     epiworld_double runif(epiworld_double lb, epiworld_double ub);
+    void runif_n(epiworld_double * x, size_t n); ///< `n` draws of `runif()`.
     epiworld_double rnorm(epiworld_double mean, epiworld_double sd);
     epiworld_double rgamma(epiworld_double alpha, epiworld_double beta);
     ///@}
@@ -231,6 +296,8 @@ public:
     size_t get_n_stats() const {return m_n_stats;};
     size_t get_n_params() const {return m_n_params;};
     epiworld_double get_epsilon() const {return m_epsilon;};
+    size_t get_n_chains() const {return m_n_chains;};
+    size_t get_chain_id() const {return m_chain_id;};
 
     const std::vector< epiworld_double > & get_initial_params() {return m_initial_params;};
     const std::vector< epiworld_double > & get_current_params() {return m_current_params;};
@@ -243,6 +310,7 @@ public:
     const std::vector< bool >            & get_sample_acceptance() {return m_sample_acceptance;};
     const std::vector< epiworld_double > & get_sample_drawn_prob() {return m_sample_drawn_prob;};
     const std::vector< epiworld_double > & get_sample_kernel_scores() {return m_sample_kernel_scores;};
+    const std::vector< size_t >          & get_sample_chain() {return m_sample_chain;};
 
     const std::vector< epiworld_double > & get_accepted_params() {return m_accepted_params;};
     const std::vector< epiworld_double > & get_accepted_stats() {return m_accepted_stats;};
@@ -250,9 +318,72 @@ public:
     
     std::vector< TData > * get_simulated_data() {return m_simulated_data;};
 
+    /**
+     * @name Early rejection
+     * 
+     * @details The random draw that decides whether a proposal is accepted
+     * is made before simulating, so the simulation function knows the
+     * kernel score the proposal must exceed (`get_kernel_threshold()`,
+     * minus infinity if any score is accepted). Once a partial result
+     * bounds the score from above (e.g., with the uniform kernel, the
+     * score is zero once cumulative cases exceed the observed ones by
+     * `get_epsilon()`), the simulation function can call
+     * `reject_proposal(bound)`. If the bound does not exceed the threshold
+     * the proposal is rejected, the call returns `true`, and the
+     * simulation can stop (see `Model::set_stop_fun()`). The statistics of
+     * a rejected proposal are not computed (recorded as NaN), and its
+     * kernel score is recorded as zero.
+     * 
+     * @param score_bound Upper bound of the kernel score of the proposal.
+     */
+    ///@{
+    epiworld_double get_kernel_threshold() const {return m_kernel_threshold;};
+    bool reject_proposal(epiworld_double score_bound);
+    size_t get_n_rejected_early() const {return m_n_rejected_early;};
+    ///@}
+
+    /**
+     * @name Caching summary statistics
+     * 
+     * @details With the cache on, proposals close to parameters simulated
+     * before may reuse (or, with `knn > 0`, interpolate) their summary
+     * statistics instead of running a new simulation (see `LFMCMCCache`).
+     * The cache is emptied at the start of each run, so runs remain
+     * reproducible; chains of `run_chains()` have a cache each. The cache
+     * only keeps statistics: the samples it answers have a default-constructed
+     * `TData` in `get_simulated_data()`.
+     * 
+     * @param resolution Size of the cells by parameter (one value for all
+     * parameters, or one per parameter).
+     * @param max_reuses Times a cell is reused before simulating again.
+     * @param knn Number of neighbors averaged (0 reuses the cell only).
+     * @param window Cells searched around the proposal (with `knn > 0`).
+     */
+    ///@{
+    void set_cache(
+        std::vector< epiworld_double > resolution,
+        size_t max_reuses = 1u,
+        size_t knn = 0u,
+        size_t window = 1u
+        );
+    void cache_off();
+    size_t get_n_cache_hits() const {return m_n_cache_hits;};
+    ///@}
+
     std::vector< epiworld_double > get_mean_params();
     std::vector< epiworld_double > get_mean_stats();
 
+    /**
+     * @brief Potential scale reduction factor (R-hat) of each parameter
+     * 
+     * @details Gelman-Rubin diagnostic computed from the accepted parameters
+     * of each chain after dropping the first `burnin` samples of each.
+     * Values close to one suggest the chains have converged. NaN if there is
+     * only one chain or fewer than two samples per chain.
+     * @param burnin Number of samples to drop from each chain.
+     */
+    std::vector< epiworld_double > get_rhat(size_t burnin = 0u) const;
+
     // Printing
     void print(size_t burnin = 0u) const;
 
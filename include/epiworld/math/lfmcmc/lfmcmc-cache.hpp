@@ -0,0 +1,224 @@
+#ifndef EPIWORLD_LFMCMC_CACHE_HPP
+#define EPIWORLD_LFMCMC_CACHE_HPP
+
+/**
+ * @brief Cache of summary statistics keyed by quantized parameters
+ *
+ * @details The parameter space is divided in cells of size `resolution`
+ * (per parameter). Each cell keeps the parameters and statistics of the last
+ * simulation made in it, and the number of times it was reused since then.
+ *
+ * - With `knn = 0`, a proposal falling in a cell with statistics reuses them
+ *   up to `max_reuses` times; the next proposal is simulated again.
+ * - With `knn > 0`, the statistics are predicted by the mean of the `knn`
+ *   nearest simulations within `window` cells of the proposal (a local
+ *   constant regression). If there are fewer, or the cell of the proposal
+ *   has used up its `max_reuses`, the proposal is simulated.
+ *
+ * The neighbors are found by visiting the `(2 * window + 1)^d` cells around
+ * the proposal, so `window` should stay small with many parameters.
+ */
+class LFMCMCCache {
+private:
+
+    struct Cell {
+        std::vector< epiworld_double > params;
+        std::vector< epiworld_double > stats;   ///< Empty if never simulated
+        size_t n_reused = 0u;
+    };
+
+    bool active = false;
+    std::vector< epiworld_double > resolution;
+    size_t max_reuses = 1u;
+    size_t knn        = 0u;
+    size_t window     = 1u;
+
+    std::map< std::vector< long long int >, Cell > cells;
+
+    std::vector< long long int > key(
+        const std::vector< epiworld_double > & params
+    ) const;
+
+public:
+
+    void set(
+        std::vector< epiworld_double > resolution,
+        size_t max_reuses,
+        size_t knn,
+        size_t window
+    );
+
+    void off() {active = false;};
+    bool is_on() const {return active;};
+    void clear() {cells.clear();};
+    size_t size() const {return cells.size();};
+
+    /**
+     * @brief Statistics of `params` from the cache
+     * @return `true` if `stats` was filled from the cache (counts as a
+     * reuse), `false` if `params` must be simulated.
+     */
+    bool lookup(
+        const std::vector< epiworld_double > & params,
+        std::vector< epiworld_double > & stats
+    );
+
+    /**
+     * @brief Records the statistics of a new simulation
+     */
+    void store(
+        const std::vector< epiworld_double > & params,
+        const std::vector< epiworld_double > & stats
+    );
+
+};
+
+inline void LFMCMCCache::set(
+    std::vector< epiworld_double > resolution_,
+    size_t max_reuses_,
+    size_t knn_,
+    size_t window_
+)
+{
+
+    if (resolution_.size() == 0u)
+        throw std::length_error("-resolution- cannot be empty.");
+
+    for (auto & r : resolution_)
+        if (!(r > 0.0))
+            throw std::range_error("The resolution must be positive.");
+
+    active     = true;
+    resolution = resolution_;
+    max_reuses = max_reuses_;
+    knn        = knn_;
+    window     = window_;
+    cells.clear();
+
+}
+
+inline std::vector< long long int > LFMCMCCache::key(
+    const std::vector< epiworld_double > & params
+) const
+{
+
+    if ((resolution.size() != 1u) && (resolution.size() != params.size()))
+        throw std::length_error(
+            "The resolution of the cache must have one element or one per " +
+            std::string("parameter.")
+            );
+
+    std::vector< long long int > res(params.size());
+    for (size_t k = 0u; k < params.size(); ++k)
+        res[k] = static_cast< long long int >(std::floor(
+            params[k] / resolution[(resolution.size() == 1u) ? 0u : k]
+            ));
+
+    return res;
+
+}
+
+inline bool LFMCMCCache::lookup(
+    const std::vector< epiworld_double > & params,
+    std::vector< epiworld_double > & stats
+)
+{
+
+    auto k = key(params);
+    auto cell = cells.find(k);
+
+    if ((cell != cells.end()) && (cell->second.n_reused >= max_reuses))
+        return false;
+
+    if (knn == 0u)
+    {
+
+        if ((cell == cells.end()) || (cell->second.stats.size() == 0u))
+            return false;
+
+        stats = cell->second.stats;
+        ++cell->second.n_reused;
+        return true;
+
+    }
+
+    // Simulations in the cells around (distances in units of resolution)
+    std::vector< std::pair< epiworld_double, const Cell * > > near;
+    std::vector< long long int > offset(k.size(), -static_cast< long long int >(window));
+    std::vector< long long int > k_i(k.size());
+    long long int w = static_cast< long long int >(window);
+    while (true)
+    {
+
+        for (size_t j = 0u; j < k.size(); ++j)
+            k_i[j] = k[j] + offset[j];
+
+        auto iter = cells.find(k_i);
+        if ((iter != cells.end()) && (iter->second.stats.size() > 0u))
+        {
+
+            epiworld_double d = 0.0;
+            for (size_t j = 0u; j < params.size(); ++j)
+                d += std::pow(
+                    (params[j] - iter->second.params[j]) /
+                    resolution[(resolution.size() == 1u) ? 0u : j],
+                    2.0
+                    );
+
+            near.emplace_back(d, &iter->second);
+
+        }
+
+        // Next offset
+        size_t j = 0u;
+        while ((j < offset.size()) && (offset[j] == w))
+            offset[j++] = -w;
+
+        if (j == offset.size())
+            break;
+
+        ++offset[j];
+
+    }
+
+    if (near.size() < knn)
+        return false;
+
+    std::partial_sort(
+        near.begin(), near.begin() + knn, near.end(),
+        [](
+            const std::pair< epiworld_double, const Cell * > & a,
+            const std::pair< epiworld_double, const Cell * > & b
+        ) {return a.first < b.first;}
+        );
+
+    stats.assign(near[0u].second->stats.size(), 0.0);
+    for (size_t i = 0u; i < knn; ++i)
+        for (size_t j = 0u; j < stats.size(); ++j)
+            stats[j] += near[i].second->stats[j] /
+                static_cast< epiworld_double >(knn);
+
+    // The reuses are counted in the cell of the proposal, even if it was
+    // never simulated (it is added here, and store() fills it later)
+    if (cell == cells.end())
+        cell = cells.emplace(k, Cell()).first;
+
+    ++cell->second.n_reused;
+    return true;
+
+}
+
+inline void LFMCMCCache::store(
+    const std::vector< epiworld_double > & params,
+    const std::vector< epiworld_double > & stats
+)
+{
+
+    Cell & cell = cells[key(params)];
+    cell.params   = params;
+    cell.stats    = stats;
+    cell.n_reused = 0u;
+
+}
+
+#endif
@@ -10,16 +10,18 @@ inline void LFMCMC<TData>::print(size_t burnin) const
     std::vector< epiworld_double > summ_params(m_n_params * 3, 0.0);
     std::vector< epiworld_double > summ_stats(m_n_stats * 3, 0.0);
 
-    // Compute the number of samples to use based on burnin rate
+    // Compute the number of samples to use based on burnin rate (applied
+    // to each chain)
+    size_t n_samples_chain = m_n_samples / m_n_chains;
     size_t n_samples_print = m_n_samples;
     if (burnin > 0)
     {
-        if (burnin >= m_n_samples)
+        if (burnin >= n_samples_chain)
             throw std::length_error(
                 "The burnin is greater than or equal to the number of samples."
                 );
 
-        n_samples_print = m_n_samples - burnin;
+        n_samples_print = m_n_samples - burnin * m_n_chains;
 
     }
 
@@ -32,11 +34,15 @@ inline void LFMCMC<TData>::print(size_t burnin) const
     {
 
         // Retrieving the relevant parameter
-        std::vector< epiworld_double > par_i(n_samples_print);
-        for (size_t i = burnin; i < m_n_samples; ++i)
+        std::vector< epiworld_double > par_i;
+        par_i.reserve(n_samples_print);
+        for (size_t i = 0u; i < m_n_samples; ++i)
         {
-            par_i[i-burnin] = m_accepted_params[i * m_n_params + k];
-            summ_params[k * 3] += par_i[i-burnin]/n_samples_dbl;
+            if ((i % n_samples_chain) < burnin)
+                continue;
+
+            par_i.push_back(m_accepted_params[i * m_n_params + k]);
+            summ_params[k * 3] += par_i.back()/n_samples_dbl;
         }
 
         // Computing the 95% Credible interval
@@ -54,11 +60,15 @@ inline void LFMCMC<TData>::print(size_t burnin) const
     {
 
         // Retrieving the relevant parameter
-        std::vector< epiworld_double > stat_k(n_samples_print);
-        for (size_t i = burnin; i < m_n_samples; ++i)
+        std::vector< epiworld_double > stat_k;
+        stat_k.reserve(n_samples_print);
+        for (size_t i = 0u; i < m_n_samples; ++i)
         {
-            stat_k[i-burnin] = m_accepted_stats[i * m_n_stats + k];
-            summ_stats[k * 3] += stat_k[i-burnin]/n_samples_dbl;
+            if ((i % n_samples_chain) < burnin)
+                continue;
+
+            stat_k.push_back(m_accepted_stats[i * m_n_stats + k]);
+            summ_stats[k * 3] += stat_k.back()/n_samples_dbl;
         }
 
         // Computing the 95% Credible interval
@@ -74,7 +84,11 @@ inline void LFMCMC<TData>::print(size_t burnin) const
     printf_epiworld("LIKELIHOOD-FREE MARKOV CHAIN MONTE CARLO\n\n");
 
     printf_epiworld("N Samples (total) : %zu\n", m_n_samples);
-    printf_epiworld("N Samples (after burn-in period) : %zu\n", m_n_samples - burnin);
+    printf_epiworld("N Samples (after burn-in period) : %zu\n", n_samples_print);
+    if (m_n_chains > 1u)
+    {
+        printf_epiworld("N Chains : %zu\n", m_n_chains);
+    }
 
     std::string abbr;
     epiworld_double elapsed;
@@ -154,6 +168,26 @@ inline void LFMCMC<TData>::print(size_t burnin) const
 
     }    
 
+    if (m_n_chains > 1u)
+    {
+
+        std::vector< epiworld_double > rhat = get_rhat(burnin);
+
+        printf_epiworld("\nPotential scale reduction (R-hat):\n");
+        for (size_t k = 0u; k < m_n_params; ++k)
+        {
+
+            if (m_param_names.size() != 0u)
+            {
+                printf_epiworld("  -%s : %.3f\n", m_param_names[k].c_str(), rhat[k]);
+            } else {
+                printf_epiworld("  [%-2ld]: %.3f\n", k, rhat[k]);
+            }
+
+        }
+
+    }
+
     ////////////////////////////////////////////////////////////////////////////
     // Statistics
     ////////////////////////////////////////////////////////////////////////////
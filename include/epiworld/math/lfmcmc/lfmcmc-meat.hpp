@@ -248,10 +248,22 @@ inline void LFMCMC<TData>::run(
     m_accepted_stats.resize(m_n_samples * m_n_stats);
     m_accepted_kernel_scores.resize(m_n_samples);
 
+    m_n_chains = 1u;
+    m_sample_chain.assign(m_n_samples, m_chain_id);
+    m_n_rejected_early = 0u;
+    m_kernel_threshold = -std::numeric_limits< epiworld_double >::infinity();
+    m_rejected         = false;
+
+    m_n_cache_hits = 0u;
+    m_cache.clear();
+
     TData data_i = m_simulation_fun(m_initial_params, this);
 
     std::vector< epiworld_double > proposed_stats_i;
     m_summary_fun(proposed_stats_i, data_i, this);
+
+    if (m_cache.is_on())
+        m_cache.store(m_initial_params, proposed_stats_i);
     m_accepted_kernel_scores[0u] = m_kernel_fun(
         proposed_stats_i, m_observed_stats, m_epsilon, this
         );
@@ -268,33 +280,81 @@ inline void LFMCMC<TData>::run(
         // Step 1: Generate a proposal and store it in m_current_params
         m_proposal_fun(m_current_params, m_previous_params, this);
 
-        // Step 2: Using m_current_params, simulate data
-        TData data_i = m_simulation_fun(m_current_params, this);
+        // Step 2: Draw the acceptance probability, so the simulation
+        // knows the score it needs (early rejection)
+        epiworld_double r = runif();
+        m_sample_drawn_prob[i] = r;
+        m_rejected         = false;
+        if (m_accepted_kernel_scores[i - 1u] > 0.0)
+            m_kernel_threshold = r * m_accepted_kernel_scores[i - 1u];
+        else
+            m_kernel_threshold = -std::numeric_limits< epiworld_double >::infinity();
+
+        // Step 3: Using m_current_params, simulate data and generate the
+        // summary statistics (unless the cache has them)
+        if (m_cache.is_on() && m_cache.lookup(m_current_params, proposed_stats_i))
+        {
 
-        // Are we storing the data?
-        if (m_simulated_data != nullptr)
-            m_simulated_data->operator[](i) = data_i;
+            ++m_n_cache_hits;
 
-        // Step 3: Generate the summary statistics of the data
-        m_summary_fun(proposed_stats_i, data_i, this);
+            // Nothing was simulated (and the vector may hold a past run)
+            if (m_simulated_data != nullptr)
+                m_simulated_data->operator[](i) = TData();
 
-        // Step 4: Compute the hastings ratio using the kernel function
-        epiworld_double hr = m_kernel_fun(
-            proposed_stats_i, m_observed_stats, m_epsilon, this
-            );
+        }
+        else
+        {
 
-        m_sample_kernel_scores[i] = hr;
+            TData data_i = m_simulation_fun(m_current_params, this);
 
-        // Storing data
-        for (size_t k = 0u; k < m_n_stats; ++k)
-            m_sample_stats[i * m_n_stats + k] = proposed_stats_i[k];
-        
-        // Running Hastings ratio
-        epiworld_double r = runif();
-        m_sample_drawn_prob[i] = r;
+            // Are we storing the data?
+            if (m_simulated_data != nullptr)
+                m_simulated_data->operator[](i) = data_i;
+
+            if (!m_rejected)
+            {
+
+                m_summary_fun(proposed_stats_i, data_i, this);
+
+                if (m_cache.is_on())
+                    m_cache.store(m_current_params, proposed_stats_i);
+
+            }
+
+        }
+
+        bool accept = false;
+        epiworld_double hr = 0.0;
+        if (m_rejected)
+        {
+
+            ++m_n_rejected_early;
+            for (size_t k = 0u; k < m_n_stats; ++k)
+                m_sample_stats[i * m_n_stats + k] =
+                    std::numeric_limits< epiworld_double >::quiet_NaN();
+
+        } else {
+
+            // Step 4: Compute the hastings ratio using the kernel function
+            hr = m_kernel_fun(
+                proposed_stats_i, m_observed_stats, m_epsilon, this
+                );
+
+            // Storing data
+            for (size_t k = 0u; k < m_n_stats; ++k)
+                m_sample_stats[i * m_n_stats + k] = proposed_stats_i[k];
+
+            accept = r < std::min(
+                static_cast<epiworld_double>(1.0),
+                hr / m_accepted_kernel_scores[i - 1u]
+                );
+
+        }
+
+        m_sample_kernel_scores[i] = hr;
 
         // Step 5: Update if likely
-        if (r < std::min(static_cast<epiworld_double>(1.0), hr / m_accepted_kernel_scores[i - 1u]))
+        if (accept)
         {
             m_accepted_kernel_scores[i] = hr;
             m_sample_acceptance[i]     = true;
@@ -326,6 +386,210 @@ inline void LFMCMC<TData>::run(
 
 }
 
+template<typename TData>
+inline void LFMCMC<TData>::clear_samples()
+{
+
+    m_sample_params.clear();
+    m_sample_stats.clear();
+    m_sample_acceptance.clear();
+    m_sample_drawn_prob.clear();
+    m_sample_kernel_scores.clear();
+    m_accepted_params.clear();
+    m_accepted_stats.clear();
+    m_accepted_kernel_scores.clear();
+    m_sample_chain.clear();
+
+}
+
+template<typename TData>
+inline LFMCMC<TData> LFMCMC<TData>::fork(size_t chain_id) const
+{
+
+    LFMCMC<TData> res(*this);
+
+    // Random number generation is not shared
+    res.m_engine = std::make_shared< epiworld_rng_engine >();
+    res.runifd   = std::make_shared< std::uniform_real_distribution<> >(
+        runifd->param()
+        );
+    res.rnormd   = std::make_shared< std::normal_distribution<> >(
+        rnormd->param()
+        );
+    res.rgammad  = std::make_shared< std::gamma_distribution<> >(
+        rgammad->param()
+        );
+
+    res.m_chain_id       = chain_id;
+    res.m_simulated_data = nullptr;
+    res.m_elapsed_time   = std::chrono::duration<epiworld_double,std::micro>::zero();
+
+    return res;
+
+}
+
+template<typename TData>
+inline void LFMCMC<TData>::run_chains(
+    std::vector< epiworld_double > params_init_,
+    size_t n_samples_,
+    epiworld_double epsilon_,
+    size_t n_chains,
+    int seed,
+    int nthreads
+    )
+{
+
+    run_chains(
+        std::vector< std::vector< epiworld_double > >(n_chains, params_init_),
+        n_samples_, epsilon_, seed, nthreads
+        );
+
+}
+
+template<typename TData>
+inline void LFMCMC<TData>::run_chains(
+    std::vector< std::vector< epiworld_double > > params_init_,
+    size_t n_samples_,
+    epiworld_double epsilon_,
+    int seed,
+    #ifdef _OPENMP
+    int nthreads
+    #else
+    int
+    #endif
+    )
+{
+
+    size_t n_chains = params_init_.size();
+    if (n_chains == 0u)
+        throw std::logic_error("At least one chain is needed.");
+
+    for (auto & p : params_init_)
+        if (p.size() != params_init_[0u].size())
+            throw std::length_error(
+                "All chains must have the same number of initial parameters."
+                );
+
+    chrono_start();
+
+    if (seed >= 0)
+        this->seed(seed);
+
+    // One seed per chain, so the results do not depend on the threads
+    std::vector< epiworld_fast_uint > seeds(n_chains);
+    for (auto & s : seeds)
+        s = static_cast< epiworld_fast_uint >(std::floor(
+            runif() * static_cast< epiworld_double >(
+                std::numeric_limits< int >::max()
+                )
+        ));
+
+    // The previous results are not copied to the chains
+    clear_samples();
+
+    std::vector< LFMCMC<TData> > chains;
+    chains.reserve(n_chains);
+    for (size_t k = 0u; k < n_chains; ++k)
+    {
+        chains.push_back(fork(k));
+        chains.back().seed(seeds[k]);
+    }
+
+    std::exception_ptr error = nullptr;
+
+    #ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads) schedule(dynamic, 1)
+    #endif
+    for (int k = 0; k < static_cast< int >(n_chains); ++k)
+    {
+
+        try
+        {
+            chains[k].run(params_init_[k], n_samples_, epsilon_);
+        }
+        catch (...)
+        {
+            #ifdef _OPENMP
+            #pragma omp critical
+            #endif
+            {
+                if (!error)
+                    error = std::current_exception();
+            }
+        }
+
+    }
+
+    if (error)
+        std::rethrow_exception(error);
+
+    // Putting the chains together
+    const LFMCMC<TData> & first = chains[0u];
+    m_n_samples       = n_chains * n_samples_;
+    m_n_params        = first.m_n_params;
+    m_n_stats         = first.m_n_stats;
+    m_epsilon         = epsilon_;
+    m_n_chains        = n_chains;
+    m_initial_params  = first.m_initial_params;
+    m_current_params  = first.m_current_params;
+    m_previous_params = first.m_previous_params;
+    m_observed_stats  = first.m_observed_stats;
+    m_n_rejected_early = 0u;
+    m_n_cache_hits     = 0u;
+
+    for (const auto & chain : chains)
+    {
+
+        #define EPI_LFMCMC_APPEND(x) x.insert(x.end(), chain.x.begin(), chain.x.end());
+        EPI_LFMCMC_APPEND(m_sample_params)
+        EPI_LFMCMC_APPEND(m_sample_stats)
+        EPI_LFMCMC_APPEND(m_sample_acceptance)
+        EPI_LFMCMC_APPEND(m_sample_drawn_prob)
+        EPI_LFMCMC_APPEND(m_sample_kernel_scores)
+        EPI_LFMCMC_APPEND(m_accepted_params)
+        EPI_LFMCMC_APPEND(m_accepted_stats)
+        EPI_LFMCMC_APPEND(m_accepted_kernel_scores)
+        EPI_LFMCMC_APPEND(m_sample_chain)
+        #undef EPI_LFMCMC_APPEND
+
+        m_n_rejected_early += chain.m_n_rejected_early;
+        m_n_cache_hits     += chain.m_n_cache_hits;
+
+    }
+
+    chrono_end();
+
+}
+
+
+template<typename TData>
+inline void LFMCMC<TData>::set_cache(
+    std::vector< epiworld_double > resolution,
+    size_t max_reuses,
+    size_t knn,
+    size_t window
+)
+{
+    m_cache.set(resolution, max_reuses, knn, window);
+}
+
+template<typename TData>
+inline void LFMCMC<TData>::cache_off()
+{
+    m_cache.off();
+    m_cache.clear();
+}
+
+template<typename TData>
+inline bool LFMCMC<TData>::reject_proposal(epiworld_double score_bound)
+{
+
+    if (score_bound <= m_kernel_threshold)
+        m_rejected = true;
+
+    return m_rejected;
+
+}
 
 template<typename TData>
 inline epiworld_double LFMCMC<TData>::runif()
@@ -342,6 +606,12 @@ inline epiworld_double LFMCMC<TData>::runif(
     return runifd->operator()(*m_engine) * (ub - lb) + lb;
 }
 
+template<typename TData>
+inline void LFMCMC<TData>::runif_n(epiworld_double * x, size_t n)
+{
+    runif_fill(*m_engine, *runifd, x, n);
+}
+
 template<typename TData>
 inline epiworld_double LFMCMC<TData>::rnorm()
 {
@@ -387,10 +657,15 @@ inline void LFMCMC<TData>::seed(epiworld_fast_uint s) {
 
     this->m_engine->seed(s);
 
+    // Distributions may keep draws from the previous seed
+    runifd->reset();
+    rnormd->reset();
+    rgammad->reset();
+
 }
 
 template<typename TData>
-inline void LFMCMC<TData>::set_rand_engine(std::shared_ptr< std::mt19937 > & eng)
+inline void LFMCMC<TData>::set_rand_engine(std::shared_ptr< epiworld_rng_engine > & eng)
 {
     m_engine = eng;
 }
@@ -402,7 +677,7 @@ inline void LFMCMC<TData>::set_rand_gamma(epiworld_double alpha, epiworld_double
 }
 
 template<typename TData>
-inline std::shared_ptr< std::mt19937 > & LFMCMC<TData>::get_rand_endgine()
+inline std::shared_ptr< epiworld_rng_engine > & LFMCMC<TData>::get_rand_endgine()
 {
     return m_engine;
 }
@@ -528,6 +803,67 @@ inline std::vector< epiworld_double > LFMCMC<TData>::get_mean_params()
 
 }
 
+template<typename TData>
+inline std::vector< epiworld_double > LFMCMC<TData>::get_rhat(
+    size_t burnin
+) const
+{
+
+    std::vector< epiworld_double > res(
+        m_n_params, std::numeric_limits< epiworld_double >::quiet_NaN()
+        );
+
+    size_t n_chain = (m_n_chains > 0u) ? m_n_samples / m_n_chains : 0u;
+    if ((m_n_chains < 2u) || (n_chain < burnin + 2u))
+        return res;
+
+    epiworld_double n = static_cast< epiworld_double >(n_chain - burnin);
+    epiworld_double m = static_cast< epiworld_double >(m_n_chains);
+
+    std::vector< epiworld_double > means(m_n_chains);
+    for (size_t k = 0u; k < m_n_params; ++k)
+    {
+
+        // Within-chain variance (W) and variance of the chain means (B / n)
+        epiworld_double w = 0.0;
+        for (size_t c = 0u; c < m_n_chains; ++c)
+        {
+
+            const epiworld_double * x =
+                &m_accepted_params[(c * n_chain + burnin) * m_n_params + k];
+
+            epiworld_double mean = 0.0;
+            for (size_t i = 0u; i < n_chain - burnin; ++i)
+                mean += x[i * m_n_params];
+
+            mean /= n;
+
+            epiworld_double var = 0.0;
+            for (size_t i = 0u; i < n_chain - burnin; ++i)
+                var += std::pow(x[i * m_n_params] - mean, 2.0);
+
+            w += var / (n - 1.0) / m;
+            means[c] = mean;
+
+        }
+
+        epiworld_double mean_all = 0.0;
+        for (auto & mean : means)
+            mean_all += mean / m;
+
+        epiworld_double b_n = 0.0;
+        for (auto & mean : means)
+            b_n += std::pow(mean - mean_all, 2.0) / (m - 1.0);
+
+        if (w > 0.0)
+            res[k] = std::sqrt(((n - 1.0) / n * w + b_n) / w);
+
+    }
+
+    return res;
+
+}
+
 template<typename TData>
 inline std::vector< epiworld_double > LFMCMC<TData>::get_mean_stats()
 {
@@ -0,0 +1,355 @@
+#ifndef EPIWORLD_MATH_PHILOX_HPP
+#define EPIWORLD_MATH_PHILOX_HPP
+
+/**
+ * @brief Counter-based random number generator (Philox4x32-10)
+ *
+ * @details Implements the Philox4x32 generator with 10 rounds (Salmon et al.,
+ * 2011, "Parallel random numbers: as easy as 1, 2, 3"). The `n`-th output of
+ * the generator is a function of the key, the stream, and `n` alone, so
+ * streams can be created (or jumped to) in constant time. This makes it
+ * possible to give each (key, stream) pair its own independent sequence,
+ * e.g., one per agent and day, without storing any state.
+ *
+ * The class satisfies the requirements of a `UniformRandomBitGenerator`, so it
+ * can be used with the distributions in `<random>`.
+ */
+class Philox4x32 {
+private:
+
+    std::uint32_t key[2u]     = {0u, 0u};
+    std::uint32_t counter[4u] = {0u, 0u, 0u, 0u};
+    std::uint32_t output[4u]  = {0u, 0u, 0u, 0u};
+    unsigned int idx = 4u; ///< Next element of `output` (4 = none left).
+
+    void generate();
+
+public:
+
+    typedef std::uint32_t result_type;
+
+    static constexpr result_type min() {return 0u;};
+    static constexpr result_type max() {return 0xFFFFFFFFu;};
+
+    Philox4x32() {};
+    Philox4x32(std::uint64_t key_, std::uint64_t stream_ = 0u);
+
+    /**
+     * @brief Sets the key and moves to the beginning of stream 0.
+     */
+    void seed(std::uint64_t key_);
+
+    /**
+     * @brief Moves to the beginning of a stream (keeping the key)
+     */
+    void set_stream(std::uint64_t stream_);
+
+    result_type operator()();
+
+    /**
+     * @brief Fills `out` with the next `n` outputs of the generator
+     *
+     * @details Equivalent to calling `operator()` `n` times, but whole
+     * blocks are generated in batches so the rounds can be vectorized.
+     */
+    void generate_n(std::uint32_t * out, size_t n);
+
+    /**
+     * @brief Fills `out` with `n` draws from U(0, 1)
+     *
+     * @details `float` draws use 24 bits (one output each) and `double` draws
+     * use 53 bits (two outputs each).
+     */
+    ///@{
+    void uniform_n(float * out, size_t n);
+    void uniform_n(double * out, size_t n);
+    ///@}
+
+    void discard(unsigned long long z);
+
+    bool operator==(const Philox4x32 & other) const;
+    bool operator!=(const Philox4x32 & other) const {return !operator==(other);};
+
+};
+
+inline Philox4x32::Philox4x32(std::uint64_t key_, std::uint64_t stream_)
+{
+    seed(key_);
+    set_stream(stream_);
+}
+
+inline void Philox4x32::seed(std::uint64_t key_)
+{
+
+    key[0u] = static_cast< std::uint32_t >(key_);
+    key[1u] = static_cast< std::uint32_t >(key_ >> 32u);
+
+    set_stream(0u);
+
+}
+
+inline void Philox4x32::set_stream(std::uint64_t stream_)
+{
+
+    // The lower half of the counter is the position within the stream
+    counter[0u] = 0u;
+    counter[1u] = 0u;
+    counter[2u] = static_cast< std::uint32_t >(stream_);
+    counter[3u] = static_cast< std::uint32_t >(stream_ >> 32u);
+    idx = 4u;
+
+}
+
+inline void Philox4x32::generate()
+{
+
+    std::uint32_t c0 = counter[0u], c1 = counter[1u],
+                  c2 = counter[2u], c3 = counter[3u];
+    std::uint32_t k0 = key[0u], k1 = key[1u];
+
+    for (int r = 0; r < 10; ++r)
+    {
+
+        std::uint64_t p0 = static_cast< std::uint64_t >(0xD2511F53u) * c0;
+        std::uint64_t p1 = static_cast< std::uint64_t >(0xCD9E8D57u) * c2;
+
+        std::uint32_t hi0 = static_cast< std::uint32_t >(p0 >> 32u);
+        std::uint32_t lo0 = static_cast< std::uint32_t >(p0);
+        std::uint32_t hi1 = static_cast< std::uint32_t >(p1 >> 32u);
+        std::uint32_t lo1 = static_cast< std::uint32_t >(p1);
+
+        c0 = hi1 ^ c1 ^ k0;
+        c1 = lo1;
+        c2 = hi0 ^ c3 ^ k1;
+        c3 = lo0;
+
+        k0 += 0x9E3779B9u;
+        k1 += 0xBB67AE85u;
+
+    }
+
+    output[0u] = c0;
+    output[1u] = c1;
+    output[2u] = c2;
+    output[3u] = c3;
+
+    // Next block
+    if (++counter[0u] == 0u)
+        ++counter[1u];
+
+    idx = 0u;
+
+}
+
+inline Philox4x32::result_type Philox4x32::operator()()
+{
+
+    if (idx == 4u)
+        generate();
+
+    return output[idx++];
+
+}
+
+inline void Philox4x32::generate_n(std::uint32_t * out, size_t n)
+{
+
+    // Using what is left in the current block
+    while ((n > 0u) && (idx < 4u))
+    {
+        *out++ = output[idx++];
+        --n;
+    }
+
+    // Whole blocks, `nbatch` at a time. The counters of a batch are
+    // consecutive, so each round is the same operation over `nbatch` lanes.
+    static const size_t nbatch = 16u;
+    std::uint32_t c0[nbatch], c1[nbatch], c2[nbatch], c3[nbatch];
+
+    while (n >= 4u)
+    {
+
+        size_t nb = std::min(nbatch, n / 4u);
+
+        std::uint64_t pos = (static_cast< std::uint64_t >(counter[1u]) << 32u) |
+            counter[0u];
+
+        for (size_t b = 0u; b < nb; ++b)
+        {
+            c0[b] = static_cast< std::uint32_t >(pos + b);
+            c1[b] = static_cast< std::uint32_t >((pos + b) >> 32u);
+            c2[b] = counter[2u];
+            c3[b] = counter[3u];
+        }
+
+        std::uint32_t k0 = key[0u], k1 = key[1u];
+        for (int r = 0; r < 10; ++r)
+        {
+
+            for (size_t b = 0u; b < nb; ++b)
+            {
+
+                std::uint64_t p0 = static_cast< std::uint64_t >(0xD2511F53u) * c0[b];
+                std::uint64_t p1 = static_cast< std::uint64_t >(0xCD9E8D57u) * c2[b];
+
+                c0[b] = static_cast< std::uint32_t >(p1 >> 32u) ^ c1[b] ^ k0;
+                c1[b] = static_cast< std::uint32_t >(p1);
+                c2[b] = static_cast< std::uint32_t >(p0 >> 32u) ^ c3[b] ^ k1;
+                c3[b] = static_cast< std::uint32_t >(p0);
+
+            }
+
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+
+        }
+
+        for (size_t b = 0u; b < nb; ++b)
+        {
+            *out++ = c0[b];
+            *out++ = c1[b];
+            *out++ = c2[b];
+            *out++ = c3[b];
+        }
+
+        pos += nb;
+        counter[0u] = static_cast< std::uint32_t >(pos);
+        counter[1u] = static_cast< std::uint32_t >(pos >> 32u);
+        n -= 4u * nb;
+
+    }
+
+    // Whatever is left comes from a new block
+    while (n-- > 0u)
+        *out++ = operator()();
+
+}
+
+inline void Philox4x32::uniform_n(float * out, size_t n)
+{
+
+    std::uint32_t bits[256u];
+    while (n > 0u)
+    {
+
+        size_t k = std::min(n, static_cast< size_t >(256u));
+        generate_n(&bits[0u], k);
+
+        for (size_t i = 0u; i < k; ++i)
+            out[i] = static_cast< float >(bits[i] >> 8u) *
+                (1.0f / 16777216.0f);
+
+        out += k;
+        n   -= k;
+
+    }
+
+}
+
+inline void Philox4x32::uniform_n(double * out, size_t n)
+{
+
+    std::uint32_t bits[256u];
+    while (n > 0u)
+    {
+
+        size_t k = std::min(n, static_cast< size_t >(128u));
+        generate_n(&bits[0u], 2u * k);
+
+        for (size_t i = 0u; i < k; ++i)
+        {
+            std::uint64_t x =
+                (static_cast< std::uint64_t >(bits[2u * i] >> 5u) << 26u) |
+                (bits[2u * i + 1u] >> 6u);
+
+            out[i] = static_cast< double >(x) * (1.0 / 9007199254740992.0);
+        }
+
+        out += k;
+        n   -= k;
+
+    }
+
+}
+
+inline void Philox4x32::discard(unsigned long long z)
+{
+
+    // Using what is left in the current block
+    while ((z > 0u) && (idx < 4u))
+    {
+        ++idx;
+        --z;
+    }
+
+    if (z == 0u)
+        return;
+
+    // Jumping over whole blocks
+    std::uint64_t pos = (static_cast< std::uint64_t >(counter[1u]) << 32u) |
+        counter[0u];
+
+    pos += (z - 1u) / 4u;
+    counter[0u] = static_cast< std::uint32_t >(pos);
+    counter[1u] = static_cast< std::uint32_t >(pos >> 32u);
+
+    generate();
+    idx = static_cast< unsigned int >((z - 1u) % 4u) + 1u;
+
+}
+
+inline bool Philox4x32::operator==(const Philox4x32 & other) const
+{
+
+    for (size_t i = 0u; i < 2u; ++i)
+        if (key[i] != other.key[i])
+            return false;
+
+    for (size_t i = 0u; i < 4u; ++i)
+        if (counter[i] != other.counter[i])
+            return false;
+
+    if (idx != other.idx)
+        return false;
+
+    for (size_t i = idx; i < 4u; ++i)
+        if (output[i] != other.output[i])
+            return false;
+
+    return true;
+
+}
+
+/**
+ * @brief Fills `out` with `n` draws from a uniform distribution
+ *
+ * @details The generic version calls `dist(engine)` `n` times. The
+ * overload for `Philox4x32` generates the draws in batches, so the values
+ * differ from calling `dist` (but follow the same distribution).
+ */
+///@{
+template<typename TEngine, typename TDist, typename TReal>
+inline void runif_fill(TEngine & engine, TDist & dist, TReal * out, size_t n)
+{
+
+    for (size_t i = 0u; i < n; ++i)
+        out[i] = static_cast< TReal >(dist(engine));
+
+}
+
+template<typename TDist, typename TReal>
+inline void runif_fill(Philox4x32 & engine, TDist & dist, TReal * out, size_t n)
+{
+
+    engine.uniform_n(out, n);
+
+    TReal a = static_cast< TReal >(dist.a());
+    TReal b = static_cast< TReal >(dist.b());
+    if ((a != 0) || (b != 1))
+        for (size_t i = 0u; i < n; ++i)
+            out[i] = a + out[i] * (b - a);
+
+}
+///@}
+
+#endif
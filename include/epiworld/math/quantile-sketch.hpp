@@ -0,0 +1,213 @@
+#ifndef EPIWORLD_MATH_QUANTILE_SKETCH_HPP
+#define EPIWORLD_MATH_QUANTILE_SKETCH_HPP
+
+/**
+ * @brief Approximate quantiles of a stream of non-negative values
+ *
+ * @details Values are counted in buckets whose width grows geometrically
+ * (Masson et al., 2019, "DDSketch: a fast and fully-mergeable quantile
+ * sketch with relative-error guarantees"), so any quantile is returned
+ * within a relative error of `alpha`. Integers below `1/alpha` (e.g., small
+ * case counts) are counted exactly.
+ *
+ * The memory used grows with the logarithm of the range of the values, not
+ * with the number of values. Since only counts are stored, the result does
+ * not depend on the order in which values are added or sketches are merged.
+ */
+class QuantileSketch {
+private:
+
+    epiworld_double gamma_log;
+    size_t exact_max;             ///< Integers below this are counted exactly.
+    std::vector< size_t > exact;  ///< Counts of 0, 1, ... (grows as needed).
+    std::vector< size_t > bins;   ///< Counts of the buckets offset, offset + 1, ...
+    int offset = 0;
+    size_t n = 0u;
+
+    int index(epiworld_double x) const;
+    epiworld_double value(int i) const;
+
+public:
+
+    QuantileSketch(epiworld_double alpha = 0.01);
+
+    void add(epiworld_double x, size_t w = 1u);
+    void merge(const QuantileSketch & other);
+
+    /**
+     * @brief Value at quantile `q` (in [0, 1]). `NaN` if the sketch is empty.
+     */
+    epiworld_double quantile(epiworld_double q) const;
+
+    size_t size() const {return n;};
+
+};
+
+inline QuantileSketch::QuantileSketch(epiworld_double alpha)
+{
+
+    if ((alpha <= 0.0) || (alpha >= 1.0))
+        throw std::range_error(
+            "The relative accuracy -alpha- must be in (0, 1)."
+            );
+
+    gamma_log = std::log((1.0 + alpha) / (1.0 - alpha));
+    exact_max = static_cast< size_t >(std::ceil(1.0 / alpha));
+
+}
+
+inline int QuantileSketch::index(epiworld_double x) const
+{
+    return static_cast< int >(std::ceil(std::log(x) / gamma_log));
+}
+
+inline epiworld_double QuantileSketch::value(int i) const
+{
+
+    // Midpoint (in relative terms) of the bucket (gamma^(i-1), gamma^i]
+    epiworld_double gamma = std::exp(gamma_log);
+    return 2.0 * std::exp(gamma_log * i) / (gamma + 1.0);
+
+}
+
+inline void QuantileSketch::add(epiworld_double x, size_t w)
+{
+
+    if (!(x >= 0.0))
+        throw std::range_error(
+            "QuantileSketch only takes non-negative values (got " +
+            std::to_string(x) + ")."
+            );
+
+    n += w;
+
+    if ((x < static_cast< epiworld_double >(exact_max)) &&
+        (x == std::floor(x)))
+    {
+
+        size_t k = static_cast< size_t >(x);
+        if (k >= exact.size())
+            exact.resize(k + 1u, 0u);
+
+        exact[k] += w;
+        return;
+
+    }
+
+    int i = index(x);
+
+    if (bins.size() == 0u)
+    {
+        offset = i;
+        bins.assign(1u, w);
+        return;
+    }
+
+    if (i < offset)
+    {
+        bins.insert(bins.begin(), static_cast< size_t >(offset - i), 0u);
+        offset = i;
+    }
+    else if (i >= offset + static_cast< int >(bins.size()))
+        bins.resize(static_cast< size_t >(i - offset) + 1u, 0u);
+
+    bins[i - offset] += w;
+
+}
+
+inline void QuantileSketch::merge(const QuantileSketch & other)
+{
+
+    if ((other.gamma_log != gamma_log) || (other.exact_max != exact_max))
+        throw std::logic_error(
+            "Only sketches with the same accuracy can be merged."
+            );
+
+    if (other.exact.size() > exact.size())
+        exact.resize(other.exact.size(), 0u);
+
+    for (size_t i = 0u; i < other.exact.size(); ++i)
+        exact[i] += other.exact[i];
+
+    if (other.bins.size() > 0u)
+    {
+
+        if (bins.size() == 0u)
+        {
+            bins   = other.bins;
+            offset = other.offset;
+        }
+        else
+        {
+
+            int lo = std::min(offset, other.offset);
+            int hi = std::max(
+                offset + static_cast< int >(bins.size()),
+                other.offset + static_cast< int >(other.bins.size())
+                );
+
+            std::vector< size_t > res(static_cast< size_t >(hi - lo), 0u);
+            for (size_t i = 0u; i < bins.size(); ++i)
+                res[offset - lo + i] += bins[i];
+
+            for (size_t i = 0u; i < other.bins.size(); ++i)
+                res[other.offset - lo + i] += other.bins[i];
+
+            bins.swap(res);
+            offset = lo;
+
+        }
+
+    }
+
+    n += other.n;
+
+}
+
+inline epiworld_double QuantileSketch::quantile(epiworld_double q) const
+{
+
+    if (n == 0u)
+        return std::numeric_limits< epiworld_double >::quiet_NaN();
+
+    if ((q < 0.0) || (q > 1.0))
+        throw std::range_error("The quantile -q- must be in [0, 1].");
+
+    // Position of the quantile in the sorted values
+    size_t rank = static_cast< size_t >(
+        std::floor(q * static_cast< epiworld_double >(n - 1u))
+        );
+
+    // Exact values and buckets are visited in increasing order
+    size_t cumsum = 0u;
+    size_t i = 0u, j = 0u;
+    while ((i < exact.size()) || (j < bins.size()))
+    {
+
+        bool take_exact = (j == bins.size()) || ((i < exact.size()) &&
+            (static_cast< epiworld_double >(i) <= value(offset + static_cast< int >(j))));
+
+        if (take_exact)
+        {
+            cumsum += exact[i];
+            if (cumsum > rank)
+                return static_cast< epiworld_double >(i);
+
+            ++i;
+        }
+        else
+        {
+            cumsum += bins[j];
+            if (cumsum > rank)
+                return value(offset + static_cast< int >(j));
+
+            ++j;
+        }
+
+    }
+
+    return std::numeric_limits< epiworld_double >::quiet_NaN();
+
+}
+
+#endif
@@ -119,6 +119,13 @@ inline bool IN(const Ta & a, const std::vector< Ta > & b) noexcept
  * weighted fashion. The probabilities are drawn given that either one or none
  * of the cases is drawn; in the latter returns -1.
  * 
+ * Since \f$P(\mbox{only } i)/P(\mbox{none}) = p_i/(1 - p_i)\f$, the
+ * roulette is computed on the odds of each entry normalized by the
+ * probability of none. This avoids computing \f$\prod_i (1 - p_i)\f$
+ * (which underflows for a large number of entries) and only requires a single
+ * pass over the data plus the final scan. Entries with probability one are
+ * sampled uniformly. No memory is allocated.
+ * 
  * @param probs Vector of probabilities.
  * @param m A `Model`. This is used to draw random uniform numbers.
  * @return int If -1 then it means that none got sampled, otherwise the index
@@ -131,52 +138,62 @@ inline int roulette(
     )
 {
 
-    // Step 1: Computing the prob on none 
-    TDbl p_none = 1.0;
-    std::vector< int > certain_infection;
-    certain_infection.reserve(probs.size());
-
+    // Step 1: Computing the odds of "only p" vs "none"
+    TDbl odds_sum = 0.0;
+    epiworld_fast_uint ncertain = 0u;
     for (epiworld_fast_uint p = 0u; p < probs.size(); ++p)
     {
-        p_none *= (1.0 - probs[p]);
 
-        if (probs[p] > (1 - 1e-100))
-            certain_infection.push_back(p);
-        
+        if (probs[p] >= 1.0)
+        {
+            ++ncertain;
+            continue;
+        }
+
+        odds_sum += probs[p] / (1.0 - probs[p]);
+
     }
 
     TDbl r = static_cast<TDbl>(m->runif());
+
     // If there are one or more probs that go close to 1, sample
     // uniformly
-    if (certain_infection.size() > 0)
-        return certain_infection[std::floor(r * certain_infection.size())];
-
-    // Step 2: Calculating the prob of none or single
-    std::vector< TDbl > probs_only_p(probs.size());
-    TDbl p_none_or_single = p_none;
-    for (epiworld_fast_uint p = 0u; p < probs.size(); ++p)
+    if (ncertain > 0u)
     {
-        probs_only_p[p] = probs[p] * (p_none / (1.0 - probs[p]));
-        p_none_or_single += probs_only_p[p];
+        epiworld_fast_uint k = static_cast< epiworld_fast_uint >(
+            std::floor(r * ncertain)
+        );
+
+        if (k >= ncertain)
+            k = ncertain - 1u;
+
+        for (epiworld_fast_uint p = 0u; p < probs.size(); ++p)
+        {
+            if (probs[p] < 1.0)
+                continue;
+
+            if (k-- == 0u)
+                return static_cast<int>(p);
+        }
+
     }
 
-    // Step 3: Roulette
-    TDbl cumsum = p_none/p_none_or_single;
-    if (r < cumsum)
-    {
+    // Step 2: Roulette over [none, only 0, only 1, ...] scaled by
+    // 1/P(none)
+    TDbl target = r * (1.0 + odds_sum);
+    TDbl cumsum = 1.0;
+    if (target < cumsum)
         return -1;
-    }
 
     for (epiworld_fast_uint p = 0u; p < probs.size(); ++p)
     {
         // If it yield here, then bingo, the individual will acquire the disease
-        cumsum += probs_only_p[p]/(p_none_or_single);
-        if (r < cumsum)
+        cumsum += probs[p] / (1.0 - probs[p]);
+        if (target < cumsum)
             return static_cast<int>(p);
         
     }
 
-
     #ifdef EPI_DEBUG
     printf_epiworld("[epi-debug] roulette::cumsum = %.4f\n", cumsum);
     #endif
@@ -197,7 +214,20 @@ inline int roulette(std::vector< float > & probs, Model<TSeq> * m)
     return roulette<TSeq, float>(probs, m);
 }
 
-
+/**
+ * @brief Conditional Weighted Sampling using the model's scratch space
+ * 
+ * @details
+ * Same as the vector version, but the probabilities are read from the first
+ * `nelements` entries of `Model::get_array_double_tmp()`. The entries in
+ * `[nelements, 2 * nelements)` are used as scratch space to store the odds,
+ * so there is no heap allocation nor recomputation in the final scan.
+ * 
+ * @param nelements Number of probabilities stored in `m->get_array_double_tmp()`.
+ * @param m A `Model`.
+ * @return int If -1 then none got sampled, otherwise the index of the entry
+ * that got drawn.
+ */
 template<typename TSeq>
 inline int roulette(
     epiworld_fast_uint nelements,
@@ -205,55 +235,72 @@ inline int roulette(
     )
 {
 
-    if ((nelements * 2) > m->array_double_tmp.size())
+    if ((nelements * 2) > m->get_array_double_tmp().size())
     {
         throw std::logic_error(
             "Trying to sample from more data than there is in roulette!" +
             std::to_string(nelements) + " vs " + 
-            std::to_string(m->array_double_tmp.size())
+            std::to_string(m->get_array_double_tmp().size())
             );
     }
 
-    // Step 1: Computing the prob on none 
-    epiworld_double p_none = 1.0;
+    const epiworld_double * probs = m->get_array_double_tmp().data();
+    epiworld_double * odds = m->get_array_double_tmp().data() + nelements;
+
+    // Step 1: Computing the odds of "only p" vs "none" (single pass)
+    epiworld_double odds_sum = 0.0;
     epiworld_fast_uint ncertain = 0u;
-    // std::vector< int > certain_infection;
     for (epiworld_fast_uint p = 0u; p < nelements; ++p)
     {
-        p_none *= (1.0 - m->array_double_tmp[p]);
 
-        if (m->array_double_tmp[p] > (1 - 1e-100))
-            m->array_double_tmp[nelements + ncertain++] = p;
-            // certain_infection.push_back(p);
+        if (probs[p] >= 1.0)
+        {
+            odds[p] = 0.0;
+            ++ncertain;
+            continue;
+        }
+
+        odds[p] = probs[p] / (1.0 - probs[p]);
+        odds_sum += odds[p];
         
     }
 
     epiworld_double r = m->runif();
+
     // If there are one or more probs that go close to 1, sample
     // uniformly
     if (ncertain > 0u)
-        return m->array_double_tmp[nelements + std::floor(ncertain * r)]; //    certain_infection[std::floor(r * certain_infection.size())];
-
-    // Step 2: Calculating the prob of none or single
-    // std::vector< epiworld_double > probs_only_p;
-    epiworld_double p_none_or_single = p_none;
-    for (epiworld_fast_uint p = 0u; p < nelements; ++p)
     {
-        m->array_double_tmp[nelements + p] = 
-            m->array_double_tmp[p] * (p_none / (1.0 - m->array_double_tmp[p]));
-        p_none_or_single += m->array_double_tmp[nelements + p];
+        epiworld_fast_uint k = static_cast< epiworld_fast_uint >(
+            std::floor(r * ncertain)
+        );
+
+        if (k >= ncertain)
+            k = ncertain - 1u;
+
+        for (epiworld_fast_uint p = 0u; p < nelements; ++p)
+        {
+            if (probs[p] < 1.0)
+                continue;
+
+            if (k-- == 0u)
+                return static_cast<int>(p);
+        }
+
     }
 
-    // Step 3: Roulette
-    epiworld_double cumsum = p_none/p_none_or_single;
-    if (r < cumsum)
+    // Step 2: Roulette over [none, only 0, only 1, ...] scaled by
+    // 1/P(none)
+    epiworld_double target = r * (1.0 + odds_sum);
+    epiworld_double cumsum = 1.0;
+    if (target < cumsum)
         return -1;
 
     for (epiworld_fast_uint p = 0u; p < nelements; ++p)
     {
         // If it yield here, then bingo, the individual will acquire the disease
-        cumsum += m->array_double_tmp[nelements + p]/(p_none_or_single);
-        if (r < cumsum)
+        cumsum += odds[p];
+        if (target < cumsum)
             return static_cast<int>(p);
         
     }
@@ -27,6 +27,12 @@ class DataBase;
 template<typename TSeq>
 class Queue;
 
+template<typename TSeq>
+class StateSets;
+
+template<typename TSeq>
+class StateTimers;
+
 template<typename TSeq>
 struct Event;
 
@@ -69,7 +75,9 @@ inline std::function<void(size_t,Model<TSeq>*)> make_save_run(
     bool transmission = false,
     bool transition = false,
     bool reproductive = false,
-    bool generation = false
+    bool generation = false,
+    bool binary = false,
+    std::shared_ptr< DataWriter > writer = nullptr
     );
 
 // template<typename TSeq>
@@ -93,6 +101,7 @@ class Model {
     friend class AgentsSample<TSeq>;
     friend class DataBase<TSeq>;
     friend class Queue<TSeq>;
+    friend class StateSets<TSeq>;
 protected:
 
     std::string name = ""; ///< Name of the model
@@ -102,7 +111,6 @@ protected:
     std::vector< Agent<TSeq> > population = {};
 
     bool using_backup = true;
-    std::vector< Agent<TSeq> > population_backup = {};
 
     /**
      * @name Auxiliary variables for AgentsSample<TSeq> iterators
@@ -133,6 +141,51 @@ protected:
     ///@}
 
     bool directed = false;
+
+    /**
+     * @name Compressed Sparse Row (CSR) network
+     * 
+     * @details When `use_network_csr` is true, the ties are stored in
+     * `network_csr` instead of the agents' neighbor lists. The backup is
+     * only kept if the network is rewired during the simulation.
+     */
+    ///@{
+    bool use_network_csr = false;
+    NetworkCSR network_csr;
+
+    /** Copies (or moves) the agents' neighbor lists into a CSR network. */
+    NetworkCSR network_csr_from_agents(
+        std::vector< Agent<TSeq> > & agents,
+        bool clear = true
+        );
+
+    /** Moves the ties of a CSR network into the agents' neighbor lists. */
+    void network_csr_to_agents(
+        NetworkCSR & net,
+        std::vector< Agent<TSeq> > & agents
+        );
+    ///@}
+
+    /**
+     * @name Backup of the network
+     * 
+     * @details Since `Agent::reset()` clears all the mutable state of the
+     * agents (state, virus, tools, and entities), the only part of the
+     * population that needs to be restored between replicates is the
+     * network, and only if it was modified (e.g., rewired). After
+     * `set_backup()`, the ties are saved (in CSR format) right before they
+     * are first modified, and `reset()` restores them only if they were
+     * modified since the last restore.
+     */
+    ///@{
+    bool network_backup_on       = false; ///< `set_backup()` was called.
+    bool network_backup_taken    = false; ///< The snapshot was taken.
+    bool network_backup_modified = false; ///< Ties changed since the last restore.
+    NetworkCSR network_backup;
+
+    /** Called before modifying the ties (takes the snapshot if needed). */
+    void network_backup_touch();
+    ///@}
     
     std::vector< VirusPtr<TSeq> > viruses = {};
     std::vector< ToolPtr<TSeq> > tools = {};
@@ -140,7 +193,7 @@ protected:
     std::vector< Entity<TSeq> > entities = {}; 
     std::vector< Entity<TSeq> > entities_backup = {};
 
-    std::shared_ptr< std::mt19937 > engine = std::make_shared< std::mt19937 >();
+    std::shared_ptr< epiworld_rng_engine > engine = std::make_shared< epiworld_rng_engine >();
     
     std::uniform_real_distribution<> runifd      =
         std::uniform_real_distribution<> (0.0, 1.0);
@@ -157,8 +210,22 @@ protected:
 
     std::function<void(std::vector<Agent<TSeq>>*,Model<TSeq>*,epiworld_double)> rewire_fun;
     epiworld_double rewire_prop = 0.0;
+
+    StopFun<TSeq> stop_fun;     ///< Checked at the end of each day
+    bool stopped_early = false; ///< The last run was stopped by `stop_fun`
         
-    std::map<std::string, epiworld_double > parameters;
+    /**
+     * @name Parameters of the model
+     * 
+     * @details Values are stored in the order in which they were added.
+     * `parameters_index` maps names to positions in `parameters` (see
+     * `ParamHandle`). Adding parameters may move the values, so positions
+     * (not addresses) identify them.
+     */
+    ///@{
+    std::vector< epiworld_double > parameters;
+    std::map< std::string, size_t > parameters_index;
+    ///@}
     epiworld_fast_uint ndays = 0;
     Progress pb;
 
@@ -185,6 +252,16 @@ protected:
     std::chrono::duration<epiworld_double,std::micro> time_elapsed = 
         std::chrono::duration<epiworld_double,std::micro>::zero();
     epiworld_fast_uint n_replicates = 0u;
+
+    /**
+     * @name Per-thread statistics of the last call to `run_multiple()`
+     */
+    ///@{
+    std::vector< size_t > run_multiple_nreplicates = {}; ///< Replicates run by each thread.
+    std::vector< epiworld_double > run_multiple_busy = {}; ///< Seconds each thread spent running replicates.
+    epiworld_double run_multiple_elapsed = 0.0; ///< Wall time (seconds).
+    ///@}
+
     void chrono_start();
     void chrono_end();
 
@@ -193,6 +270,9 @@ protected:
     Queue<TSeq> queue;
     bool use_queuing   = true;
 
+    StateSets<TSeq> state_sets; ///< See `track_state()`
+    StateTimers<TSeq> state_timers; ///< See `set_state_timer()`
+
     /**
      * @brief Variables used to keep track of the events
      * to be made regarding viruses.
@@ -200,6 +280,40 @@ protected:
     std::vector< Event<TSeq> > events = {};
     epiworld_fast_uint nactions = 0u;
 
+    /**
+     * @name Parallel update of the agents' states
+     * 
+     * @details While `parallel_update_running` is `true`, the random number
+     * generation functions (`runif()`, `rbinom()`, etc.), the scratch arrays
+     * (`get_array_double_tmp()`, etc.), and `events_add()` use the context
+     * of the calling thread. See `parallel_update_on()`.
+     */
+    ///@{
+    struct UpdateThread {
+        Philox4x32 engine;
+        std::uniform_real_distribution<> runifd;
+        std::normal_distribution<>       rnormd;
+        std::gamma_distribution<>        rgammad;
+        std::lognormal_distribution<>    rlognormald;
+        std::exponential_distribution<>  rexpd;
+        std::binomial_distribution<>     rbinomd;
+        std::vector< epiworld_double > array_double_tmp;
+        std::vector< Virus<TSeq> * > array_virus_tmp;
+        std::vector< int > array_int_tmp;
+        std::vector< Event<TSeq> > events;
+        epiworld_fast_uint nactions = 0u;
+    };
+
+    bool parallel_update          = false;
+    int parallel_update_nthreads  = 1;
+    bool parallel_update_running  = false;
+    std::uint32_t parallel_update_key = 0u; ///< Drawn at the start of each run.
+    std::vector< UpdateThread > update_threads = {};
+
+    UpdateThread & update_thread(); ///< Context of the calling thread.
+    void update_state_parallel();
+    ///@}
+
     /**
      * @brief Construct a new Event object
      * 
@@ -253,6 +367,19 @@ public:
     std::vector<Virus<TSeq> * > array_virus_tmp;
     std::vector< int > array_int_tmp;
 
+    /**
+     * @name Scratch arrays for update functions
+     * 
+     * @details Same as the `array_*_tmp` members, except that during a
+     * parallel update (see `parallel_update_on()`) each thread gets its own
+     * arrays. Update functions that may run in parallel should use these.
+     */
+    ///@{
+    std::vector< epiworld_double > & get_array_double_tmp();
+    std::vector< Virus<TSeq> * > & get_array_virus_tmp();
+    std::vector< int > & get_array_int_tmp();
+    ///@}
+
     Model();
     Model(const Model<TSeq> & m);
     Model(Model<TSeq> & m);
@@ -276,6 +403,7 @@ public:
     DataBase<TSeq> & get_db();
     const DataBase<TSeq> & get_db() const;
     epiworld_double & operator()(std::string pname);
+    epiworld_double & operator()(ParamHandle handle);
 
     size_t size() const;
 
@@ -286,8 +414,8 @@ public:
      * @param s Seed
      */
     ///@{
-    void set_rand_engine(std::shared_ptr< std::mt19937 > & eng);
-    std::shared_ptr< std::mt19937 > & get_rand_endgine();
+    void set_rand_engine(std::shared_ptr< epiworld_rng_engine > & eng);
+    std::shared_ptr< epiworld_rng_engine > & get_rand_endgine();
     void seed(size_t s);
     void set_rand_norm(epiworld_double mean, epiworld_double sd);
     void set_rand_unif(epiworld_double a, epiworld_double b);
@@ -297,6 +425,7 @@ public:
     void set_rand_binom(int n, epiworld_double p);
     epiworld_double runif();
     epiworld_double runif(epiworld_double a, epiworld_double b);
+    void runif_n(epiworld_double * x, size_t n); ///< `n` draws of `runif()`.
     epiworld_double rnorm();
     epiworld_double rnorm(epiworld_double mean, epiworld_double sd);
     epiworld_double rgamma();
@@ -307,6 +436,8 @@ public:
     epiworld_double rlognormal(epiworld_double mean, epiworld_double shape);
     int rbinom();
     int rbinom(int n, epiworld_double p);
+    int rbinom(const std::binomial_distribution<>::param_type & par); ///< Reuses precomputed parameters.
+    int rgeom(epiworld_double p); ///< Number of daily trials until the first success.
     ///@}
 
     /**
@@ -360,9 +491,16 @@ public:
      * 
      * @param fn std::string Filename of the edgelist file.
      * @param skip int Number of lines to skip in `fn`.
-     * @param directed bool Whether the graph is directed or not.
+     * @param directed bool Whether the graph is directed or not (ties are
+     * stored in both directions either way).
      * @param size Size of the network.
      * @param al AdjList to read into the model.
+     * 
+     * @details `agents_from_adjlist(fn, ...)` parses the file with
+     * `read_edgelist_text()` and `agents_from_binary_edgelist()` reads a file
+     * written by `write_edgelist_binary()` (the size and whether the network
+     * is directed come from the file). Both build the network from the
+     * edgelist without going through an `AdjList`.
      */
     ///@{
     void agents_from_adjlist(
@@ -379,6 +517,8 @@ public:
         bool directed
     );
 
+    void agents_from_binary_edgelist(std::string fn);
+
     void agents_from_adjlist(AdjList al);
 
     bool is_directed() const;
@@ -432,6 +572,23 @@ public:
         bool verbose = true,
         int nthreads = 1
         );
+
+    /**
+     * @brief Per-thread statistics of the last call to `run_multiple()`
+     * 
+     * @details Replicates are handed out to the threads on demand, so the
+     * number of replicates run by each thread varies across calls. The
+     * utilization of a thread is the proportion of the wall time of
+     * `run_multiple()` it spent running replicates (including `fun`).
+     * 
+     * @param nreplicates If not `nullptr`, number of replicates run by each
+     * thread.
+     * @param utilization If not `nullptr`, utilization of each thread.
+     */
+    void get_run_multiple_stats(
+        std::vector< size_t > * nreplicates,
+        std::vector< epiworld_double > * utilization
+    ) const;
     ///@}
 
     size_t get_n_viruses() const; ///< Number of viruses in the model
@@ -462,6 +619,23 @@ public:
     void rewire();
     ///@}
 
+    /**
+     * @brief Stops runs before the last day
+     * 
+     * @details `fun` is called at the end of each day, after the day is
+     * recorded in the database (`today()` is that day). If it returns
+     * `true`, the run stops there and `get_stopped_early()` returns
+     * `true`. For instance, a likelihood-free calibration can abort
+     * simulations whose cumulative cases already rule them out (see
+     * `LFMCMC::reject_proposal()`).
+     * 
+     * @param fun Stop predicate (an empty function never stops).
+     */
+    ///@{
+    void set_stop_fun(StopFun<TSeq> fun);
+    bool get_stopped_early() const;
+    ///@}
+
     /**
      * @brief Wrapper of `DataBase::write_data`
      * 
@@ -473,6 +647,11 @@ public:
      * @param fn_transmission Filename. Transmission history.
      * @param fn_transition   Filename. Markov transition history.
      * @param fn_reproductive_number Filename. Case by case reproductive number
+     * @param fn_generation_time Filename. Generation time.
+     * @param binary If `true`, files are written in the binary format of
+     * `DataTable`.
+     * @param writer If not `nullptr`, files are written in the background
+     * by `writer`.
      */
     void write_data(
         std::string fn_virus_info,
@@ -483,7 +662,9 @@ public:
         std::string fn_transmission,
         std::string fn_transition,
         std::string fn_reproductive_number,
-        std::string fn_generation_time
+        std::string fn_generation_time,
+        bool binary = false,
+        DataWriter * writer = nullptr
         ) const;
 
     /**
@@ -507,8 +688,6 @@ public:
         ) const;
     ///@}
 
-    std::map<std::string, epiworld_double> & params();
-
     /**
      * @brief Reset the model
      * 
@@ -561,12 +740,21 @@ public:
      * @name Setting and accessing parameters from the model
      * 
      * @details Tools can incorporate parameters included in the model.
-     * Internally, parameters in the tool are stored as pointers to
-     * an std::map<> of parameters in the model. Using the `epiworld_fast_uint`
-     * method directly fetches the parameters in the order these were
-     * added to the tool. Accessing parameters via the `std::string` method
-     * involves searching the parameter directly in the std::map<> member
-     * of the model (so it is not recommended.)
+     * Internally, parameters are stored in the order these were added to
+     * the model. Using the `epiworld_fast_uint`
+     * method directly fetches the parameters in that order. Accessing
+     * parameters via the `std::string` method involves searching the
+     * parameter by name (so it is not recommended in functions called for
+     * each agent or each day.) Instead, resolve a `ParamHandle` once with
+     * `get_param_handle()` and use `par(ParamHandle)`, which costs an
+     * indexed load.
+     * 
+     * Pointers to parameters (e.g., `&model("name")`, as passed to the
+     * pointer-based setters of `Virus` and `Tool`) are invalidated when new
+     * parameters are added to the model. Handles remain valid.
+     * 
+     * `params()` returns a read-only copy of the parameters by name; use
+     * `set_param()` to change them.
      * 
      * The `par()` function members are aliases for `get_param()`.
      * 
@@ -596,10 +784,14 @@ public:
     void read_params(std::string fn);
     epiworld_double get_param(epiworld_fast_uint k);
     epiworld_double get_param(std::string pname);
+    ParamHandle get_param_handle(std::string pname) const;
     // void set_param(size_t k, epiworld_double val);
     void set_param(std::string pname, epiworld_double val);
+    void set_param(ParamHandle handle, epiworld_double val);
     // epiworld_double par(epiworld_fast_uint k);
     epiworld_double par(std::string pname) const;
+    epiworld_double par(ParamHandle handle) const;
+    const std::map< std::string, epiworld_double > params() const;
     ///@}
 
     void get_elapsed(
@@ -664,9 +856,107 @@ public:
     void queuing_on(); ///< Activates the queuing system (default.)
     Model<TSeq> & queuing_off(); ///< Deactivates the queuing system.
     bool is_queuing_on() const; ///< Query if the queuing system is on.
+
+    /**
+     * @name Parallel update of the agents' states
+     * 
+     * @details When on, `update_state()` splits the agents in contiguous
+     * blocks across `nthreads` OpenMP threads. Each thread has its own
+     * events buffer, scratch arrays (see `get_array_double_tmp()`), and
+     * copies of the model's distributions. The random numbers used while
+     * updating an agent come from a counter-based stream (`Philox4x32`)
+     * keyed by the run (a number drawn from the model's engine at the start
+     * of `run()`), the day, and the agent's id, and the events are applied
+     * in the order of the agents. Thus, results do not depend on the number
+     * of threads (but they differ from those with the parallel update off.)
+     * 
+     * Update functions must only modify the agent being updated (through
+     * the usual `Agent` functions, which add events) and draw random numbers
+     * through the model. Calls to `set_rand_*()` during the update only
+     * apply to the agent being updated.
+     * 
+     * @param nthreads Number of threads (ignored without OpenMP.)
+     */
+    ///@{
+    Model<TSeq> & parallel_update_on(int nthreads = 2);
+    Model<TSeq> & parallel_update_off();
+    bool is_parallel_update_on() const;
+    ///@}
     Queue<TSeq> & get_queue(); ///< Retrieve the `Queue` object.
     ///@}
 
+    /**
+     * @name Sets of agents by state
+     * 
+     * @details Tracked states keep the ids of the agents in them (see
+     * `StateSets`). The sets are rebuilt by `reset()` and then updated as
+     * the events are applied, so they reflect the states at the start of
+     * each day's update. Models that sample from the agents in a state
+     * (e.g., the infected ones) can use them instead of scanning the
+     * population every day.
+     * 
+     * @param state The state.
+     * @param by_entity If `true`, the set is split by the first entity of
+     * the agents (agents without entities are left out).
+     * @param group Id of the entity (ignored if the set is not split).
+     */
+    ///@{
+    void track_state(epiworld_fast_uint state, bool by_entity = false);
+    void track_states_off();
+    const std::vector< size_t > & get_agents_in_state(
+        epiworld_fast_uint state,
+        size_t group = 0u
+        ) const;
+    ///@}
+
+    /**
+     * @name Event-driven transitions
+     * 
+     * @details Agents in a timed state are not visited every day. Instead,
+     * `timer` is called when the agent enters the state and returns the
+     * number of days until it leaves (1 being the next day, negative for
+     * never), and `transition` is called on that day instead of the update
+     * function of the state. For a state left with a constant daily
+     * probability `q`, drawing the days with `rgeom(q)` and making the
+     * transition unconditionally gives the same distribution as the daily
+     * update (see `default_timer_exposed()`). Probabilities are read at
+     * entry, so changes while the agent is in the state (e.g., new tools or
+     * parameters) only apply to the choice made by `transition`.
+     * 
+     * Timers take effect from the next call to `reset()` (or `run()`).
+     * 
+     * @param state The state.
+     * @param timer Function returning the number of days in the state.
+     * @param transition Update function to call once the days are due.
+     */
+    ///@{
+    void set_state_timer(
+        epiworld_fast_uint state,
+        TimerFun<TSeq> timer,
+        UpdateFun<TSeq> transition
+        );
+    void state_timers_off();
+    bool is_state_timer_on(epiworld_fast_uint state) const;
+    ///@}
+
+    /**
+     * @name Compressed Sparse Row (CSR) network
+     * 
+     * @details With the CSR backend, the contact network is stored by the
+     * model in two contiguous arrays (offsets and neighbor ids) instead of
+     * a pair of vectors per agent. `network_csr_on()` can be called either
+     * before loading the network (then `agents_from_adjlist()` and
+     * `agents_from_edgelist()` build the CSR directly) or afterwards, in
+     * which case the agents' neighbor lists are moved into the CSR (keeping
+     * their order). `network_csr_off()` moves the ties back to the agents.
+     */
+    ///@{
+    Model<TSeq> & network_csr_on(); ///< Activates the CSR network backend.
+    Model<TSeq> & network_csr_off(); ///< Deactivates the CSR network backend (default.)
+    bool is_network_csr_on() const; ///< Query if the CSR network backend is on.
+    const NetworkCSR & get_network_csr() const; ///< Retrieve the `NetworkCSR` object.
+    ///@}
+
     /**
      * @name Get the susceptibility reduction object
      * 
@@ -229,15 +229,15 @@ inline const Model<TSeq> & Model<TSeq>::print(bool lite) const
     // Information about the parameters included
     printf_epiworld("\nModel parameters:\n");
     epiworld_fast_uint nchar = 0u;
-    for (auto & p : parameters)
+    for (auto & p : parameters_index)
         if (p.first.length() > nchar)
             nchar = p.first.length();
 
     std::string fmt = " - %-" + std::to_string(nchar + 1) + "s: ";
-    for (auto & p : parameters)
+    for (auto & p : parameters_index)
     {
         std::string fmt_tmp = fmt;
-        if (std::fabs(p.second) < 0.0001)
+        if (std::fabs(parameters[p.second]) < 0.0001)
             fmt_tmp += "%.1e\n";
         else
             fmt_tmp += "%.4f\n";
@@ -245,7 +245,7 @@ inline const Model<TSeq> & Model<TSeq>::print(bool lite) const
         printf_epiworld(
             fmt_tmp.c_str(),
             p.first.c_str(),
-            p.second
+            parameters[p.second]
         );
         
     }
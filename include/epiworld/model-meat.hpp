@@ -17,6 +17,10 @@
  * @param tool_hist 
  * @param transmission 
  * @param transition 
+ * @param binary If `true`, files are written in the binary format of
+ * `DataTable` (with extension `.bin` instead of `.csv`).
+ * @param writer If not `nullptr`, files are handed to `writer`, which writes
+ * them in the background. Call `writer->wait()` before reading them.
  * @return std::function<void(size_t,Model<TSeq>*)> 
  */
 template<typename TSeq = int>
@@ -30,7 +34,9 @@ inline std::function<void(size_t,Model<TSeq>*)> make_save_run(
     bool transmission,
     bool transition,
     bool reproductive,
-    bool generation
+    bool generation,
+    bool binary,
+    std::shared_ptr< DataWriter > writer
     )
 {
 
@@ -56,7 +62,9 @@ inline std::function<void(size_t,Model<TSeq>*)> make_save_run(
         generation
     };
 
-    std::function<void(size_t,Model<TSeq>*)> saver = [fmt,what_to_save](
+    std::string ext = binary ? ".bin" : ".csv";
+
+    std::function<void(size_t,Model<TSeq>*)> saver = [fmt,what_to_save,ext,binary,writer](
         size_t niter, Model<TSeq> * m
     ) -> void {
 
@@ -73,50 +81,50 @@ inline std::function<void(size_t,Model<TSeq>*)> make_save_run(
         char buff[1024u];
         if (what_to_save[0u])
         {
-            virus_info = fmt + std::string("_virus_info.csv");
+            virus_info = fmt + std::string("_virus_info") + ext;
             snprintf(buff, sizeof(buff), virus_info.c_str(), niter);
             virus_info = buff;
         } 
         if (what_to_save[1u])
         {
-            virus_hist = fmt + std::string("_virus_hist.csv");
+            virus_hist = fmt + std::string("_virus_hist") + ext;
             snprintf(buff, sizeof(buff), virus_hist.c_str(), niter);
             virus_hist = buff;
         } 
         if (what_to_save[2u])
         {
-            tool_info = fmt + std::string("_tool_info.csv");
+            tool_info = fmt + std::string("_tool_info") + ext;
             snprintf(buff, sizeof(buff), tool_info.c_str(), niter);
             tool_info = buff;
         } 
         if (what_to_save[3u])
         {
-            tool_hist = fmt + std::string("_tool_hist.csv");
+            tool_hist = fmt + std::string("_tool_hist") + ext;
             snprintf(buff, sizeof(buff), tool_hist.c_str(), niter);
             tool_hist = buff;
         } 
         if (what_to_save[4u])
         {
-            total_hist = fmt + std::string("_total_hist.csv");
+            total_hist = fmt + std::string("_total_hist") + ext;
             snprintf(buff, sizeof(buff), total_hist.c_str(), niter);
             total_hist = buff;
         } 
         if (what_to_save[5u])
         {
-            transmission = fmt + std::string("_transmission.csv");
+            transmission = fmt + std::string("_transmission") + ext;
             snprintf(buff, sizeof(buff), transmission.c_str(), niter);
             transmission = buff;
         } 
         if (what_to_save[6u])
         {
-            transition = fmt + std::string("_transition.csv");
+            transition = fmt + std::string("_transition") + ext;
             snprintf(buff, sizeof(buff), transition.c_str(), niter);
             transition = buff;
         } 
         if (what_to_save[7u])
         {
 
-            reproductive = fmt + std::string("_reproductive.csv");
+            reproductive = fmt + std::string("_reproductive") + ext;
             snprintf(buff, sizeof(buff), reproductive.c_str(), niter);
             reproductive = buff;
 
@@ -124,7 +132,7 @@ inline std::function<void(size_t,Model<TSeq>*)> make_save_run(
         if (what_to_save[8u])
         {
 
-            generation = fmt + std::string("_generation.csv");
+            generation = fmt + std::string("_generation") + ext;
             snprintf(buff, sizeof(buff), generation.c_str(), niter);
             generation = buff;
 
@@ -140,7 +148,9 @@ inline std::function<void(size_t,Model<TSeq>*)> make_save_run(
             transmission,
             transition,
             reproductive,
-            generation
+            generation,
+            binary,
+            writer.get()
         );
 
     };
@@ -162,6 +172,12 @@ inline void Model<TSeq>::events_add(
     int idx_object_
 ) {
 
+    // During a parallel update, each thread has its own buffer
+    auto & events   = parallel_update_running ?
+        update_thread().events : this->events;
+    auto & nactions = parallel_update_running ?
+        update_thread().nactions : this->nactions;
+
     ++nactions;
 
     #ifdef EPI_DEBUG
@@ -244,6 +260,12 @@ inline void Model<TSeq>::events_run()
         // Registering that the last change was today
         p->state_last_changed = today();
 
+        if (state_sets.is_on())
+            state_sets.update(*p);
+
+        if (state_timers.is_on())
+            state_timers.schedule(*p, this);
+
         #ifdef EPI_DEBUG
         if (static_cast<int>(p->state) >= static_cast<int>(nstates))
                 throw std::range_error(
@@ -260,9 +282,9 @@ inline void Model<TSeq>::events_run()
             else if (a.queue == -Queue<TSeq>::Everyone)
                 queue -= p;
             else if (a.queue == Queue<TSeq>::OnlySelf)
-                queue[p->get_id()]++;
+                queue.add_self(p);
             else if (a.queue == -Queue<TSeq>::OnlySelf)
-                queue[p->get_id()]--;
+                queue.rm_self(p);
             else if (a.queue != Queue<TSeq>::NoOne)
                 throw std::logic_error(
                     "The proposed queue change is not valid. Queue values can be {-2, -1, 0, 1, 2}."
@@ -377,15 +399,23 @@ inline Model<TSeq>::Model(const Model<TSeq> & model) :
     name(model.name),
     db(model.db),
     population(model.population),
-    population_backup(model.population_backup),
     directed(model.directed),
+    use_network_csr(model.use_network_csr),
+    network_csr(model.network_csr),
+    network_backup_on(model.network_backup_on),
+    network_backup_taken(model.network_backup_taken),
+    network_backup_modified(model.network_backup_modified),
+    network_backup(model.network_backup),
     viruses(model.viruses),
     tools(model.tools),
     entities(model.entities),
     entities_backup(model.entities_backup),
     rewire_fun(model.rewire_fun),
     rewire_prop(model.rewire_prop),
+    stop_fun(model.stop_fun),
+    stopped_early(model.stopped_early),
     parameters(model.parameters),
+    parameters_index(model.parameters_index),
     ndays(model.ndays),
     pb(model.pb),
     state_fun(model.state_fun),
@@ -397,6 +427,10 @@ inline Model<TSeq>::Model(const Model<TSeq> & model) :
     globalevents(model.globalevents),
     queue(model.queue),
     use_queuing(model.use_queuing),
+    state_sets(model.state_sets),
+    state_timers(model.state_timers),
+    parallel_update(model.parallel_update),
+    parallel_update_nthreads(model.parallel_update_nthreads),
     array_double_tmp(model.array_double_tmp.size()),
     array_virus_tmp(model.array_virus_tmp.size()),
     array_int_tmp(model.array_int_tmp.size())
@@ -407,10 +441,6 @@ inline Model<TSeq>::Model(const Model<TSeq> & model) :
     for (auto & p : population)
         p.model = this;
 
-    if (population_backup.size() != 0u)
-        for (auto & p : population_backup)
-            p.model = this;
-
     // Pointing to the right place. This needs
     // to be done afterwards since the state zero is set as a function
     // of the population.
@@ -437,6 +467,12 @@ inline Model<TSeq>::Model(Model<TSeq> && model) :
     agents_data(std::move(model.agents_data)),
     agents_data_ncols(std::move(model.agents_data_ncols)),
     directed(std::move(model.directed)),
+    use_network_csr(model.use_network_csr),
+    network_csr(std::move(model.network_csr)),
+    network_backup_on(model.network_backup_on),
+    network_backup_taken(model.network_backup_taken),
+    network_backup_modified(model.network_backup_modified),
+    network_backup(std::move(model.network_backup)),
     // Virus
     viruses(std::move(model.viruses)),
     // Tools
@@ -454,7 +490,10 @@ inline Model<TSeq>::Model(Model<TSeq> && model) :
     // Rewiring
     rewire_fun(std::move(model.rewire_fun)),
     rewire_prop(std::move(model.rewire_prop)),
+    stop_fun(std::move(model.stop_fun)),
+    stopped_early(model.stopped_early),
     parameters(std::move(model.parameters)),
+    parameters_index(std::move(model.parameters_index)),
     // Others
     ndays(model.ndays),
     pb(std::move(model.pb)),
@@ -467,6 +506,10 @@ inline Model<TSeq>::Model(Model<TSeq> && model) :
     globalevents(std::move(model.globalevents)),
     queue(std::move(model.queue)),
     use_queuing(model.use_queuing),
+    state_sets(std::move(model.state_sets)),
+    state_timers(std::move(model.state_timers)),
+    parallel_update(model.parallel_update),
+    parallel_update_nthreads(model.parallel_update_nthreads),
     array_double_tmp(model.array_double_tmp.size()),
     array_virus_tmp(model.array_virus_tmp.size()),
     array_int_tmp(model.array_int_tmp.size())
@@ -475,6 +518,9 @@ inline Model<TSeq>::Model(Model<TSeq> && model) :
     db.model = this;
     db.user_data.model = this;
 
+    for (auto & p : population)
+        p.model = this;
+
     if (use_queuing)
         queue.model = this;
 
@@ -486,20 +532,23 @@ inline Model<TSeq> & Model<TSeq>::operator=(const Model<TSeq> & m)
     name = m.name;
 
     population        = m.population;
-    population_backup = m.population_backup;
 
     for (auto & p : population)
         p.model = this;
 
-    if (population_backup.size() != 0)
-        for (auto & p : population_backup)
-            p.model = this;
-
     db = m.db;
     db.model = this;
     db.user_data.model = this;
 
     directed = m.directed;
+
+    use_network_csr    = m.use_network_csr;
+    network_csr        = m.network_csr;
+
+    network_backup_on       = m.network_backup_on;
+    network_backup_taken    = m.network_backup_taken;
+    network_backup_modified = m.network_backup_modified;
+    network_backup          = m.network_backup;
     
     viruses                        = m.viruses;
 
@@ -511,7 +560,11 @@ inline Model<TSeq> & Model<TSeq>::operator=(const Model<TSeq> & m)
     rewire_fun  = m.rewire_fun;
     rewire_prop = m.rewire_prop;
 
+    stop_fun      = m.stop_fun;
+    stopped_early = m.stopped_early;
+
     parameters = m.parameters;
+    parameters_index = m.parameters_index;
     ndays      = m.ndays;
     pb         = m.pb;
 
@@ -527,8 +580,13 @@ inline Model<TSeq> & Model<TSeq>::operator=(const Model<TSeq> & m)
     globalevents = m.globalevents;
 
     queue       = m.queue;
+    state_sets  = m.state_sets;
+    state_timers = m.state_timers;
     use_queuing = m.use_queuing;
 
+    parallel_update          = m.parallel_update;
+    parallel_update_nthreads = m.parallel_update_nthreads;
+
     // Making sure population is passed correctly
     // Pointing to the right place
     db.model = this;
@@ -670,6 +728,16 @@ inline void Model<TSeq>::agents_empty_graph(
         p.id = i++;
         p.model = this;
     }
+
+    // Under CSR, the empty graph has n isolated vertices
+    if (use_network_csr)
+        network_csr = NetworkCSR(std::vector< size_t >(n + 1u, 0u), {}, {});
+
+    // A new network invalidates the backup
+    network_backup_on       = false;
+    network_backup_taken    = false;
+    network_backup_modified = false;
+    network_backup          = NetworkCSR();
     
 
 }
@@ -677,46 +745,96 @@ inline void Model<TSeq>::agents_empty_graph(
 template<typename TSeq>
 inline void Model<TSeq>::set_rand_gamma(epiworld_double alpha, epiworld_double beta)
 {
+    if (parallel_update_running)
+    {
+        update_thread().rgammad = std::gamma_distribution<>(alpha,beta);
+        return;
+    }
+
     rgammad = std::gamma_distribution<>(alpha,beta);
 }
 
 template<typename TSeq>
 inline void Model<TSeq>::set_rand_norm(epiworld_double mean, epiworld_double sd)
 { 
+    if (parallel_update_running)
+    {
+        update_thread().rnormd = std::normal_distribution<>(mean, sd);
+        return;
+    }
+
     rnormd  = std::normal_distribution<>(mean, sd);
 }
 
 template<typename TSeq>
 inline void Model<TSeq>::set_rand_unif(epiworld_double a, epiworld_double b)
 { 
+    if (parallel_update_running)
+    {
+        update_thread().runifd = std::uniform_real_distribution<>(a, b);
+        return;
+    }
+
     runifd  = std::uniform_real_distribution<>(a, b);
 }
 
 template<typename TSeq>
 inline void Model<TSeq>::set_rand_lognormal(epiworld_double mean, epiworld_double shape)
 { 
+    if (parallel_update_running)
+    {
+        update_thread().rlognormald = std::lognormal_distribution<>(mean, shape);
+        return;
+    }
+
     rlognormald  = std::lognormal_distribution<>(mean, shape);
 }
 
 template<typename TSeq>
 inline void Model<TSeq>::set_rand_exp(epiworld_double lambda)
 { 
+    if (parallel_update_running)
+    {
+        update_thread().rexpd = std::exponential_distribution<>(lambda);
+        return;
+    }
+
     rexpd  = std::exponential_distribution<>(lambda);
 }
 
 template<typename TSeq>
 inline void Model<TSeq>::set_rand_binom(int n, epiworld_double p)
 { 
+    if (parallel_update_running)
+    {
+        update_thread().rbinomd = std::binomial_distribution<>(n, p);
+        return;
+    }
+
     rbinomd  = std::binomial_distribution<>(n, p);
 }
 
 template<typename TSeq>
 inline epiworld_double & Model<TSeq>::operator()(std::string pname) {
 
-    if (parameters.find(pname) == parameters.end())
+    const auto iter = parameters_index.find(pname);
+    if (iter == parameters_index.end())
         throw std::range_error("The parameter '"+ pname + "' is not in the model.");
 
-    return parameters[pname];
+    return parameters[iter->second];
+
+}
+
+template<typename TSeq>
+inline epiworld_double & Model<TSeq>::operator()(ParamHandle handle) {
+
+    if (handle.id >= parameters.size())
+        throw std::range_error(
+            "The parameter handle " + std::to_string(handle.id) +
+            " is out of range."
+            );
+
+    return parameters[handle.id];
 
 }
 
@@ -788,14 +906,34 @@ template<typename TSeq>
 inline void Model<TSeq>::set_backup()
 {
 
-    if (population_backup.size() == 0u)
-        population_backup = population;
+    // The network snapshot is taken lazily (see network_backup_touch())
+    network_backup_on = true;
 
     if (entities_backup.size() == 0u)
         entities_backup = entities;
 
 }
 
+template<typename TSeq>
+inline void Model<TSeq>::network_backup_touch()
+{
+
+    if (network_backup_on && !network_backup_taken)
+    {
+
+        if (use_network_csr)
+            network_backup = network_csr;
+        else
+            network_backup = network_csr_from_agents(population, false);
+
+        network_backup_taken = true;
+
+    }
+
+    network_backup_modified = true;
+
+}
+
 // template<typename TSeq>
 // inline void Model<TSeq>::restore_backup()
 // {
@@ -814,7 +952,7 @@ inline void Model<TSeq>::set_backup()
 // }
 
 template<typename TSeq>
-inline std::shared_ptr< std::mt19937 > & Model<TSeq>::get_rand_endgine()
+inline std::shared_ptr< epiworld_rng_engine > & Model<TSeq>::get_rand_endgine()
 {
     return engine;
 }
@@ -822,34 +960,76 @@ inline std::shared_ptr< std::mt19937 > & Model<TSeq>::get_rand_endgine()
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::runif() {
     // CHECK_INIT()
+    if (parallel_update_running)
+    {
+        auto & t = update_thread();
+        return t.runifd(t.engine);
+    }
+
     return runifd(*engine);
 }
 
+template<typename TSeq>
+inline void Model<TSeq>::runif_n(epiworld_double * x, size_t n) {
+
+    if (parallel_update_running)
+    {
+        auto & t = update_thread();
+        runif_fill(t.engine, t.runifd, x, n);
+        return;
+    }
+
+    runif_fill(*engine, runifd, x, n);
+
+}
+
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::runif(epiworld_double a, epiworld_double b) {
     // CHECK_INIT()
-    return runifd(*engine) * (b - a) + a;
+    return runif() * (b - a) + a;
 }
 
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::rnorm() {
     // CHECK_INIT()
+    if (parallel_update_running)
+    {
+        auto & t = update_thread();
+        return t.rnormd(t.engine);
+    }
+
     return rnormd(*engine);
 }
 
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::rnorm(epiworld_double mean, epiworld_double sd) {
     // CHECK_INIT()
-    return rnormd(*engine) * sd + mean;
+    return rnorm() * sd + mean;
 }
 
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::rgamma() {
+
+    if (parallel_update_running)
+    {
+        auto & t = update_thread();
+        return t.rgammad(t.engine);
+    }
+
     return rgammad(*engine);
 }
 
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::rgamma(epiworld_double alpha, epiworld_double beta) {
+
+    if (parallel_update_running)
+    {
+        auto & t = update_thread();
+        return t.rgammad(
+            t.engine, std::gamma_distribution<>::param_type(alpha, beta)
+            );
+    }
+
     auto old_param = rgammad.param();
     rgammad.param(std::gamma_distribution<>::param_type(alpha, beta));
     epiworld_double ans = rgammad(*engine);
@@ -859,11 +1039,27 @@ inline epiworld_double Model<TSeq>::rgamma(epiworld_double alpha, epiworld_doubl
 
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::rexp() {
+
+    if (parallel_update_running)
+    {
+        auto & t = update_thread();
+        return t.rexpd(t.engine);
+    }
+
     return rexpd(*engine);
 }
 
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::rexp(epiworld_double lambda) {
+
+    if (parallel_update_running)
+    {
+        auto & t = update_thread();
+        return t.rexpd(
+            t.engine, std::exponential_distribution<>::param_type(lambda)
+            );
+    }
+
     auto old_param = rexpd.param();
     rexpd.param(std::exponential_distribution<>::param_type(lambda));
     epiworld_double ans = rexpd(*engine);
@@ -873,11 +1069,27 @@ inline epiworld_double Model<TSeq>::rexp(epiworld_double lambda) {
 
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::rlognormal() {
+
+    if (parallel_update_running)
+    {
+        auto & t = update_thread();
+        return t.rlognormald(t.engine);
+    }
+
     return rlognormald(*engine);
 }
 
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::rlognormal(epiworld_double mean, epiworld_double shape) {
+
+    if (parallel_update_running)
+    {
+        auto & t = update_thread();
+        return t.rlognormald(
+            t.engine, std::lognormal_distribution<>::param_type(mean, shape)
+            );
+    }
+
     auto old_param = rlognormald.param();
     rlognormald.param(std::lognormal_distribution<>::param_type(mean, shape));
     epiworld_double ans = rlognormald(*engine);
@@ -887,11 +1099,27 @@ inline epiworld_double Model<TSeq>::rlognormal(epiworld_double mean, epiworld_do
 
 template<typename TSeq>
 inline int Model<TSeq>::rbinom() {
+
+    if (parallel_update_running)
+    {
+        auto & t = update_thread();
+        return t.rbinomd(t.engine);
+    }
+
     return rbinomd(*engine);
 }
 
 template<typename TSeq>
 inline int Model<TSeq>::rbinom(int n, epiworld_double p) {
+
+    if (parallel_update_running)
+    {
+        auto & t = update_thread();
+        return t.rbinomd(
+            t.engine, std::binomial_distribution<>::param_type(n, p)
+            );
+    }
+
     auto old_param = rbinomd.param();
     rbinomd.param(std::binomial_distribution<>::param_type(n, p));
     epiworld_double ans = rbinomd(*engine);
@@ -899,6 +1127,41 @@ inline int Model<TSeq>::rbinom(int n, epiworld_double p) {
     return ans;
 }
 
+template<typename TSeq>
+inline int Model<TSeq>::rbinom(
+    const std::binomial_distribution<>::param_type & par
+) {
+
+    if (parallel_update_running)
+    {
+        auto & t = update_thread();
+        return t.rbinomd(t.engine, par);
+    }
+
+    return rbinomd(*engine, par);
+}
+
+template<typename TSeq>
+inline int Model<TSeq>::rgeom(epiworld_double p) {
+
+    if (p >= 1.0)
+        return 1;
+
+    if (p <= 0.0)
+        return std::numeric_limits< int >::max();
+
+    // Inverse CDF, P(X > k) = (1 - p)^k
+    epiworld_double k = std::floor(
+        std::log1p(-runif()) / std::log1p(-p)
+        ) + 1.0;
+
+    if (k >= static_cast< epiworld_double >(std::numeric_limits< int >::max()))
+        return std::numeric_limits< int >::max();
+
+    return static_cast< int >(k);
+
+}
+
 template<typename TSeq>
 inline void Model<TSeq>::seed(size_t s) {
     this->engine->seed(s);
@@ -1028,52 +1291,10 @@ inline void Model<TSeq>::load_agents_entities_ties(
     )
 {
 
-    int i,j;
-    std::ifstream filei(fn);
-
-    if (!filei)
-        throw std::logic_error("The file " + fn + " was not found.");
-
-    int linenum = 0;
-    std::vector< std::vector< epiworld_fast_uint > > target_(entities.size());
-
-    target_.reserve(1e5);
-
-    while (!filei.eof())
-    {
-
-        if (linenum++ < skip)
-            continue;
-
-        filei >> i >> j;
-
-        // Looking for exceptions
-        if (filei.bad())
-            throw std::logic_error(
-                "I/O error while reading the file " +
-                fn
-            );
-
-        if (filei.fail())
-            break;
-
-        if (i >= static_cast<int>(this->size()))
-            throw std::range_error(
-                "The agent["+std::to_string(linenum)+"] = " + std::to_string(i) +
-                " is above the max id " + std::to_string(this->size() - 1)
-                );
-
-        if (j >= static_cast<int>(this->entities.size()))
-            throw std::range_error(
-                "The entity["+std::to_string(linenum)+"] = " + std::to_string(j) +
-                " is above the max id " + std::to_string(this->entities.size() - 1)
-                );
-
-        target_[j].push_back(i);
-
-        population[i].add_entity(entities[j], nullptr);
+    std::vector< int > agents_ids, entities_ids;
+    read_edgelist_text(fn, agents_ids, entities_ids, skip);
 
-    }
+    this->load_agents_entities_ties(agents_ids, entities_ids);
 
     return;
 
@@ -1184,9 +1405,24 @@ inline void Model<TSeq>::agents_from_adjlist(
     bool directed
     ) {
 
-    AdjList al;
-    al.read_edgelist(fn, size, skip, directed);
-    this->agents_from_adjlist(al);
+    std::vector< int > source, target;
+    read_edgelist_text(fn, source, target, skip);
+    this->agents_from_edgelist(source, target, size, directed);
+
+}
+
+template<typename TSeq>
+inline void Model<TSeq>::agents_from_binary_edgelist(std::string fn)
+{
+
+    std::vector< int > source, target;
+    size_t size;
+    bool directed_;
+    read_edgelist_binary(fn, source, target, &size, &directed_);
+
+    this->agents_from_edgelist(
+        source, target, static_cast< int >(size), directed_
+        );
 
 }
 
@@ -1195,11 +1431,19 @@ inline void Model<TSeq>::agents_from_edgelist(
     const std::vector< int > & source,
     const std::vector< int > & target,
     int size,
-    bool directed
+    bool /* directed */
 ) {
 
-    AdjList al(source, target, size, directed);
-    agents_from_adjlist(al);
+    // The network is built in CSR format directly from the edgelist (no
+    // AdjList) and, if needed, moved to the agents' neighbor lists. As in
+    // agents_from_adjlist(), ties are stored in both directions.
+    agents_empty_graph(size);
+    NetworkCSR net(source, target, size);
+
+    if (use_network_csr)
+        network_csr = std::move(net);
+    else
+        network_csr_to_agents(net, population);
 
 }
 
@@ -1208,6 +1452,14 @@ inline void Model<TSeq>::agents_from_adjlist(AdjList al) {
 
     // Resizing the people
     agents_empty_graph(al.vcount());
+
+    if (use_network_csr)
+    {
+
+        network_csr = NetworkCSR(al);
+        return;
+
+    }
     
     const auto & tmpdat = al.get_dat();
     
@@ -1345,7 +1597,12 @@ inline Model<TSeq> & Model<TSeq>::run(
     // Starting first infection and tools
     reset();
 
+    // Key of the random number streams used in parallel updates
+    if (parallel_update)
+        parallel_update_key = static_cast< std::uint32_t >((*engine)());
+
     // Initializing the simulation
+    stopped_early = false;
     chrono_start();
     EPIWORLD_RUN((*this))
     {
@@ -1372,6 +1629,19 @@ inline Model<TSeq> & Model<TSeq>::run(
         // Mutation must happen at the very end of all
         this->mutate_virus();
 
+        // The stop function sees the day just recorded
+        if (stop_fun)
+        {
+
+            this->current_date--;
+            stopped_early = stop_fun(this);
+            this->current_date++;
+
+            if (stopped_early)
+                break;
+
+        }
+
     }
 
     // The last reaches the end...
@@ -1404,11 +1674,13 @@ inline void Model<TSeq>::run_multiple(
 
     // Seeds will be reproducible by default
     std::vector< int > seeds_n(nexperiments);
-    for (auto & s : seeds_n)
+    std::vector< epiworld_double > seeds_u(nexperiments);
+    runif_n(seeds_u.data(), nexperiments);
+    for (size_t i = 0u; i < nexperiments; ++i)
     {
-        s = static_cast<int>(
+        seeds_n[i] = static_cast<int>(
             std::floor(
-                runif() * static_cast<double>(std::numeric_limits<int>::max())
+                seeds_u[i] * static_cast<double>(std::numeric_limits<int>::max())
                 )
         );
     }
@@ -1432,28 +1704,18 @@ inline void Model<TSeq>::run_multiple(
     for (size_t i = 0; i < static_cast<size_t>(std::max(nthreads - 1, 0)); ++i)
         these.push_back(clone_ptr());
 
-    // Figuring out how many replicates
-    std::vector< size_t > nreplicates(nthreads, 0);
-    std::vector< size_t > nreplicates_csum(nthreads, 0);
-    size_t sums = 0u;
-    for (int i = 0; i < nthreads; ++i)
-    {
-        nreplicates[i] = static_cast<epiworld_fast_uint>(
-            std::floor(nexperiments/nthreads)
-            );
-        
-        // This takes the cumsum
-        nreplicates_csum[i] = sums;
-
-        sums += nreplicates[i];
-
-    }
+    // Replicates are handed out on demand (the next available id), so
+    // threads that draw short replicates run more of them. Results do not
+    // depend on the assignment since replicate `sim_id` always uses the seed
+    // `seeds_n[sim_id]`.
+    size_t next_sim_id = 0u;
+    size_t n_done      = 0u;
 
-    if (sums < nexperiments)
-        nreplicates[nthreads - 1] += (nexperiments - sums);
+    run_multiple_nreplicates.assign(nthreads, 0u);
+    run_multiple_busy.assign(nthreads, 0.0);
 
     Progress pb_multiple(
-        nreplicates[0u],
+        static_cast<int>(nexperiments),
         EPIWORLD_PROGRESS_BAR_WIDTH
         );
 
@@ -1485,45 +1747,75 @@ inline void Model<TSeq>::run_multiple(
     }
     #endif
 
-    #pragma omp parallel shared(these, nreplicates, nreplicates_csum, seeds_n) \
-        firstprivate(nexperiments, nthreads, fun, reset, verbose, pb_multiple, ndays) \
+    auto wall_start = std::chrono::steady_clock::now();
+
+    #pragma omp parallel shared(these, seeds_n, next_sim_id, n_done) \
+        firstprivate(nexperiments, nthreads, fun, reset, verbose, ndays) \
         default(shared)
     {
 
         auto iam = omp_get_thread_num();
+        Model<TSeq> * model = (iam == 0) ? this : these[iam - 1];
 
-        for (size_t n = 0u; n < nreplicates[iam]; ++n)
+        size_t shown = 0u;
+        while (true)
         {
-            size_t sim_id = nreplicates_csum[iam] + n;
-            if (iam == 0)
-            {
 
-                // Initializing the seed
-                run(ndays, seeds_n[sim_id]);
+            size_t sim_id;
+            #pragma omp atomic capture
+            sim_id = next_sim_id++;
 
-                if (fun)
-                    fun(n, this);
+            if (sim_id >= nexperiments)
+                break;
 
-                // Only the first one prints
-                if (verbose)
-                    pb_multiple.next();
+            auto busy_start = std::chrono::steady_clock::now();
+
+            // Initializing the seed
+            model->run(ndays, seeds_n[sim_id]);
+
+            if (fun)
+                fun(sim_id, model);
 
-            } else {
+            run_multiple_busy[iam] += std::chrono::duration<epiworld_double>(
+                std::chrono::steady_clock::now() - busy_start
+                ).count();
 
-                // Initializing the seed
-                these[iam - 1]->run(ndays, seeds_n[sim_id]);
+            run_multiple_nreplicates[iam]++;
 
-                if (fun)
-                    fun(sim_id, these[iam - 1]);
+            #pragma omp atomic update
+            n_done++;
+
+            // Only the first one prints
+            if (verbose && (iam == 0))
+            {
+
+                size_t n_done_now;
+                #pragma omp atomic read
+                n_done_now = n_done;
+
+                for (; shown < n_done_now; ++shown)
+                    pb_multiple.next();
 
             }
 
         }
+
+        // Catching up with the replicates finished by the others
+        #pragma omp barrier
+        if (verbose && (iam == 0))
+        {
+            for (; shown < nexperiments; ++shown)
+                pb_multiple.next();
+        }
         
     }
 
+    run_multiple_elapsed = std::chrono::duration<epiworld_double>(
+        std::chrono::steady_clock::now() - wall_start
+        ).count();
+
     // Adjusting the number of replicates
-    n_replicates += (nexperiments - nreplicates[0u]);
+    n_replicates += (nexperiments - run_multiple_nreplicates[0u]);
 
     for (auto & ptr : these)
         delete ptr;
@@ -1549,6 +1841,8 @@ inline void Model<TSeq>::run_multiple(
 
     }
 
+    auto wall_start = std::chrono::steady_clock::now();
+
     for (size_t n = 0u; n < nexperiments; ++n)
     {
 
@@ -1561,11 +1855,43 @@ inline void Model<TSeq>::run_multiple(
             pb_multiple.next();
     
     }
+
+    run_multiple_elapsed = std::chrono::duration<epiworld_double>(
+        std::chrono::steady_clock::now() - wall_start
+        ).count();
+
+    run_multiple_nreplicates.assign(1u, nexperiments);
+    run_multiple_busy.assign(1u, run_multiple_elapsed);
     #endif
 
     if (verbose)
+    {
+
         pb_multiple.end();
 
+        if (run_multiple_nreplicates.size() > 1u)
+        {
+
+            std::vector< epiworld_double > utilization;
+            get_run_multiple_stats(nullptr, &utilization);
+
+            epiworld_double u_mean = 0.0;
+            epiworld_double u_min  = 1.0;
+            for (auto u : utilization)
+            {
+                u_mean += u / static_cast<epiworld_double>(utilization.size());
+                u_min   = std::min(u_min, u);
+            }
+
+            printf_epiworld(
+                "Thread utilization: %.1f%% (mean), %.1f%% (min)\n",
+                u_mean * 100.0, u_min * 100.0
+            );
+
+        }
+
+    }
+
     if (old_verb)
         verbose_on();
 
@@ -1574,75 +1900,288 @@ inline void Model<TSeq>::run_multiple(
 }
 
 template<typename TSeq>
-inline void Model<TSeq>::update_state() {
+inline void Model<TSeq>::get_run_multiple_stats(
+    std::vector< size_t > * nreplicates,
+    std::vector< epiworld_double > * utilization
+) const
+{
 
-    // Next state
-    if (use_queuing)
-    {
-        int i = -1;
-        for (auto & p: population)
-            if (queue[++i] > 0)
-            {
-                if (state_fun[p.state])
-                    state_fun[p.state](&p, this);
-            }
+    if (nreplicates != nullptr)
+        *nreplicates = run_multiple_nreplicates;
 
-    }
-    else
+    if (utilization != nullptr)
     {
 
-        for (auto & p: population)
-            if (state_fun[p.state])
-                    state_fun[p.state](&p, this);
+        utilization->resize(run_multiple_busy.size());
+        for (size_t i = 0u; i < run_multiple_busy.size(); ++i)
+            (*utilization)[i] = (run_multiple_elapsed > 0.0) ?
+                std::min(
+                    static_cast<epiworld_double>(1.0),
+                    run_multiple_busy[i] / run_multiple_elapsed
+                ) : static_cast<epiworld_double>(0.0);
 
     }
 
-    events_run();
-    
+    return;
+
 }
 
+template<typename TSeq>
+inline void Model<TSeq>::update_state() {
 
+    if (parallel_update)
+    {
 
-template<typename TSeq>
-inline void Model<TSeq>::mutate_virus() {
+        update_state_parallel();
 
-    // Checking if any virus has mutation
-    size_t nmutates = 0u;
-    for (const auto & v: viruses)
-        if (v->mutation_fun)
-            nmutates++;
+        // Due transitions are few, so these run serially
+        if (state_timers.is_on())
+            state_timers.run_due(this);
+
+        events_run();
+
+        if (state_timers.is_on())
+            state_timers.reschedule_due(this);
 
-    if (nmutates == 0u)
         return;
 
+    }
+
+    // Next state (agents in timed states wait for their due day)
+    bool timers = state_timers.is_on();
     if (use_queuing)
     {
 
-        int i = -1;
-        for (auto & p: population)
+        // Only the agents in the queue (in increasing order of id)
+        for (auto i : queue.get_active_sorted())
         {
-
-            if (queue[++i] == 0)
-                continue;
-
-            if (p.virus != nullptr)
-                p.virus->mutate(this);
-
+            auto & p = population[i];
+            if (state_fun[p.state] && !(timers && state_timers.is_timed(p.state)))
+                state_fun[p.state](&p, this);
         }
 
     }
-    else 
+    else
     {
 
         for (auto & p: population)
-        {
+            if (state_fun[p.state] && !(timers && state_timers.is_timed(p.state)))
+                    state_fun[p.state](&p, this);
 
-            if (p.virus != nullptr)
-                p.virus->mutate(this);
+    }
 
-        }
+    if (timers)
+        state_timers.run_due(this);
 
-    }
+    events_run();
+
+    if (timers)
+        state_timers.reschedule_due(this);
+    
+}
+
+template<typename TSeq>
+inline typename Model<TSeq>::UpdateThread & Model<TSeq>::update_thread()
+{
+    #ifdef _OPENMP
+    return update_threads[omp_get_thread_num()];
+    #else
+    return update_threads[0u];
+    #endif
+}
+
+template<typename TSeq>
+inline void Model<TSeq>::update_state_parallel() {
+
+    #ifdef _OPENMP
+    int nthreads = std::max(parallel_update_nthreads, 1);
+    #else
+    int nthreads = 1;
+    #endif
+
+    // Preparing the context of each thread
+    if (update_threads.size() != static_cast< size_t >(nthreads))
+        update_threads.resize(nthreads);
+
+    // Same sizes as the model's own scratch arrays (see run())
+    size_t ndouble_tmp = std::max(
+        size(),
+        static_cast<size_t>(1024 * 1024)
+    );
+
+    for (auto & t : update_threads)
+    {
+
+        if (t.array_double_tmp.size() < ndouble_tmp)
+        {
+            t.array_double_tmp.resize(ndouble_tmp);
+            t.array_virus_tmp.resize(1024u);
+            t.array_int_tmp.resize(1024u * 1024u);
+        }
+
+        t.nactions = 0u;
+
+    }
+
+    // Streams are keyed by the run and the day
+    std::uint64_t key = (static_cast< std::uint64_t >(parallel_update_key) << 32u) |
+        static_cast< std::uint32_t >(today());
+
+    // Exceptions cannot leave the parallel region
+    std::vector< std::exception_ptr > errors(nthreads, nullptr);
+
+    parallel_update_running = true;
+
+    // With queuing, only the agents in the queue are visited (sorted)
+    const std::vector< size_t > * ids = use_queuing ?
+        &queue.get_active_sorted() : nullptr;
+
+    // The static schedule assigns contiguous blocks of agents to the threads
+    // (in order), so concatenating the threads' events preserves the order
+    // of the agents.
+    int n = static_cast< int >(use_queuing ? ids->size() : population.size());
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(static) num_threads(nthreads)
+    #endif
+    for (int k = 0; k < n; ++k)
+    {
+
+        size_t i = use_queuing ? (*ids)[k] : static_cast< size_t >(k);
+        Agent<TSeq> & p = population[i];
+
+        if (!state_fun[p.state] || state_timers.is_timed(p.state))
+            continue;
+
+        UpdateThread & t = update_thread();
+
+        #ifdef _OPENMP
+        auto & error = errors[omp_get_thread_num()];
+        #else
+        auto & error = errors[0u];
+        #endif
+
+        if (error)
+            continue;
+
+        // Random numbers only depend on (run, day, agent)
+        t.engine.seed(key);
+        t.engine.set_stream(static_cast< std::uint64_t >(i));
+        t.runifd      = runifd;
+        t.rnormd      = rnormd;
+        t.rgammad     = rgammad;
+        t.rlognormald = rlognormald;
+        t.rexpd       = rexpd;
+        t.rbinomd     = rbinomd;
+
+        try
+        {
+            state_fun[p.state](&p, this);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+    }
+
+    parallel_update_running = false;
+
+    for (auto & e : errors)
+        if (e)
+            std::rethrow_exception(e);
+
+    // Merging the events (in the order of the agents)
+    for (auto & t : update_threads)
+    {
+
+        for (size_t k = 0u; k < t.nactions; ++k)
+        {
+            Event<TSeq> & e = t.events[k];
+            events_add(
+                e.agent, std::move(e.virus), std::move(e.tool), e.entity,
+                e.new_state, e.queue, std::move(e.call),
+                e.idx_agent, e.idx_object
+            );
+        }
+
+        t.nactions = 0u;
+
+    }
+
+    return;
+
+}
+
+template<typename TSeq>
+inline std::vector< epiworld_double > & Model<TSeq>::get_array_double_tmp()
+{
+
+    if (parallel_update_running)
+        return update_thread().array_double_tmp;
+
+    return array_double_tmp;
+
+}
+
+template<typename TSeq>
+inline std::vector< Virus<TSeq> * > & Model<TSeq>::get_array_virus_tmp()
+{
+
+    if (parallel_update_running)
+        return update_thread().array_virus_tmp;
+
+    return array_virus_tmp;
+
+}
+
+template<typename TSeq>
+inline std::vector< int > & Model<TSeq>::get_array_int_tmp()
+{
+
+    if (parallel_update_running)
+        return update_thread().array_int_tmp;
+
+    return array_int_tmp;
+
+}
+
+template<typename TSeq>
+inline void Model<TSeq>::mutate_virus() {
+
+    // Checking if any virus has mutation
+    size_t nmutates = 0u;
+    for (const auto & v: viruses)
+        if (v->shared->mutation_fun)
+            nmutates++;
+
+    if (nmutates == 0u)
+        return;
+
+    if (use_queuing)
+    {
+
+        for (auto i : queue.get_active_sorted())
+        {
+
+            auto & p = population[i];
+            if (p.virus != nullptr)
+                p.virus->mutate(this);
+
+        }
+
+    }
+    else 
+    {
+
+        for (auto & p: population)
+        {
+
+            if (p.virus != nullptr)
+                p.virus->mutate(this);
+
+        }
+
+    }
     
 
 }
@@ -1690,6 +2229,18 @@ inline Model<TSeq> & Model<TSeq>::verbose_off() {
     return *this;
 }
 
+template<typename TSeq>
+inline void Model<TSeq>::set_stop_fun(StopFun<TSeq> fun)
+{
+    stop_fun = fun;
+}
+
+template<typename TSeq>
+inline bool Model<TSeq>::get_stopped_early() const
+{
+    return stopped_early;
+}
+
 template<typename TSeq>
 inline void Model<TSeq>::set_rewire_fun(
     std::function<void(std::vector<Agent<TSeq>>*,Model<TSeq>*,epiworld_double)> fun
@@ -1733,7 +2284,9 @@ inline void Model<TSeq>::write_data(
     std::string fn_transmission,
     std::string fn_transition,
     std::string fn_reproductive_number,
-    std::string fn_generation_time
+    std::string fn_generation_time,
+    bool binary,
+    DataWriter * writer
     ) const
 {
 
@@ -1741,7 +2294,8 @@ inline void Model<TSeq>::write_data(
         fn_virus_info, fn_virus_hist,
         fn_tool_info, fn_tool_hist,
         fn_total_hist, fn_transmission, fn_transition,
-        fn_reproductive_number, fn_generation_time
+        fn_reproductive_number, fn_generation_time,
+        binary, writer
         );
 
 }
@@ -1764,17 +2318,19 @@ inline void Model<TSeq>::write_edgelist(
 
         for (const auto & p : wseq)
         {
-            for (auto & n : p->neighbors)
-                efile << p->id << " " << n << "\n";
+            const size_t * neighbors = p->get_neighbors_ids();
+            for (size_t i = 0u; i < p->get_n_neighbors(); ++i)
+                efile << p->id << " " << neighbors[i] << "\n";
         }
 
     } else {
 
         for (const auto & p : wseq)
         {
-            for (auto & n : p->neighbors)
-                if (static_cast<int>(p->id) <= static_cast<int>(n))
-                    efile << p->id << " " << n << "\n";
+            const size_t * neighbors = p->get_neighbors_ids();
+            for (size_t i = 0u; i < p->get_n_neighbors(); ++i)
+                if (static_cast<int>(p->id) <= static_cast<int>(neighbors[i]))
+                    efile << p->id << " " << neighbors[i] << "\n";
         }
 
     }
@@ -1797,10 +2353,11 @@ std::vector< int > & target
 
         for (const auto & p : wseq)
         {
-            for (auto & n : p->neighbors)
+            const size_t * neighbors = p->get_neighbors_ids();
+            for (size_t i = 0u; i < p->get_n_neighbors(); ++i)
             {
                 source.push_back(static_cast<int>(p->id));
-                target.push_back(static_cast<int>(n));
+                target.push_back(static_cast<int>(neighbors[i]));
             }
         }
 
@@ -1808,10 +2365,11 @@ std::vector< int > & target
 
         for (const auto & p : wseq)
         {
-            for (auto & n : p->neighbors) {
-                if (static_cast<int>(p->id) <= static_cast<int>(n)) {
+            const size_t * neighbors = p->get_neighbors_ids();
+            for (size_t i = 0u; i < p->get_n_neighbors(); ++i) {
+                if (static_cast<int>(p->id) <= static_cast<int>(neighbors[i])) {
                     source.push_back(static_cast<int>(p->id));
-                    target.push_back(static_cast<int>(n));
+                    target.push_back(static_cast<int>(neighbors[i]));
                 }
             }
         }
@@ -1821,31 +2379,22 @@ std::vector< int > & target
 
 }
 
-template<typename TSeq>
-inline std::map<std::string,epiworld_double> & Model<TSeq>::params()
-{
-    return parameters;
-}
-
 template<typename TSeq>
 inline void Model<TSeq>::reset() {
 
     // Restablishing people
     pb = Progress(ndays, 80);
 
-    if (population_backup.size() != 0u)
+    // Restoring the ties only if they changed
+    if (network_backup_taken && network_backup_modified)
     {
-        population = population_backup;
 
-        #ifdef EPI_DEBUG
-        for (size_t i = 0; i < population.size(); ++i)
-        {
+        if (use_network_csr)
+            network_csr = network_backup;
+        else
+            network_csr_to_agents(network_backup, population);
 
-            if (population[i] != population_backup[i])
-                throw std::logic_error("Model::reset population doesn't match.");
-
-        }
-        #endif
+        network_backup_modified = false;
 
     }
 
@@ -1888,6 +2437,9 @@ inline void Model<TSeq>::reset() {
     if (use_queuing)
         queue.reset();
 
+    if (state_timers.is_on())
+        state_timers.start(population.size(), static_cast< int >(ndays));
+
     // Re distributing tools and virus
     dist_virus();
     dist_tools();
@@ -1896,6 +2448,12 @@ inline void Model<TSeq>::reset() {
     // Distributing initial state, if specified
     initial_states_fun(this);
 
+    if (state_sets.is_on())
+        state_sets.rebuild(population);
+
+    if (state_timers.is_on())
+        state_timers.rebuild(this);
+
     // Recording the original state (at time 0) and advancing
     // to time 1
     next();
@@ -1978,8 +2536,11 @@ inline epiworld_double Model<TSeq>::add_param(
     std::string pname
     ) {
 
-    if (parameters.find(pname) == parameters.end())
-        parameters[pname] = initial_value;
+    if (parameters_index.find(pname) == parameters_index.end())
+    {
+        parameters_index[pname] = parameters.size();
+        parameters.push_back(initial_value);
+    }
     
     return initial_value;
 
@@ -2031,22 +2592,54 @@ inline void Model<TSeq>::read_params(std::string fn)
 
 }
 
+template<typename TSeq>
+inline epiworld_double Model<TSeq>::get_param(epiworld_fast_uint k)
+{
+    if (k >= parameters.size())
+        throw std::logic_error(
+            "The parameter index " + std::to_string(k) + " does not exists."
+            );
+
+    return parameters[k];
+}
+
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::get_param(std::string pname)
 {
-    if (parameters.find(pname) == parameters.end())
+    return parameters[get_param_handle(pname).id];
+}
+
+template<typename TSeq>
+inline ParamHandle Model<TSeq>::get_param_handle(std::string pname) const
+{
+    const auto iter = parameters_index.find(pname);
+    if (iter == parameters_index.end())
         throw std::logic_error("The parameter " + pname + " does not exists.");
 
-    return parameters[pname];
+    return ParamHandle(iter->second);
 }
 
 template<typename TSeq>
 inline void Model<TSeq>::set_param(std::string pname, epiworld_double value)
 {
-    if (parameters.find(pname) == parameters.end())
-        throw std::logic_error("The parameter " + pname + " does not exists.");
 
-    parameters[pname] = value;
+    parameters[get_param_handle(pname).id] = value;
+
+    return;
+
+}
+
+template<typename TSeq>
+inline void Model<TSeq>::set_param(ParamHandle handle, epiworld_double value)
+{
+
+    if (handle.id >= parameters.size())
+        throw std::logic_error(
+            "The parameter handle " + std::to_string(handle.id) +
+            " does not exists."
+            );
+
+    parameters[handle.id] = value;
 
     return;
 
@@ -2070,10 +2663,33 @@ inline void Model<TSeq>::set_param(std::string pname, epiworld_double value)
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::par(std::string pname) const
 {
-    const auto iter = parameters.find(pname);
-    if (iter == parameters.end())
-        throw std::logic_error("The parameter " + pname + " does not exists.");
-    return iter->second;
+    return parameters[get_param_handle(pname).id];
+}
+
+template<typename TSeq>
+inline epiworld_double Model<TSeq>::par(ParamHandle handle) const
+{
+    #ifdef EPI_DEBUG
+    if (handle.id >= parameters.size())
+        throw std::logic_error(
+            "The parameter handle " + std::to_string(handle.id) +
+            " does not exists."
+            );
+    #endif
+
+    return parameters[handle.id];
+}
+
+template<typename TSeq>
+inline const std::map< std::string, epiworld_double > Model<TSeq>::params() const
+{
+
+    std::map< std::string, epiworld_double > res;
+    for (const auto & p : parameters_index)
+        res[p.first] = parameters[p.second];
+
+    return res;
+
 }
 
 #define DURCAST(tunit,txtunit) {\
@@ -2281,6 +2897,7 @@ template<typename TSeq>
 inline void Model<TSeq>::queuing_on()
 {
     use_queuing = true;
+    queue.model = this;
 }
 
 template<typename TSeq>
@@ -2296,12 +2913,214 @@ inline bool Model<TSeq>::is_queuing_on() const
     return use_queuing;
 }
 
+template<typename TSeq>
+inline Model<TSeq> & Model<TSeq>::parallel_update_on(int nthreads)
+{
+
+    if (nthreads < 1)
+        throw std::range_error(
+            "The number of threads must be at least 1. Got " +
+            std::to_string(nthreads) + "."
+            );
+
+    parallel_update          = true;
+    parallel_update_nthreads = nthreads;
+
+    return *this;
+
+}
+
+template<typename TSeq>
+inline Model<TSeq> & Model<TSeq>::parallel_update_off()
+{
+
+    parallel_update = false;
+    update_threads.clear();
+
+    return *this;
+
+}
+
+template<typename TSeq>
+inline bool Model<TSeq>::is_parallel_update_on() const
+{
+    return parallel_update;
+}
+
+template<typename TSeq>
+inline NetworkCSR Model<TSeq>::network_csr_from_agents(
+    std::vector< Agent<TSeq> > & agents,
+    bool clear
+)
+{
+
+    size_t n = agents.size();
+    std::vector< size_t > offsets(n + 1u, 0u);
+    for (size_t i = 0u; i < n; ++i)
+        offsets[i + 1u] = offsets[i] + agents[i].n_neighbors;
+
+    // The reverse of each tie comes from the neighbors_locations
+    std::vector< size_t > ids(offsets[n]);
+    std::vector< size_t > reverse(offsets[n]);
+    for (size_t i = 0u; i < n; ++i)
+    {
+
+        auto & a = agents[i];
+        for (size_t k = 0u; k < a.n_neighbors; ++k)
+        {
+            ids[offsets[i] + k]     = a.neighbors[k];
+            reverse[offsets[i] + k] =
+                offsets[a.neighbors[k]] + a.neighbors_locations[k];
+        }
+
+        if (!clear)
+            continue;
+
+        a.neighbors.clear();
+        a.neighbors.shrink_to_fit();
+        a.neighbors_locations.clear();
+        a.neighbors_locations.shrink_to_fit();
+        a.n_neighbors = 0u;
+
+    }
+
+    return NetworkCSR(std::move(offsets), std::move(ids), std::move(reverse));
+
+}
+
+template<typename TSeq>
+inline void Model<TSeq>::network_csr_to_agents(
+    NetworkCSR & net,
+    std::vector< Agent<TSeq> > & agents
+)
+{
+
+    if (net.vcount() != agents.size())
+        throw std::length_error(
+            "The CSR network has " + std::to_string(net.vcount()) +
+            " vertices but there are " + std::to_string(agents.size()) +
+            " agents."
+            );
+
+    const auto & offsets = net.get_offsets();
+    const auto & ids     = net.get_ids();
+    for (size_t i = 0u; i < agents.size(); ++i)
+    {
+
+        auto & a = agents[i];
+        a.n_neighbors = net.degree(i);
+        a.neighbors.assign(
+            ids.begin() + offsets[i], ids.begin() + offsets[i + 1u]
+            );
+
+        a.neighbors_locations.resize(a.n_neighbors);
+        for (size_t k = 0u; k < a.n_neighbors; ++k)
+            a.neighbors_locations[k] =
+                net.get_reverse(offsets[i] + k) - offsets[a.neighbors[k]];
+
+    }
+
+}
+
+template<typename TSeq>
+inline Model<TSeq> & Model<TSeq>::network_csr_on()
+{
+
+    if (use_network_csr)
+        return *this;
+
+    // Moving the current ties (if any) into the CSR network. The backup
+    // (if any) is already in CSR format.
+    network_csr = network_csr_from_agents(population);
+
+    use_network_csr = true;
+
+    return *this;
+
+}
+
+template<typename TSeq>
+inline Model<TSeq> & Model<TSeq>::network_csr_off()
+{
+
+    if (!use_network_csr)
+        return *this;
+
+    use_network_csr = false;
+
+    network_csr_to_agents(network_csr, population);
+
+    network_csr = NetworkCSR();
+
+    return *this;
+
+}
+
+template<typename TSeq>
+inline bool Model<TSeq>::is_network_csr_on() const
+{
+    return use_network_csr;
+}
+
+template<typename TSeq>
+inline const NetworkCSR & Model<TSeq>::get_network_csr() const
+{
+    return network_csr;
+}
+
 template<typename TSeq>
 inline Queue<TSeq> & Model<TSeq>::get_queue()
 {
     return queue;
 }
 
+template<typename TSeq>
+inline void Model<TSeq>::track_state(
+    epiworld_fast_uint state,
+    bool by_entity
+)
+{
+    state_sets.track(state, by_entity);
+    state_sets.rebuild(population);
+}
+
+template<typename TSeq>
+inline void Model<TSeq>::track_states_off()
+{
+    state_sets.clear_tracking();
+}
+
+template<typename TSeq>
+inline const std::vector< size_t > & Model<TSeq>::get_agents_in_state(
+    epiworld_fast_uint state,
+    size_t group
+) const
+{
+    return state_sets.get(state, group);
+}
+
+template<typename TSeq>
+inline void Model<TSeq>::set_state_timer(
+    epiworld_fast_uint state,
+    TimerFun<TSeq> timer,
+    UpdateFun<TSeq> transition
+)
+{
+    state_timers.set(state, timer, transition);
+}
+
+template<typename TSeq>
+inline void Model<TSeq>::state_timers_off()
+{
+    state_timers.clear_timers();
+}
+
+template<typename TSeq>
+inline bool Model<TSeq>::is_state_timer_on(epiworld_fast_uint state) const
+{
+    return state_timers.is_timed(state);
+}
+
 template<typename TSeq>
 inline const std::vector< VirusPtr<TSeq> > & Model<TSeq>::get_viruses() const
 {
@@ -2387,25 +3206,15 @@ inline bool Model<TSeq>::operator==(const Model<TSeq> & other) const
         "Model:: using_backup don't match"
         )
     
-    if ((population_backup.size() != 0) & (other.population_backup.size() != 0))
-    {
-
-        // False is population_backup.size() != other.population_backup.size()
-        if (population_backup.size() != other.population_backup.size())
-            return false;
+    EPI_DEBUG_FAIL_AT_TRUE(
+        network_backup_taken != other.network_backup_taken,
+        "Model:: network_backup_taken don't match"
+        )
 
-        for (size_t i = 0u; i < population_backup.size(); ++i)
-        {
-            if (population_backup[i] != other.population_backup[i])
-                return false;
-        }
-        
-    } else if ((population_backup.size() == 0) & (other.population_backup.size() != 0)) {
-        return false;
-    } else if ((population_backup.size() != 0) & (other.population_backup.size() == 0))
-    {
-        return false;
-    }
+    EPI_DEBUG_FAIL_AT_TRUE(
+        network_backup != other.network_backup,
+        "Model:: network_backup don't match"
+        )
 
     EPI_DEBUG_FAIL_AT_TRUE(
         agents_data != other.agents_data,
@@ -2421,6 +3230,21 @@ inline bool Model<TSeq>::operator==(const Model<TSeq> & other) const
         directed != other.directed,
         "Model:: directed don't match"
     )
+
+    EPI_DEBUG_FAIL_AT_TRUE(
+        parallel_update != other.parallel_update,
+        "Model:: parallel_update don't match"
+    )
+
+    EPI_DEBUG_FAIL_AT_TRUE(
+        use_network_csr != other.use_network_csr,
+        "Model:: use_network_csr don't match"
+    )
+
+    EPI_DEBUG_FAIL_AT_TRUE(
+        network_csr != other.network_csr,
+        "Model:: network_csr don't match"
+    )
     
     // Viruses -----------------------------------------------------------------
     EPI_DEBUG_FAIL_AT_TRUE(
@@ -2489,7 +3313,8 @@ inline bool Model<TSeq>::operator==(const Model<TSeq> & other) const
     )
 
     EPI_DEBUG_FAIL_AT_TRUE(
-        parameters != other.parameters,
+        (parameters != other.parameters) ||
+            (parameters_index != other.parameters_index),
         "Model:: parameters don't match"
     )
 
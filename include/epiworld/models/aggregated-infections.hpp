@@ -0,0 +1,381 @@
+#ifndef EPIWORLD_MODELS_AGGREGATED_INFECTIONS_HPP
+#define EPIWORLD_MODELS_AGGREGATED_INFECTIONS_HPP
+
+/**
+ * @brief Draws the daily infections of connected and mixing models in bulk
+ *
+ * @details In the agent-level update, a susceptible agent of group `a`
+ * contacts `n_g ~ Binom(I_g, r_ag)` agents from the infected of each group
+ * `g` and the roulette then picks at most one of them. If all contacts
+ * transmit with the same probability `p` (no tools and a single transmission
+ * probability), the agent is infected with probability
+ *
+ * \f[
+ * q_a = 1 - E\left[\frac{1}{1 + o N}\right],\quad o = \frac{p}{1 - p},
+ * N = \sum_g n_g,
+ * \f]
+ *
+ * and the infector comes from group `g` with probability proportional to
+ * \f$E[o n_g / (1 + o N)]\f$. Both expectations are integrals over [0, 1] of
+ * the probability generating functions of the `n_g`, which are computed
+ * numerically. Then, the number of new infections of each group is
+ * `Binom(S_a, q_a)`, the infected agents are sampled without replacement
+ * from the susceptible ones, and the infectors uniformly from the chosen
+ * group. This has the same distribution as the agent-level update (but not
+ * the same random numbers), and costs O(new infections + infected) per day.
+ *
+ * The draws are made at the end of each day (and at reset) for the next
+ * one; the susceptible agents then get their infector from
+ * `pop_infector()` during the update.
+ *
+ * @tparam TSeq
+ */
+template<typename TSeq>
+class AggregatedInfections {
+private:
+
+    bool active = false;
+    std::vector< int > infector;    ///< Infector of each agent (-1 if none)
+    std::vector< size_t > marked;   ///< Agents with an infector
+
+    // Weights of the infector's group (times the probability of infection)
+    void group_weights(
+        std::vector< double > & res,
+        double t,
+        double odds,
+        const std::vector< size_t > & ninfected,
+        const double * contact_prob,
+        size_t ngroups
+    ) const;
+
+    void integrate(
+        std::vector< double > & res,
+        double odds,
+        const std::vector< size_t > & ninfected,
+        const double * contact_prob,
+        size_t ngroups
+    ) const;
+
+public:
+
+    void on() {active = true;};
+    void off() {active = false;};
+    bool is_on() const {return active;};
+
+    /**
+     * @brief Draws the infections of the next day
+     *
+     * @param m The model.
+     * @param susceptible,infected The susceptible and infectious states
+     * (both tracked, see `Model::track_state()`.)
+     * @param contact_prob Probability that a susceptible agent of group `a`
+     * contacts a given infected agent of group `g`, stored at
+     * `[g * ngroups + a]`.
+     * @param ngroups Number of groups (1 if the states are not split by
+     * entity.)
+     */
+    void draw(
+        Model<TSeq> * m,
+        epiworld_fast_uint susceptible,
+        epiworld_fast_uint infected,
+        const std::vector< double > & contact_prob,
+        size_t ngroups
+    );
+
+    /**
+     * @brief Virus of the agent's infector (`nullptr` if none), which is then
+     * cleared
+     * @details The draws are made the day before, so the infector may have
+     * lost its virus since (e.g., in a global event); there is no infection
+     * then.
+     */
+    Virus<TSeq> * pop_infector(size_t agent_id, Model<TSeq> * m);
+
+};
+
+template<typename TSeq>
+inline void AggregatedInfections<TSeq>::group_weights(
+    std::vector< double > & res,
+    double t,
+    double odds,
+    const std::vector< size_t > & ninfected,
+    const double * contact_prob,
+    size_t ngroups
+) const
+{
+
+    // With p = 1 the contacts transmit for sure, and the infector is
+    // drawn uniformly from them
+    bool certain = std::isinf(odds);
+    double x = certain ? t : std::pow(t, odds);
+
+    double log_pgf = 0.0;
+    for (size_t g = 0u; g < ngroups; ++g)
+    {
+
+        double f = 1.0 - contact_prob[g * ngroups] * (1.0 - x);
+        if (f <= 0.0)
+        {
+            res.assign(ngroups, 0.0);
+            return;
+        }
+
+        log_pgf += static_cast< double >(ninfected[g]) * std::log(f);
+
+    }
+
+    double scale = certain ? 1.0 : odds * x;
+    for (size_t g = 0u; g < ngroups; ++g)
+    {
+
+        double r = contact_prob[g * ngroups];
+        res[g] = scale * static_cast< double >(ninfected[g]) * r *
+            std::exp(log_pgf) / (1.0 - r * (1.0 - x));
+
+    }
+
+}
+
+template<typename TSeq>
+inline void AggregatedInfections<TSeq>::integrate(
+    std::vector< double > & res,
+    double odds,
+    const std::vector< size_t > & ninfected,
+    const double * contact_prob,
+    size_t ngroups
+) const
+{
+
+    // Adaptive Simpson's rule over [0, 1] (on the sum of the weights)
+    struct Segment {
+        double a, b;
+        std::vector< double > fa, fm, fb, whole;
+        int depth;
+    };
+
+    auto simpson = [ngroups](
+        std::vector< double > & out,
+        double a, double b,
+        const std::vector< double > & fa,
+        const std::vector< double > & fm,
+        const std::vector< double > & fb
+    ) -> double {
+
+        double total = 0.0;
+        out.resize(ngroups);
+        for (size_t g = 0u; g < ngroups; ++g)
+        {
+            out[g] = (b - a) / 6.0 * (fa[g] + 4.0 * fm[g] + fb[g]);
+            total += out[g];
+        }
+
+        return total;
+
+    };
+
+    res.assign(ngroups, 0.0);
+
+    std::vector< double > f0(ngroups), f1(ngroups), fmid(ngroups);
+    group_weights(f0, 0.0, odds, ninfected, contact_prob, ngroups);
+    group_weights(fmid, 0.5, odds, ninfected, contact_prob, ngroups);
+    group_weights(f1, 1.0, odds, ninfected, contact_prob, ngroups);
+
+    std::vector< Segment > stack;
+    stack.push_back({0.0, 1.0, f0, fmid, f1, {}, 0});
+    simpson(stack.back().whole, 0.0, 1.0, f0, fmid, f1);
+
+    std::vector< double > fl(ngroups), fr(ngroups), left, right;
+    while (stack.size() > 0u)
+    {
+
+        Segment s = std::move(stack.back());
+        stack.pop_back();
+
+        double m  = (s.a + s.b) / 2.0;
+        group_weights(fl, (s.a + m) / 2.0, odds, ninfected, contact_prob, ngroups);
+        group_weights(fr, (m + s.b) / 2.0, odds, ninfected, contact_prob, ngroups);
+
+        double sum_left  = simpson(left, s.a, m, s.fa, fl, s.fm);
+        double sum_right = simpson(right, m, s.b, s.fm, fr, s.fb);
+
+        double sum_whole = 0.0;
+        for (auto & w : s.whole)
+            sum_whole += w;
+
+        if ((s.depth >= 40) ||
+            (std::fabs(sum_left + sum_right - sum_whole) <= 1.5e-9 * (s.b - s.a))
+            )
+        {
+
+            for (size_t g = 0u; g < ngroups; ++g)
+                res[g] += left[g] + right[g];
+
+            continue;
+
+        }
+
+        stack.push_back({s.a, m, s.fa, fl, s.fm, left, s.depth + 1});
+        stack.push_back({m, s.b, s.fm, fr, s.fb, right, s.depth + 1});
+
+    }
+
+}
+
+template<typename TSeq>
+inline void AggregatedInfections<TSeq>::draw(
+    Model<TSeq> * m,
+    epiworld_fast_uint susceptible,
+    epiworld_fast_uint infected,
+    const std::vector< double > & contact_prob,
+    size_t ngroups
+)
+{
+
+    if (m->get_n_tools() > 0u)
+        throw std::logic_error(
+            "Aggregated infections require a model without tools."
+            );
+
+    // Clearing the draws that were not used (e.g., from the previous run)
+    infector.resize(m->size(), -1);
+    for (auto id : marked)
+        if (id < infector.size())
+            infector[id] = -1;
+
+    marked.clear();
+
+    // Transmission probability (must be the same for all)
+    std::vector< size_t > ninfected(ngroups, 0u);
+    double p = -1.0;
+    for (size_t g = 0u; g < ngroups; ++g)
+    {
+
+        const auto & ids = m->get_agents_in_state(infected, g);
+        ninfected[g] = ids.size();
+        for (auto id : ids)
+        {
+
+            auto & agent = m->get_agents()[id];
+            const auto & v = agent.get_virus();
+            if (v == nullptr)
+                throw std::logic_error(
+                    "Aggregated infections found an infected agent without a virus."
+                    );
+
+            double p_i = v->get_prob_infecting(m) *
+                (1.0 - agent.get_transmission_reduction(v, m));
+
+            if (p < 0.0)
+                p = p_i;
+            else if (p_i != p)
+                throw std::logic_error(
+                    "Aggregated infections require a single transmission " +
+                    std::string("probability across infected agents.")
+                    );
+
+        }
+
+    }
+
+    if (p <= 0.0)
+        return;
+
+    double odds = (p >= 1.0) ?
+        std::numeric_limits< double >::infinity() : p / (1.0 - p);
+
+    std::vector< double > weights;
+    std::unordered_set< size_t > chosen;
+    std::vector< size_t > sample;
+    for (size_t a = 0u; a < ngroups; ++a)
+    {
+
+        const auto & susc = m->get_agents_in_state(susceptible, a);
+        if (susc.size() == 0u)
+            continue;
+
+        integrate(weights, odds, ninfected, &contact_prob[a], ngroups);
+
+        double q = 0.0;
+        for (auto & w : weights)
+            q += w;
+
+        if (q <= 0.0)
+            continue;
+
+        int ninfections = m->rbinom(
+            static_cast< int >(susc.size()),
+            std::min(q, 1.0)
+            );
+
+        // Floyd's sampling without replacement
+        chosen.clear();
+        sample.clear();
+        size_t n = susc.size();
+        for (size_t j = n - static_cast< size_t >(ninfections); j < n; ++j)
+        {
+
+            size_t k = static_cast< size_t >(std::floor(m->runif() * (j + 1)));
+            if (k > j)
+                k = j;
+
+            if (!chosen.insert(k).second)
+            {
+                k = j;
+                chosen.insert(k);
+            }
+
+            sample.push_back(k);
+
+        }
+
+        // Assigning the infectors
+        for (auto k : sample)
+        {
+
+            double u = m->runif() * q;
+            size_t g = 0u;
+            while ((g < (ngroups - 1u)) && ((u -= weights[g]) >= 0.0))
+                ++g;
+
+            // Skipping empty groups (possible if u lands at the boundary)
+            while (ninfected[g] == 0u)
+                g = (g + 1u) % ngroups;
+
+            const auto & ids = m->get_agents_in_state(infected, g);
+            size_t which = static_cast< size_t >(
+                std::floor(m->runif() * ids.size())
+                );
+
+            if (which >= ids.size())
+                which = ids.size() - 1u;
+
+            infector[susc[k]] = static_cast< int >(ids[which]);
+            marked.push_back(susc[k]);
+
+        }
+
+    }
+
+}
+
+template<typename TSeq>
+inline Virus<TSeq> * AggregatedInfections<TSeq>::pop_infector(
+    size_t agent_id,
+    Model<TSeq> * m
+)
+{
+
+    if (agent_id >= infector.size())
+        return nullptr;
+
+    int who = infector[agent_id];
+    infector[agent_id] = -1;
+
+    if (who < 0)
+        return nullptr;
+
+    return m->get_agents()[who].get_virus().get();
+
+}
+
+#endif
@@ -85,7 +85,7 @@ inline ModelDiffNet<TSeq>::ModelDiffNet(
 
         // For each one of the possible innovations, we have to compute
         // the adoption probability, which is a function of exposure
-        for (auto & neighbor: agent.get_neighbors())
+        for (auto * neighbor: agent.get_neighbors_view())
         {
 
             if (neighbor->get_state() == ModelDiffNet<TSeq>::ADOPTER)
@@ -167,7 +167,7 @@ inline ModelDiffNet<TSeq>::ModelDiffNet(
     epiworld::Virus<TSeq> innovation(innovation_name, prevalence, true);
     innovation.set_state(1,1,1);
     
-    innovation.set_prob_infecting(&model(parname));
+    innovation.set_prob_infecting(model.get_param_handle(parname));
     
     model.add_virus(innovation);
 
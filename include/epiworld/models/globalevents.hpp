@@ -137,5 +137,37 @@ inline std::function<void(Model<TSeq>*)> globalevent_set_param(
 
     return fun;
 
+}
+
+/**
+ * @brief Global event that updates a parameter in the model.
+ * 
+ * @details Same as `globalevent_set_param(std::string, double)`, but the
+ * parameter is accessed by handle (see `Model::get_param_handle()`), so
+ * there is no lookup by name when the event is triggered.
+ * 
+ * @tparam TSeq Sequence type (should match `TSeq` across the model)
+ * @param param Handle of the parameter to update.
+ * @param value Value to update the parameter to.
+ * @return std::function<void(Model<TSeq>*)> 
+ */
+template<typename TSeq>
+inline std::function<void(Model<TSeq>*)> globalevent_set_param(
+    ParamHandle param,
+    double value
+) {
+
+    std::function<void(Model<TSeq>*)> fun = [value,param](
+        Model<TSeq> * model
+        ) -> void {
+
+        model->set_param(param, value);
+
+        return;
+
+    };
+
+    return fun;
+
 }
 #endif
\ No newline at end of file
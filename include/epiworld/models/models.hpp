@@ -6,6 +6,7 @@ namespace epimodels {
     #include "init-functions.hpp"
 
     #include "globalevents.hpp"
+    #include "aggregated-infections.hpp"
     #include "sis.hpp"
     #include "sir.hpp"
     #include "seir.hpp"
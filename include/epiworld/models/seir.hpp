@@ -60,8 +60,9 @@ public:
         epiworld::Agent<TSeq> * p,
         epiworld::Model<TSeq> * m
     ) -> void {
-        // Does the agent recover?
-        if (m->runif() < (m->par("Recovery rate")))
+        // Does the agent recover? (the virus reads the "Recovery rate"
+        // parameter through a handle)
+        if (m->runif() < (p->get_virus()->get_prob_recovery(m)))
             p->rm_virus(m);
 
         return;    
@@ -78,6 +79,16 @@ public:
         std::vector< int > queue_ = {}
     );
 
+    /**
+     * @name Event-driven transitions
+     * @brief Draws the days in the exposed and infected states when agents
+     * enter them (see `Model::set_state_timer()`)
+     */
+    ///@{
+    ModelSEIR<TSeq> & event_driven_on();
+    ModelSEIR<TSeq> & event_driven_off();
+    ///@}
+
 };
 
 
@@ -107,9 +118,9 @@ inline ModelSEIR<TSeq>::ModelSEIR(
     epiworld::Virus<TSeq> virus(vname, prevalence, true);
     virus.set_state(ModelSEIR<TSeq>::EXPOSED, ModelSEIR<TSeq>::REMOVED, ModelSEIR<TSeq>::REMOVED);
 
-    virus.set_prob_infecting(&model("Transmission rate"));
-    virus.set_incubation(&model("Incubation days"));
-    virus.set_prob_recovery(&model("Recovery rate"));
+    virus.set_prob_infecting(model.get_param_handle("Transmission rate"));
+    virus.set_incubation(model.get_param_handle("Incubation days"));
+    virus.set_prob_recovery(model.get_param_handle("Recovery rate"));
     
     // Adding the tool and the virus
     model.add_virus(virus);
@@ -157,4 +168,41 @@ inline ModelSEIR<TSeq> & ModelSEIR<TSeq>::initial_states(
 
 }
 
+template<typename TSeq>
+inline ModelSEIR<TSeq> & ModelSEIR<TSeq>::event_driven_on()
+{
+
+    // Incubation
+    this->set_state_timer(
+        ModelSEIR<TSeq>::EXPOSED,
+        [](epiworld::Agent<TSeq> * p, epiworld::Model<TSeq> * m) -> int {
+            return m->rgeom(1.0/(p->get_virus()->get_incubation(m)));
+        },
+        [](epiworld::Agent<TSeq> * p, epiworld::Model<TSeq> * m) -> void {
+            p->change_state(m, ModelSEIR<TSeq>::INFECTED);
+        }
+        );
+
+    // Recovery
+    this->set_state_timer(
+        ModelSEIR<TSeq>::INFECTED,
+        [](epiworld::Agent<TSeq> * p, epiworld::Model<TSeq> * m) -> int {
+            return m->rgeom(p->get_virus()->get_prob_recovery(m));
+        },
+        [](epiworld::Agent<TSeq> * p, epiworld::Model<TSeq> * m) -> void {
+            p->rm_virus(m);
+        }
+        );
+
+    return *this;
+
+}
+
+template<typename TSeq>
+inline ModelSEIR<TSeq> & ModelSEIR<TSeq>::event_driven_off()
+{
+    this->state_timers_off();
+    return *this;
+}
+
 #endif
@@ -5,8 +5,9 @@ template<typename TSeq = EPI_DEFAULT_TSEQ>
 class ModelSEIRCONN : public epiworld::Model<TSeq> 
 {
 private:
-    std::vector< epiworld::Agent<TSeq> * > infected;
     void update_infected();
+    ParamHandle par_contact_rate; ///< Handle to "Contact rate".
+    AggregatedInfections<TSeq> aggregated; ///< See `aggregated_infections_on()`
 
 public:
 
@@ -58,7 +59,7 @@ public:
         std::vector< int > queue_ = {}
     );
 
-    size_t get_n_infected() const { return infected.size(); }
+    size_t get_n_infected() const { return this->get_agents_in_state(INFECTED).size(); }
 
     /***
      * @brief Compute expected generation time
@@ -70,29 +71,62 @@ public:
         int max_contacts = 200
     ) const;
 
+    /**
+     * @name Aggregated infections
+     * @brief Draws each day's infections in bulk (see `AggregatedInfections`)
+     * @details Requires a model without tools and a single transmission
+     * probability. Results match the default update in distribution, but
+     * not draw by draw.
+     */
+    ///@{
+    ModelSEIRCONN<TSeq> & aggregated_infections_on()
+    {
+        aggregated.on();
+        this->track_state(SUSCEPTIBLE);
+        return *this;
+    };
+
+    ModelSEIRCONN<TSeq> & aggregated_infections_off()
+    {
+        aggregated.off();
+        return *this;
+    };
+
+    bool is_aggregated_infections_on() const {return aggregated.is_on();};
+    ///@}
+
+    /**
+     * @name Event-driven transitions
+     * @brief Draws the days in the exposed and infected states when agents
+     * enter them (see `Model::set_state_timer()`)
+     */
+    ///@{
+    ModelSEIRCONN<TSeq> & event_driven_on();
+    ModelSEIRCONN<TSeq> & event_driven_off();
+    ///@}
+
 };
 
 template<typename TSeq>
 inline void ModelSEIRCONN<TSeq>::update_infected()
 {
 
-    infected.clear();
-    infected.reserve(this->size());
-
-    for (auto & p : this->get_agents())
-    {
-        if (p.get_state() == ModelSEIRCONN<TSeq>::INFECTED)
-        {
-            infected.push_back(&p);
-        }
-    }
-
+    // The infected agents are tracked by the model (see track_state()),
+    // so only the number of contacts needs updating
     Model<TSeq>::set_rand_binom(
         this->get_n_infected(),
-        static_cast<double>(Model<TSeq>::par("Contact rate"))/
+        static_cast<double>(Model<TSeq>::par(par_contact_rate))/
             static_cast<double>(Model<TSeq>::size())
     );
 
+    if (aggregated.is_on())
+        aggregated.draw(
+            this, SUSCEPTIBLE, INFECTED,
+            {Model<TSeq>::par(par_contact_rate) /
+                static_cast<double>(Model<TSeq>::size())},
+            1u
+            );
+
     return;
 
 }
@@ -162,14 +196,34 @@ inline ModelSEIRCONN<TSeq>::ModelSEIRCONN(
         ) -> void
         {
 
+            // Infections drawn in bulk (see aggregated_infections_on())
+            ModelSEIRCONN<TSeq> * model = static_cast<ModelSEIRCONN<TSeq> *>(m);
+            if (model->aggregated.is_on())
+            {
+
+                Virus<TSeq> * virus = model->aggregated.pop_infector(p->get_id(), m);
+                if (virus != nullptr)
+                    p->set_virus(
+                        *virus,
+                        m,
+                        ModelSEIRCONN<TSeq>::EXPOSED
+                        );
+
+                return;
+
+            }
+
             // Sampling how many individuals
             int ndraw = m->rbinom();
 
             if (ndraw == 0)
                 return;
 
-            ModelSEIRCONN<TSeq> * model = dynamic_cast<ModelSEIRCONN<TSeq> *>(m);
-            size_t ninfected = model->get_n_infected();
+            // Ids of the infected agents (see Model::track_state())
+            const auto & infected = m->get_agents_in_state(
+                ModelSEIRCONN<TSeq>::INFECTED
+                );
+            size_t ninfected = infected.size();
 
             // Drawing from the set
             int nviruses_tmp = 0;
@@ -190,7 +244,7 @@ inline ModelSEIRCONN<TSeq>::ModelSEIRCONN(
                 if (which == static_cast<int>(ninfected))
                     --which;
 
-                epiworld::Agent<TSeq> & neighbor = *model->infected[which];
+                epiworld::Agent<TSeq> & neighbor = m->get_agents()[infected[which]];
 
                 // Can't sample itself
                 if (neighbor.get_id() == p->get_id())
@@ -200,18 +254,18 @@ inline ModelSEIRCONN<TSeq>::ModelSEIRCONN(
                 auto & v = neighbor.get_virus();
 
                 #ifdef EPI_DEBUG
-                if (nviruses_tmp >= static_cast<int>(m->array_virus_tmp.size()))
+                if (nviruses_tmp >= static_cast<int>(m->get_array_virus_tmp().size()))
                     throw std::logic_error("Trying to add an extra element to a temporal array outside of the range.");
                 #endif
                     
                 /* And it is a function of susceptibility_reduction as well */ 
-                m->array_double_tmp[nviruses_tmp] =
+                m->get_array_double_tmp()[nviruses_tmp] =
                     (1.0 - p->get_susceptibility_reduction(v, m)) * 
                     v->get_prob_infecting(m) * 
                     (1.0 - neighbor.get_transmission_reduction(v, m)) 
                     ; 
             
-                m->array_virus_tmp[nviruses_tmp++] = &(*v);
+                m->get_array_virus_tmp()[nviruses_tmp++] = &(*v);
 
             }
 
@@ -226,7 +280,7 @@ inline ModelSEIRCONN<TSeq>::ModelSEIRCONN(
                 return;
 
             p->set_virus(
-                *m->array_virus_tmp[which],
+                *m->get_array_virus_tmp()[which],
                 m,
                 ModelSEIRCONN<TSeq>::EXPOSED
                 );
@@ -266,7 +320,7 @@ inline ModelSEIRCONN<TSeq>::ModelSEIRCONN(
                 const auto & v = p->get_virus();
 
                 // Recover
-                m->array_double_tmp[n_events++] = 
+                m->get_array_double_tmp()[n_events++] = 
                     1.0 - (1.0 - v->get_prob_recovery(m)) * (1.0 - p->get_recovery_enhancer(v, m)); 
 
                 #ifdef EPI_DEBUG
@@ -307,6 +361,7 @@ inline ModelSEIRCONN<TSeq>::ModelSEIRCONN(
     model.add_param(transmission_rate, "Prob. Transmission");
     model.add_param(recovery_rate, "Prob. Recovery");
     model.add_param(avg_incubation_days, "Avg. Incubation days");
+    model.par_contact_rate = model.get_param_handle("Contact rate");
     
     // state
     model.add_state("Susceptible", update_susceptible);
@@ -320,7 +375,7 @@ inline ModelSEIRCONN<TSeq>::ModelSEIRCONN(
         ) -> void
         {
 
-            ModelSEIRCONN<TSeq> * model = dynamic_cast<ModelSEIRCONN<TSeq> *>(m);
+            ModelSEIRCONN<TSeq> * model = static_cast<ModelSEIRCONN<TSeq> *>(m);
 
             model->update_infected();
 
@@ -329,6 +384,7 @@ inline ModelSEIRCONN<TSeq>::ModelSEIRCONN(
         };
 
     model.add_globalevent(update, "Update infected individuals");
+    model.track_state(ModelSEIRCONN<TSeq>::INFECTED);
 
 
     // Preparing the virus -------------------------------------------
@@ -339,9 +395,9 @@ inline ModelSEIRCONN<TSeq>::ModelSEIRCONN(
         ModelSEIRCONN<TSeq>::RECOVERED
         );
 
-    virus.set_prob_infecting(&model("Prob. Transmission"));
-    virus.set_prob_recovery(&model("Prob. Recovery"));
-    virus.set_incubation(&model("Avg. Incubation days"));
+    virus.set_prob_infecting(model.get_param_handle("Prob. Transmission"));
+    virus.set_prob_recovery(model.get_param_handle("Prob. Recovery"));
+    virus.set_incubation(model.get_param_handle("Avg. Incubation days"));
 
     model.add_virus(virus);
 
@@ -455,4 +511,45 @@ inline std::vector< double > ModelSEIRCONN<TSeq>::generation_time_expected(
 
 }
 
+template<typename TSeq>
+inline ModelSEIRCONN<TSeq> & ModelSEIRCONN<TSeq>::event_driven_on()
+{
+
+    // Incubation
+    this->set_state_timer(
+        ModelSEIRCONN<TSeq>::EXPOSED,
+        [](epiworld::Agent<TSeq> * p, epiworld::Model<TSeq> * m) -> int {
+            return m->rgeom(1.0/(p->get_virus()->get_incubation(m)));
+        },
+        [](epiworld::Agent<TSeq> * p, epiworld::Model<TSeq> * m) -> void {
+            p->change_state(m, ModelSEIRCONN<TSeq>::INFECTED);
+        }
+        );
+
+    // Recovery
+    this->set_state_timer(
+        ModelSEIRCONN<TSeq>::INFECTED,
+        [](epiworld::Agent<TSeq> * p, epiworld::Model<TSeq> * m) -> int {
+            const auto & v = p->get_virus();
+            return m->rgeom(
+                1.0 - (1.0 - v->get_prob_recovery(m)) *
+                    (1.0 - p->get_recovery_enhancer(v, m))
+                );
+        },
+        [](epiworld::Agent<TSeq> * p, epiworld::Model<TSeq> * m) -> void {
+            p->rm_virus(m);
+        }
+        );
+
+    return *this;
+
+}
+
+template<typename TSeq>
+inline ModelSEIRCONN<TSeq> & ModelSEIRCONN<TSeq>::event_driven_off()
+{
+    this->state_timers_off();
+    return *this;
+}
+
 #endif
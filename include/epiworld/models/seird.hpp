@@ -84,11 +84,11 @@ public:
     const auto & v = p->get_virus();
       
     // Die
-    m->array_double_tmp[n_events++] = 
+    m->get_array_double_tmp()[n_events++] = 
       v->get_prob_death(m) * (1.0 - p->get_death_reduction(v, m)); 
     
     // Recover
-    m->array_double_tmp[n_events++] = 
+    m->get_array_double_tmp()[n_events++] = 
       1.0 - (1.0 - v->get_prob_recovery(m)) * (1.0 - p->get_recovery_enhancer(v, m)); 
     
     
@@ -171,10 +171,10 @@ inline ModelSEIRD<TSeq>::ModelSEIRD(
   epiworld::Virus<TSeq> virus(vname, prevalence, true);
   virus.set_state(ModelSEIRD<TSeq>::EXPOSED, ModelSEIRD<TSeq>::REMOVED, ModelSEIRD<TSeq>::DECEASED);
   
-  virus.set_prob_infecting(&model("Transmission rate"));
-  virus.set_incubation(&model("Incubation days"));
-  virus.set_prob_death(&model("Death rate"));
-  virus.set_prob_recovery(&model("Recovery rate"));
+  virus.set_prob_infecting(model.get_param_handle("Transmission rate"));
+  virus.set_incubation(model.get_param_handle("Incubation days"));
+  virus.set_prob_death(model.get_param_handle("Death rate"));
+  virus.set_prob_recovery(model.get_param_handle("Recovery rate"));
   
   // Adding the tool and the virus
   model.add_virus(virus);
@@ -5,8 +5,9 @@ template<typename TSeq = EPI_DEFAULT_TSEQ>
 class ModelSEIRDCONN : public epiworld::Model<TSeq> 
 {
 private:
-    std::vector< epiworld::Agent<TSeq> * > infected;
     void update_infected();
+    ParamHandle par_contact_rate; ///< Handle to "Contact rate".
+    AggregatedInfections<TSeq> aggregated; ///< See `aggregated_infections_on()`
 
 public:
 
@@ -63,31 +64,55 @@ public:
 
     size_t get_n_infected() const
     {
-        return infected.size();
+        return this->get_agents_in_state(INFECTED).size();
     }
 
+    /**
+     * @name Aggregated infections
+     * @brief Draws each day's infections in bulk (see `AggregatedInfections`)
+     * @details Requires a model without tools and a single transmission
+     * probability. Results match the default update in distribution, but
+     * not draw by draw.
+     */
+    ///@{
+    ModelSEIRDCONN<TSeq> & aggregated_infections_on()
+    {
+        aggregated.on();
+        this->track_state(SUSCEPTIBLE);
+        return *this;
+    };
+
+    ModelSEIRDCONN<TSeq> & aggregated_infections_off()
+    {
+        aggregated.off();
+        return *this;
+    };
+
+    bool is_aggregated_infections_on() const {return aggregated.is_on();};
+    ///@}
+
 };
 
 template<typename TSeq>
 inline void ModelSEIRDCONN<TSeq>::update_infected()
 {
-    infected.clear();
-    infected.reserve(this->size());
-
-    for (auto & p : this->get_agents())
-    {
-        if (p.get_state() == ModelSEIRDCONN<TSeq>::INFECTED)
-        {
-            infected.push_back(&p);
-        }
-    }
 
+    // The infected agents are tracked by the model (see track_state()),
+    // so only the number of contacts needs updating
     Model<TSeq>::set_rand_binom(
         this->get_n_infected(),
-        static_cast<double>(Model<TSeq>::par("Contact rate"))/
+        static_cast<double>(Model<TSeq>::par(par_contact_rate))/
             static_cast<double>(Model<TSeq>::size())
     );
 
+    if (aggregated.is_on())
+        aggregated.draw(
+            this, SUSCEPTIBLE, INFECTED,
+            {Model<TSeq>::par(par_contact_rate) /
+                static_cast<double>(Model<TSeq>::size())},
+            1u
+            );
+
     return; 
 }
 
@@ -159,17 +184,34 @@ inline ModelSEIRDCONN<TSeq>::ModelSEIRDCONN(
         ) -> void
         {
 
+            // Infections drawn in bulk (see aggregated_infections_on())
+            ModelSEIRDCONN<TSeq> * model = static_cast<ModelSEIRDCONN<TSeq> *>(m);
+            if (model->aggregated.is_on())
+            {
+
+                Virus<TSeq> * virus = model->aggregated.pop_infector(p->get_id(), m);
+                if (virus != nullptr)
+                    p->set_virus(
+                        *virus,
+                        m,
+                        ModelSEIRDCONN<TSeq>::EXPOSED
+                        );
+
+                return;
+
+            }
+
             // Sampling how many individuals
             int ndraw = m->rbinom();
 
             if (ndraw == 0)
                 return;
 
-            ModelSEIRDCONN<TSeq> * model = dynamic_cast<ModelSEIRDCONN<TSeq> *>(
-                m
+            // Ids of the infected agents (see Model::track_state())
+            const auto & infected = m->get_agents_in_state(
+                ModelSEIRDCONN<TSeq>::INFECTED
                 );
-
-            size_t ninfected = model->get_n_infected();
+            size_t ninfected = infected.size();
 
             // Drawing from the set
             int nviruses_tmp = 0;
@@ -190,7 +232,7 @@ inline ModelSEIRDCONN<TSeq>::ModelSEIRDCONN(
                 if (which == static_cast<int>(ninfected))
                     --which;
 
-                epiworld::Agent<TSeq> & neighbor = *model->infected[which];
+                epiworld::Agent<TSeq> & neighbor = m->get_agents()[infected[which]];
 
                 // Can't sample itself
                 if (neighbor.get_id() == p->get_id())
@@ -200,18 +242,18 @@ inline ModelSEIRDCONN<TSeq>::ModelSEIRDCONN(
                 const auto & v = neighbor.get_virus();
             
                 #ifdef EPI_DEBUG
-                if (nviruses_tmp >= static_cast<int>(m->array_virus_tmp.size()))
+                if (nviruses_tmp >= static_cast<int>(m->get_array_virus_tmp().size()))
                     throw std::logic_error("Trying to add an extra element to a temporal array outside of the range.");
                 #endif
                     
                 /* And it is a function of susceptibility_reduction as well */ 
-                m->array_double_tmp[nviruses_tmp] =
+                m->get_array_double_tmp()[nviruses_tmp] =
                     (1.0 - p->get_susceptibility_reduction(v, m)) * 
                     v->get_prob_infecting(m) * 
                     (1.0 - neighbor.get_transmission_reduction(v, m)) 
                     ; 
             
-                m->array_virus_tmp[nviruses_tmp++] = &(*v);
+                m->get_array_virus_tmp()[nviruses_tmp++] = &(*v);
             }
 
             // No virus to compute
@@ -225,7 +267,7 @@ inline ModelSEIRDCONN<TSeq>::ModelSEIRDCONN(
                 return;
 
             p->set_virus(
-                *m->array_virus_tmp[which],
+                *m->get_array_virus_tmp()[which],
                 m,
                 ModelSEIRDCONN<TSeq>::EXPOSED
                 );
@@ -264,11 +306,11 @@ inline ModelSEIRDCONN<TSeq>::ModelSEIRDCONN(
                 const auto & v = p->get_virus();
                 
                 // Die
-                m->array_double_tmp[n_events++] = 
+                m->get_array_double_tmp()[n_events++] = 
                     v->get_prob_death(m) * (1.0 - p->get_death_reduction(v, m)); 
                 
                 // Recover
-                m->array_double_tmp[n_events++] = 
+                m->get_array_double_tmp()[n_events++] = 
                     1.0 - (1.0 - v->get_prob_recovery(m)) * (1.0 - p->get_recovery_enhancer(v, m)); 
                                 
                 #ifdef EPI_DEBUG
@@ -319,6 +361,7 @@ inline ModelSEIRDCONN<TSeq>::ModelSEIRDCONN(
     model.add_param(recovery_rate, "Prob. Recovery");
     model.add_param(avg_incubation_days, "Avg. Incubation days");
     model.add_param(death_rate, "Death rate");
+    model.par_contact_rate = model.get_param_handle("Contact rate");
     
     // state
     model.add_state("Susceptible", update_susceptible);
@@ -331,13 +374,14 @@ inline ModelSEIRDCONN<TSeq>::ModelSEIRDCONN(
     // Adding update function
     epiworld::GlobalFun<TSeq> update = [](epiworld::Model<TSeq> * m) -> void
     {
-        ModelSEIRDCONN<TSeq> * model = dynamic_cast<ModelSEIRDCONN<TSeq> *>(m);
+        ModelSEIRDCONN<TSeq> * model = static_cast<ModelSEIRDCONN<TSeq> *>(m);
         model->update_infected();
         
         return;
     };
 
     model.add_globalevent(update, "Update infected individuals");
+    model.track_state(ModelSEIRDCONN<TSeq>::INFECTED);
 
 
     // Preparing the virus -------------------------------------------
@@ -348,10 +392,10 @@ inline ModelSEIRDCONN<TSeq>::ModelSEIRDCONN(
         ModelSEIRDCONN<TSeq>::DECEASED
         );
 
-    virus.set_prob_infecting(&model("Prob. Transmission"));
-    virus.set_prob_recovery(&model("Prob. Recovery"));
-    virus.set_incubation(&model("Avg. Incubation days"));
-    virus.set_prob_death(&model("Death rate"));
+    virus.set_prob_infecting(model.get_param_handle("Prob. Transmission"));
+    virus.set_prob_recovery(model.get_param_handle("Prob. Recovery"));
+    virus.set_incubation(model.get_param_handle("Avg. Incubation days"));
+    virus.set_prob_death(model.get_param_handle("Death rate"));
     model.add_virus(virus);
 
     model.queuing_off(); // No queuing need
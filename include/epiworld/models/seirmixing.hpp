@@ -9,14 +9,15 @@ template<typename TSeq = EPI_DEFAULT_TSEQ>
 class ModelSEIRMixing : public epiworld::Model<TSeq> 
 {
 private:
-    std::vector< std::vector< epiworld::Agent<TSeq> * > > infected;
     void update_infected();
-    std::vector< epiworld::Agent<TSeq> * > sampled_agents;
     size_t sample_agents(
         epiworld::Agent<TSeq> * agent,
-        std::vector< epiworld::Agent<TSeq> * > & sampled_agents
+        std::vector< int > & sampled_agents
         );
     double adjusted_contact_rate;
+    ParamHandle par_contact_rate; ///< Handle to "Contact rate".
+    AggregatedInfections<TSeq> aggregated; ///< See `aggregated_infections_on()`
+    GroupSampler<TSeq> sampler; ///< Contacts by group (updated daily)
     std::vector< double > contact_matrix;
 
     size_t index(size_t i, size_t j, size_t n) {
@@ -102,7 +103,7 @@ public:
 
     size_t get_n_infected(size_t group) const
     {
-        return infected[group].size();
+        return this->get_agents_in_state(INFECTED, group).size();
     }
 
     void set_contact_matrix(std::vector< double > cmat)
@@ -111,18 +112,38 @@ public:
         return;
     };
 
+    /**
+     * @name Aggregated infections
+     * @brief Draws each day's infections in bulk (see `AggregatedInfections`)
+     * @details Requires a model without tools and a single transmission
+     * probability. Results match the default update in distribution, but
+     * not draw by draw.
+     */
+    ///@{
+    ModelSEIRMixing<TSeq> & aggregated_infections_on()
+    {
+        aggregated.on();
+        this->track_state(SUSCEPTIBLE, true);
+        return *this;
+    };
+
+    ModelSEIRMixing<TSeq> & aggregated_infections_off()
+    {
+        aggregated.off();
+        return *this;
+    };
+
+    bool is_aggregated_infections_on() const {return aggregated.is_on();};
+    ///@}
+
 };
 
 template<typename TSeq>
 inline void ModelSEIRMixing<TSeq>::update_infected()
 {
 
-    auto & agents = Model<TSeq>::get_agents();
     auto & entities = Model<TSeq>::get_entities();
 
-    infected.resize(entities.size());
-    sampled_agents.resize(agents.size());
-
     // Checking contact matrix's rows add to one
     size_t nentities = entities.size();
     if (this->contact_matrix.size() !=  nentities*nentities)
@@ -155,26 +176,30 @@ inline void ModelSEIRMixing<TSeq>::update_infected()
                 );
     }
 
-    for (size_t i = 0; i < entities.size(); ++i)
-    {
-        infected[i].clear();
-        infected[i].reserve(agents.size());
-    }
-    
-    for (auto & a : agents)
+    // Adjusting contact rate
+    adjusted_contact_rate = Model<TSeq>::par(par_contact_rate) /
+        Model<TSeq>::size();
+
+    // The infected agents are tracked by the model by entity (see
+    // track_state()), so there is no need to scan the population
+    std::vector< size_t > ninfected(nentities);
+    for (size_t g = 0u; g < nentities; ++g)
+        ninfected[g] = Model<TSeq>::get_agents_in_state(
+            ModelSEIRMixing<TSeq>::INFECTED, g
+            ).size();
+
+    sampler.update(contact_matrix, ninfected, adjusted_contact_rate);
+
+    if (aggregated.is_on())
     {
 
-        if (a.get_state() == ModelSEIRMixing<TSeq>::INFECTED)
-        {
-            if (a.get_n_entities() > 0u)
-                infected[a.get_entity(0u).get_id()].push_back(&a);
-        }
+        std::vector< double > contact_prob(contact_matrix);
+        for (auto & c : contact_prob)
+            c *= adjusted_contact_rate;
 
-    }
+        aggregated.draw(this, SUSCEPTIBLE, INFECTED, contact_prob, nentities);
 
-    // Adjusting contact rate
-    adjusted_contact_rate = Model<TSeq>::get_param("Contact rate") /
-        agents.size();
+    }
 
     return;
 
@@ -183,50 +208,45 @@ inline void ModelSEIRMixing<TSeq>::update_infected()
 template<typename TSeq>
 inline size_t ModelSEIRMixing<TSeq>::sample_agents(
     epiworld::Agent<TSeq> * agent,
-    std::vector< epiworld::Agent<TSeq> * > & sampled_agents
+    std::vector< int > & sampled_agents
     )
 {
 
     size_t agent_group_id = agent->get_entity(0u).get_id();
-    size_t ngroups = infected.size();
 
+    // How many from each entity? (see GroupSampler)
     int samp_id = 0;
-    for (size_t g = 0; g < infected.size(); ++g)
-    {
+    sampler.sample(this, agent_group_id, [&](size_t g, int nsamples) {
 
-        // How many from this entity?
-        int nsamples = epiworld::Model<TSeq>::rbinom(
-            infected[g].size(),
-            adjusted_contact_rate * contact_matrix[
-                index(agent_group_id, g, ngroups)
-            ]
-        );
-
-        if (nsamples == 0)
-            continue;
+        const auto & infected = Model<TSeq>::get_agents_in_state(
+            ModelSEIRMixing<TSeq>::INFECTED, g
+            );
 
         // Sampling from the entity
         for (int s = 0; s < nsamples; ++s)
         {
 
             // Randomly selecting an agent
-            int which = epiworld::Model<TSeq>::runif() * infected[g].size();
+            int which = epiworld::Model<TSeq>::runif() * infected.size();
 
             // Correcting overflow error
-            if (which >= static_cast<int>(infected[g].size()))
-                which = static_cast<int>(infected[g].size()) - 1;
+            if (which >= static_cast<int>(infected.size()))
+                which = static_cast<int>(infected.size()) - 1;
 
-            auto & a = infected[g][which];
+            size_t a = infected[which];
 
             // Can't sample itself
-            if (a->get_id() == agent->get_id())
+            if (static_cast<int>(a) == agent->get_id())
                 continue;
 
-            sampled_agents[samp_id++] = a;
-            
+            if (samp_id >= static_cast<int>(sampled_agents.size()))
+                sampled_agents.resize(sampled_agents.size() * 2u + 1u);
+
+            sampled_agents[samp_id++] = static_cast<int>(a);
+        
         }
 
-    }
+    });
     
     return samp_id;
 
@@ -306,9 +326,27 @@ inline ModelSEIRMixing<TSeq>::ModelSEIRMixing(
             // Downcasting to retrieve the sampler attached to the
             // class
             ModelSEIRMixing<TSeq> * m_down =
-                dynamic_cast<ModelSEIRMixing<TSeq> *>(m);
+                static_cast<ModelSEIRMixing<TSeq> *>(m);
+
+            // Infections drawn in bulk (see aggregated_infections_on())
+            if (m_down->aggregated.is_on())
+            {
+
+                Virus<TSeq> * virus = m_down->aggregated.pop_infector(p->get_id(), m);
+                if (virus != nullptr)
+                    p->set_virus(
+                        *virus,
+                        m,
+                        ModelSEIRMixing<TSeq>::EXPOSED
+                        );
+
+                return;
+
+            }
 
-            size_t ndraws = m_down->sample_agents(p, m_down->sampled_agents);
+            // Sampled agents' ids (the scratch array is per-thread)
+            auto & sampled_agents = m->get_array_int_tmp();
+            size_t ndraws = m_down->sample_agents(p, sampled_agents);
 
             if (ndraws == 0u)
                 return;
@@ -319,23 +357,24 @@ inline ModelSEIRMixing<TSeq>::ModelSEIRMixing(
             for (size_t n = 0u; n < ndraws; ++n)
             {
 
-                auto & neighbor = m_down->sampled_agents[n];
+                epiworld::Agent<TSeq> * neighbor =
+                    &m->get_agents()[sampled_agents[n]];
 
                 auto & v = neighbor->get_virus();
 
                 #ifdef EPI_DEBUG
-                if (nviruses_tmp >= static_cast<int>(m->array_virus_tmp.size()))
+                if (nviruses_tmp >= static_cast<int>(m->get_array_virus_tmp().size()))
                     throw std::logic_error("Trying to add an extra element to a temporal array outside of the range.");
                 #endif
                     
                 /* And it is a function of susceptibility_reduction as well */ 
-                m->array_double_tmp[nviruses_tmp] =
+                m->get_array_double_tmp()[nviruses_tmp] =
                     (1.0 - p->get_susceptibility_reduction(v, m)) * 
                     v->get_prob_infecting(m) * 
                     (1.0 - neighbor->get_transmission_reduction(v, m)) 
                     ; 
             
-                m->array_virus_tmp[nviruses_tmp++] = &(*v);
+                m->get_array_virus_tmp()[nviruses_tmp++] = &(*v);
 
             }
 
@@ -346,7 +385,7 @@ inline ModelSEIRMixing<TSeq>::ModelSEIRMixing(
                 return;
 
             p->set_virus(
-                *m->array_virus_tmp[which],
+                *m->get_array_virus_tmp()[which],
                 m,
                 ModelSEIRMixing<TSeq>::EXPOSED
                 );
@@ -386,7 +425,7 @@ inline ModelSEIRMixing<TSeq>::ModelSEIRMixing(
                 const auto & v = p->get_virus();
 
                 // Recover
-                m->array_double_tmp[n_events++] = 
+                m->get_array_double_tmp()[n_events++] = 
                     1.0 - (1.0 - v->get_prob_recovery(m)) * (1.0 - p->get_recovery_enhancer(v, m)); 
 
                 #ifdef EPI_DEBUG
@@ -427,6 +466,7 @@ inline ModelSEIRMixing<TSeq>::ModelSEIRMixing(
     model.add_param(transmission_rate, "Prob. Transmission");
     model.add_param(recovery_rate, "Prob. Recovery");
     model.add_param(avg_incubation_days, "Avg. Incubation days");
+    model.par_contact_rate = model.get_param_handle("Contact rate");
     
     // state
     model.add_state("Susceptible", update_susceptible);
@@ -448,6 +488,7 @@ inline ModelSEIRMixing<TSeq>::ModelSEIRMixing(
     };
 
     model.add_globalevent(update, "Update infected individuals");
+    model.track_state(ModelSEIRMixing<TSeq>::INFECTED, true);
 
 
     // Preparing the virus -------------------------------------------
@@ -458,9 +499,9 @@ inline ModelSEIRMixing<TSeq>::ModelSEIRMixing(
         ModelSEIRMixing<TSeq>::RECOVERED
         );
 
-    virus.set_prob_infecting(&model("Prob. Transmission"));
-    virus.set_prob_recovery(&model("Prob. Recovery"));
-    virus.set_incubation(&model("Avg. Incubation days"));
+    virus.set_prob_infecting(model.get_param_handle("Prob. Transmission"));
+    virus.set_prob_recovery(model.get_param_handle("Prob. Recovery"));
+    virus.set_incubation(model.get_param_handle("Avg. Incubation days"));
 
     model.add_virus(virus);
 
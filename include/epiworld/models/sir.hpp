@@ -41,6 +41,29 @@ public:
         std::vector< double > proportions_,
         std::vector< int > queue_ = {}
     );
+
+    /**
+     * @name Event-driven transitions
+     * @brief Draws the recovery day of the agents when they get infected
+     * (see `Model::set_state_timer()`)
+     */
+    ///@{
+    ModelSIR<TSeq> & event_driven_on()
+    {
+        this->set_state_timer(
+            1u,
+            epiworld::default_timer_exposed<TSeq>,
+            epiworld::default_transition_exposed<TSeq>
+            );
+        return *this;
+    };
+
+    ModelSIR<TSeq> & event_driven_off()
+    {
+        this->state_timers_off();
+        return *this;
+    };
+    ///@}
     
 };
 
@@ -67,8 +90,8 @@ inline ModelSIR<TSeq>::ModelSIR(
     epiworld::Virus<TSeq> virus(vname, prevalence, true);
     virus.set_state(1,2,2);
     
-    virus.set_prob_recovery(&model("Recovery rate"));
-    virus.set_prob_infecting(&model("Transmission rate"));
+    virus.set_prob_recovery(model.get_param_handle("Recovery rate"));
+    virus.set_prob_infecting(model.get_param_handle("Transmission rate"));
     
     model.add_virus(virus);
 
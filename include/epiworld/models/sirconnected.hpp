@@ -7,8 +7,9 @@ class ModelSIRCONN : public epiworld::Model<TSeq>
 
 private:
 
-    std::vector< epiworld::Agent<TSeq> * > infected;
     void update_infected();
+    ParamHandle par_contact_rate; ///< Handle to "Contact rate".
+    AggregatedInfections<TSeq> aggregated; ///< See `aggregated_infections_on()`
 
 public:
 
@@ -63,7 +64,7 @@ public:
      */
     size_t get_n_infected() const
     {
-        return infected.size();
+        return this->get_agents_in_state(INFECTED).size();
     }
 
     /***
@@ -76,29 +77,62 @@ public:
         int max_contacts = 200
     ) const;
 
+    /**
+     * @name Aggregated infections
+     * @brief Draws each day's infections in bulk (see `AggregatedInfections`)
+     * @details Requires a model without tools and a single transmission
+     * probability. Results match the default update in distribution, but
+     * not draw by draw.
+     */
+    ///@{
+    ModelSIRCONN<TSeq> & aggregated_infections_on()
+    {
+        aggregated.on();
+        this->track_state(SUSCEPTIBLE);
+        return *this;
+    };
+
+    ModelSIRCONN<TSeq> & aggregated_infections_off()
+    {
+        aggregated.off();
+        return *this;
+    };
+
+    bool is_aggregated_infections_on() const {return aggregated.is_on();};
+    ///@}
+
+    /**
+     * @name Event-driven transitions
+     * @brief Draws the days in the infected state when agents
+     * enter it (see `Model::set_state_timer()`)
+     */
+    ///@{
+    ModelSIRCONN<TSeq> & event_driven_on();
+    ModelSIRCONN<TSeq> & event_driven_off();
+    ///@}
+
 };
 
 template<typename TSeq>
 inline void ModelSIRCONN<TSeq>::update_infected()
 {
 
-    infected.clear();
-    infected.reserve(this->size());
-
-    for (auto & p : this->get_agents())
-    {
-        if (p.get_state() == ModelSIRCONN<TSeq>::INFECTED)
-        {
-            infected.push_back(&p);
-        }
-    }
-
+    // The infected agents are tracked by the model (see track_state()),
+    // so only the number of contacts needs updating
     Model<TSeq>::set_rand_binom(
         this->get_n_infected(),
-        static_cast<double>(Model<TSeq>::par("Contact rate"))/
+        static_cast<double>(Model<TSeq>::par(par_contact_rate))/
             static_cast<double>(Model<TSeq>::size())
     );
 
+    if (aggregated.is_on())
+        aggregated.draw(
+            this, SUSCEPTIBLE, INFECTED,
+            {Model<TSeq>::par(par_contact_rate) /
+                static_cast<double>(Model<TSeq>::size())},
+            1u
+            );
+
     return;
 
 }
@@ -167,13 +201,29 @@ inline ModelSIRCONN<TSeq>::ModelSIRCONN(
         ) -> void
         {
 
+            // Infections drawn in bulk (see aggregated_infections_on())
+            ModelSIRCONN<TSeq> * model = static_cast<ModelSIRCONN<TSeq> *>(m);
+            if (model->aggregated.is_on())
+            {
+
+                Virus<TSeq> * virus = model->aggregated.pop_infector(p->get_id(), m);
+                if (virus != nullptr)
+                    p->set_virus(*virus, m);
+
+                return;
+
+            }
+
             int ndraw = m->rbinom();
 
             if (ndraw == 0)
                 return;
 
-            ModelSIRCONN<TSeq> * model = dynamic_cast<ModelSIRCONN<TSeq> *>(m);
-            size_t ninfected = model->get_n_infected();
+            // Ids of the infected agents (see Model::track_state())
+            const auto & infected = m->get_agents_in_state(
+                ModelSIRCONN<TSeq>::INFECTED
+                );
+            size_t ninfected = infected.size();
 
             // Drawing from the set
             int nviruses_tmp = 0;
@@ -194,7 +244,7 @@ inline ModelSIRCONN<TSeq>::ModelSIRCONN(
                 if (which == static_cast<int>(ninfected))
                     --which;
 
-                epiworld::Agent<TSeq> & neighbor = *model->infected[which];
+                epiworld::Agent<TSeq> & neighbor = m->get_agents()[infected[which]];
 
                 // Can't sample itself
                 if (neighbor.get_id() == p->get_id())
@@ -207,18 +257,18 @@ inline ModelSIRCONN<TSeq>::ModelSIRCONN(
                 auto & v = neighbor.get_virus();
 
                 #ifdef EPI_DEBUG
-                if (nviruses_tmp >= static_cast<int>(m->array_virus_tmp.size()))
+                if (nviruses_tmp >= static_cast<int>(m->get_array_virus_tmp().size()))
                     throw std::logic_error("Trying to add an extra element to a temporal array outside of the range.");
                 #endif
                     
                 /* And it is a function of susceptibility_reduction as well */ 
-                m->array_double_tmp[nviruses_tmp] =
+                m->get_array_double_tmp()[nviruses_tmp] =
                     (1.0 - p->get_susceptibility_reduction(v, m)) * 
                     v->get_prob_infecting(m) * 
                     (1.0 - neighbor.get_transmission_reduction(v, m)) 
                     ; 
             
-                m->array_virus_tmp[nviruses_tmp++] = &(*v);
+                m->get_array_virus_tmp()[nviruses_tmp++] = &(*v);
                  
             }
 
@@ -232,7 +282,7 @@ inline ModelSIRCONN<TSeq>::ModelSIRCONN(
             if (which < 0)
                 return;
 
-            p->set_virus(*m->array_virus_tmp[which], m);
+            p->set_virus(*m->get_array_virus_tmp()[which], m);
 
             return; 
 
@@ -252,7 +302,7 @@ inline ModelSIRCONN<TSeq>::ModelSIRCONN(
                 // Odd: Die, Even: Recover
                 epiworld_fast_uint n_events = 0u;
                 // Recover
-                m->array_double_tmp[n_events++] = 
+                m->get_array_double_tmp()[n_events++] = 
                     1.0 - (1.0 - p->get_virus()->get_prob_recovery(m)) *
                         (1.0 - p->get_recovery_enhancer(p->get_virus(), m)); 
 
@@ -301,23 +351,25 @@ inline ModelSIRCONN<TSeq>::ModelSIRCONN(
     model.add_param(transmission_rate, "Transmission rate");
     model.add_param(recovery_rate, "Recovery rate");
     // model.add_param(prob_reinfection, "Prob. Reinfection");
+    model.par_contact_rate = model.get_param_handle("Contact rate");
 
     // Adding update function
     epiworld::GlobalFun<TSeq> update = [](epiworld::Model<TSeq> * m) -> void
     {
-        ModelSIRCONN<TSeq> * model = dynamic_cast<ModelSIRCONN<TSeq> *>(m);
+        ModelSIRCONN<TSeq> * model = static_cast<ModelSIRCONN<TSeq> *>(m);
         model->update_infected();
         
         return;
     };
 
     model.add_globalevent(update, "Update infected individuals");
+    model.track_state(ModelSIRCONN<TSeq>::INFECTED);
     
     // Preparing the virus -------------------------------------------
     epiworld::Virus<TSeq> virus(vname, prevalence, true);
     virus.set_state(1, 2, 2);
-    virus.set_prob_infecting(&model("Transmission rate"));
-    virus.set_prob_recovery(&model("Recovery rate"));
+    virus.set_prob_infecting(model.get_param_handle("Transmission rate"));
+    virus.set_prob_recovery(model.get_param_handle("Recovery rate"));
 
     model.add_virus(virus);
 
@@ -420,4 +472,34 @@ inline std::vector< double > ModelSIRCONN<TSeq>::generation_time_expected(
 
 }
 
+template<typename TSeq>
+inline ModelSIRCONN<TSeq> & ModelSIRCONN<TSeq>::event_driven_on()
+{
+
+    // Recovery
+    this->set_state_timer(
+        ModelSIRCONN<TSeq>::INFECTED,
+        [](epiworld::Agent<TSeq> * p, epiworld::Model<TSeq> * m) -> int {
+            const auto & v = p->get_virus();
+            return m->rgeom(
+                1.0 - (1.0 - v->get_prob_recovery(m)) *
+                    (1.0 - p->get_recovery_enhancer(v, m))
+                );
+        },
+        [](epiworld::Agent<TSeq> * p, epiworld::Model<TSeq> * m) -> void {
+            p->rm_virus(m);
+        }
+        );
+
+    return *this;
+
+}
+
+template<typename TSeq>
+inline ModelSIRCONN<TSeq> & ModelSIRCONN<TSeq>::event_driven_off()
+{
+    this->state_timers_off();
+    return *this;
+}
+
 #endif
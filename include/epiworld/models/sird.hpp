@@ -80,9 +80,9 @@ inline ModelSIRD<TSeq>::ModelSIRD(
     // Preparing the virus -------------------------------------------
     epiworld::Virus<TSeq> virus(vname, prevalence, true);
     virus.set_state(1,2,3);
-    virus.set_prob_recovery(&model("Recovery rate"));
-    virus.set_prob_infecting(&model("Transmission rate"));
-    virus.set_prob_death(&model("Death rate"));
+    virus.set_prob_recovery(model.get_param_handle("Recovery rate"));
+    virus.set_prob_infecting(model.get_param_handle("Transmission rate"));
+    virus.set_prob_death(model.get_param_handle("Death rate"));
     
     model.add_virus(virus);
 
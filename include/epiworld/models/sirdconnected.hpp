@@ -127,9 +127,16 @@ inline ModelSIRDCONN<TSeq>::ModelSIRDCONN(
     )
 {
 
+    // Setting up parameters
+    model.add_param(contact_rate, "Contact rate");
+    model.add_param(transmission_rate, "Transmission rate");
+    model.add_param(recovery_rate, "Recovery rate");
+    model.add_param(death_rate, "Death rate");
+    // model.add_param(prob_reinfection, "Prob. Reinfection");
 
+    ParamHandle par_contact_rate = model.get_param_handle("Contact rate");
 
-    epiworld::UpdateFun<TSeq> update_susceptible = [](
+    epiworld::UpdateFun<TSeq> update_susceptible = [par_contact_rate](
         epiworld::Agent<TSeq> * p, epiworld::Model<TSeq> * m
         ) -> void
         {
@@ -138,7 +145,7 @@ inline ModelSIRDCONN<TSeq>::ModelSIRDCONN(
             m->set_rand_binom(
                 m->size(),
                 static_cast<double>(
-                    m->par("Contact rate"))/
+                    m->par(par_contact_rate))/
                     static_cast<double>(m->size())
             );
 
@@ -178,18 +185,18 @@ inline ModelSIRDCONN<TSeq>::ModelSIRDCONN(
                     const auto & v = neighbor.get_virus();
                     
                     #ifdef EPI_DEBUG
-                    if (nviruses_tmp >= static_cast<int>(m->array_virus_tmp.size()))
+                    if (nviruses_tmp >= static_cast<int>(m->get_array_virus_tmp().size()))
                         throw std::logic_error("Trying to add an extra element to a temporal array outside of the range.");
                     #endif
                         
                     /* And it is a function of susceptibility_reduction as well */ 
-                    m->array_double_tmp[nviruses_tmp] =
+                    m->get_array_double_tmp()[nviruses_tmp] =
                         (1.0 - p->get_susceptibility_reduction(v, m)) * 
                         v->get_prob_infecting(m) * 
                         (1.0 - neighbor.get_transmission_reduction(v, m)) 
                         ; 
                 
-                    m->array_virus_tmp[nviruses_tmp++] = &(*v);
+                    m->get_array_virus_tmp()[nviruses_tmp++] = &(*v);
 
                 }
             }
@@ -204,7 +211,7 @@ inline ModelSIRDCONN<TSeq>::ModelSIRDCONN(
             if (which < 0)
                 return;
 
-            p->set_virus(*m->array_virus_tmp[which], m);
+            p->set_virus(*m->get_array_virus_tmp()[which], m);
 
             return; 
 
@@ -226,11 +233,11 @@ inline ModelSIRDCONN<TSeq>::ModelSIRDCONN(
                 const auto & v = p->get_virus();
                     
                 // Die
-                m->array_double_tmp[n_events++] = 
+                m->get_array_double_tmp()[n_events++] = 
                 v->get_prob_death(m) * (1.0 - p->get_death_reduction(v, m)); 
                 
                 // Recover
-                m->array_double_tmp[n_events++] = 
+                m->get_array_double_tmp()[n_events++] = 
                 1.0 - (1.0 - v->get_prob_recovery(m)) * (1.0 - p->get_recovery_enhancer(v, m)); 
                 
     #ifdef EPI_DEBUG
@@ -282,19 +289,13 @@ inline ModelSIRDCONN<TSeq>::ModelSIRDCONN(
     model.add_state("Deceased");
       
 
-    // Setting up parameters
-    model.add_param(contact_rate, "Contact rate");
-    model.add_param(transmission_rate, "Transmission rate");
-    model.add_param(recovery_rate, "Recovery rate");
-    model.add_param(death_rate, "Death rate");
-    // model.add_param(prob_reinfection, "Prob. Reinfection");
     
     // Preparing the virus -------------------------------------------
     epiworld::Virus<TSeq> virus(vname, prevalence, true);
     virus.set_state(1, 2, 3);
-    virus.set_prob_infecting(&model("Transmission rate"));
-    virus.set_prob_recovery(&model("Recovery rate"));
-    virus.set_prob_death(&model("Death rate"));
+    virus.set_prob_infecting(model.get_param_handle("Transmission rate"));
+    virus.set_prob_recovery(model.get_param_handle("Recovery rate"));
+    virus.set_prob_death(model.get_param_handle("Death rate"));
     
     model.add_virus(virus);
 
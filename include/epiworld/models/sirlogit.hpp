@@ -215,7 +215,7 @@ inline ModelSIRLogit<TSeq>::ModelSIRLogit(
             for (size_t k = 0u; k < _m->coef_infect_cols.size(); ++k)
                 baseline += p->operator[](k) * _m->coefs_infect[k + 1u];
 
-            for (auto & neighbor: p->get_neighbors()) 
+            for (auto * neighbor: p->get_neighbors_view()) 
             {
                 
                 if (neighbor->get_virus() == nullptr)
@@ -224,12 +224,12 @@ inline ModelSIRLogit<TSeq>::ModelSIRLogit(
                 auto & v = neighbor->get_virus();
 
                 #ifdef EPI_DEBUG
-                if (nviruses_tmp >= m->array_virus_tmp.size())
+                if (nviruses_tmp >= m->get_array_virus_tmp().size())
                     throw std::logic_error("Trying to add an extra element to a temporal array outside of the range.");
                 #endif
                     
                 /* And it is a function of susceptibility_reduction as well */ 
-                m->array_double_tmp[nviruses_tmp] =
+                m->get_array_double_tmp()[nviruses_tmp] =
                     baseline +
                     (1.0 - p->get_susceptibility_reduction(v, m)) * 
                     v->get_prob_infecting(m) * 
@@ -238,10 +238,10 @@ inline ModelSIRLogit<TSeq>::ModelSIRLogit(
                     ; 
 
                 // Applying the plogis function
-                m->array_double_tmp[nviruses_tmp] = 1.0/
-                    (1.0 + std::exp(-m->array_double_tmp[nviruses_tmp]));
+                m->get_array_double_tmp()[nviruses_tmp] = 1.0/
+                    (1.0 + std::exp(-m->get_array_double_tmp()[nviruses_tmp]));
             
-                m->array_virus_tmp[nviruses_tmp++] = &(*v);
+                m->get_array_virus_tmp()[nviruses_tmp++] = &(*v);
 
             }
 
@@ -255,7 +255,7 @@ inline ModelSIRLogit<TSeq>::ModelSIRLogit(
             if (which < 0)
                 return;
 
-            p->set_virus(*m->array_virus_tmp[which], m);
+            p->set_virus(*m->get_array_virus_tmp()[which], m);
 
             return;
 
@@ -306,8 +306,8 @@ inline ModelSIRLogit<TSeq>::ModelSIRLogit(
         ModelSIRLogit<TSeq>::RECOVERED
         );
 
-    virus.set_prob_infecting(&model("Transmission rate"));
-    virus.set_prob_recovery(&model("Recovery rate"));
+    virus.set_prob_infecting(model.get_param_handle("Transmission rate"));
+    virus.set_prob_recovery(model.get_param_handle("Recovery rate"));
 
     // virus.set_prob
 
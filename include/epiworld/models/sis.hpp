@@ -61,8 +61,8 @@ inline ModelSIS<TSeq>::ModelSIS(
     epiworld::Virus<TSeq> virus(vname, prevalence, true);
     virus.set_state(ModelSIS<TSeq>::INFECTED, ModelSIS<TSeq>::SUSCEPTIBLE, ModelSIS<TSeq>::SUSCEPTIBLE);
     
-    virus.set_prob_infecting(&model("Transmission rate"));
-    virus.set_prob_recovery(&model("Recovery rate"));
+    virus.set_prob_infecting(model.get_param_handle("Transmission rate"));
+    virus.set_prob_recovery(model.get_param_handle("Recovery rate"));
     virus.set_prob_death(0.0);
     
     model.add_virus(virus);
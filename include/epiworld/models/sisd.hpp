@@ -64,8 +64,8 @@ inline ModelSISD<TSeq>::ModelSISD(
     epiworld::Virus<TSeq> virus(vname, prevalence, true);
     virus.set_state(1,0,2);
     
-    virus.set_prob_infecting(&model("Transmission rate"));
-    virus.set_prob_recovery(&model("Recovery rate"));
+    virus.set_prob_infecting(model.get_param_handle("Transmission rate"));
+    virus.set_prob_recovery(model.get_param_handle("Recovery rate"));
     virus.set_prob_death(0.01);
     
     model.add_virus(virus);
@@ -115,11 +115,29 @@ inline ModelSURV<TSeq>::ModelSURV(
     )
 {
 
+    // General model parameters
+    model.add_param(latent_period, "Latent period");
+    model.add_param(infect_period, "Infect period");
+    model.add_param(prob_symptoms, "Prob of symptoms");
+    model.add_param(surveillance_prob, "Surveilance prob.");
+    model.add_param(efficacy_vax, "Vax efficacy");
+    model.add_param(prop_vax_redux_transm, "Vax redux transmission");
+    model.add_param(prob_transmission, "Prob of transmission");
+    model.add_param(prob_death, "Prob. death");
+    model.add_param(prob_noreinfect, "Prob. no reinfect");
+
+    // Handles used within the update functions
+    ParamHandle par_latent_period     = model.get_param_handle("Latent period");
+    ParamHandle par_infect_period     = model.get_param_handle("Infect period");
+    ParamHandle par_prob_symptoms     = model.get_param_handle("Prob of symptoms");
+    ParamHandle par_surveillance_prob = model.get_param_handle("Surveilance prob.");
+    ParamHandle par_prob_transmission = model.get_param_handle("Prob of transmission");
+
     EPI_NEW_UPDATEFUN_LAMBDA(surveillance_update_susceptible, TSeq) {
 
         // This computes the prob of getting any neighbor variant
         epiworld_fast_uint nviruses_tmp = 0u;
-        for (auto & neighbor: p->get_neighbors()) 
+        for (auto * neighbor: p->get_neighbors_view()) 
         {
                     
             auto & v = neighbor->get_virus();
@@ -134,8 +152,8 @@ inline ModelSURV<TSeq>::ModelSURV(
                 (1.0 - neighbor->get_transmission_reduction(v, m)) 
                 ; 
         
-            m->array_double_tmp[nviruses_tmp]  = tmp_transmission;
-            m->array_virus_tmp[nviruses_tmp++] = &(*v);
+            m->get_array_double_tmp()[nviruses_tmp]  = tmp_transmission;
+            m->get_array_virus_tmp()[nviruses_tmp++] = &(*v);
         }
 
         // No virus to compute on
@@ -148,14 +166,16 @@ inline ModelSURV<TSeq>::ModelSURV(
         if (which < 0)
             return;
 
-        p->set_virus(*m->array_virus_tmp[which], m); 
+        p->set_virus(*m->get_array_virus_tmp()[which], m); 
         return;
 
     };
 
 
     epiworld::UpdateFun<TSeq> surveillance_update_exposed = 
-    [](epiworld::Agent<TSeq> * p, epiworld::Model<TSeq> * m) -> void
+    [par_latent_period,par_infect_period,par_prob_symptoms](
+        epiworld::Agent<TSeq> * p, epiworld::Model<TSeq> * m
+        ) -> void
     {
 
         epiworld::VirusPtr<TSeq> & v = p->get_virus(); 
@@ -167,11 +187,11 @@ inline ModelSURV<TSeq>::ModelSURV(
         // Figuring out latent period
         if (v->get_data().size() == 0u)
         {
-            epiworld_double latent_days = m->rgamma(m->par("Latent period"), 1.0);
+            epiworld_double latent_days = m->rgamma(m->par(par_latent_period), 1.0);
             v->get_data().push_back(latent_days);
 
             v->get_data().push_back(
-                m->rgamma(m->par("Infect period"), 1.0) + latent_days
+                m->rgamma(m->par(par_infect_period), 1.0) + latent_days
             );
         }
         
@@ -191,7 +211,7 @@ inline ModelSURV<TSeq>::ModelSURV(
         {
 
             // Will be symptomatic?
-            if (EPI_RUNIF() < m->par("Prob of symptoms"))
+            if (EPI_RUNIF() < m->par(par_prob_symptoms))
                 p->change_state(m, ModelSURV<TSeq>::SYMPTOMATIC);
             else
                 p->change_state(m, ModelSURV<TSeq>::ASYMPTOMATIC);
@@ -220,13 +240,13 @@ inline ModelSURV<TSeq>::ModelSURV(
     };
 
     epiworld::GlobalFun<TSeq> surveillance_program = 
-    [exposed_state](
+    [exposed_state,par_surveillance_prob](
         epiworld::Model<TSeq>* m
         ) -> void
     {
 
         // How many will we find
-        std::binomial_distribution<> bdist(m->size(), m->par("Surveilance prob."));
+        std::binomial_distribution<> bdist(m->size(), m->par(par_surveillance_prob));
         int nsampled = bdist(*m->get_rand_endgine());
 
         int to_go = nsampled + 1;
@@ -292,24 +312,13 @@ inline ModelSURV<TSeq>::ModelSURV(
     model.add_state("Recovered");
     model.add_state("Removed");
 
-    // General model parameters
-    model.add_param(latent_period, "Latent period");
-    model.add_param(infect_period, "Infect period");
-    model.add_param(prob_symptoms, "Prob of symptoms");
-    model.add_param(surveillance_prob, "Surveilance prob.");
-    model.add_param(efficacy_vax, "Vax efficacy");
-    model.add_param(prop_vax_redux_transm, "Vax redux transmission");
-    model.add_param(prob_transmission, "Prob of transmission");
-    model.add_param(prob_death, "Prob. death");
-    model.add_param(prob_noreinfect, "Prob. no reinfect");
-
     // Virus ------------------------------------------------------------------
     epiworld::Virus<TSeq> covid("Covid19", prevalence, false);
     covid.set_state(LATENT, RECOVERED, REMOVED);
-    covid.set_post_immunity(&model("Prob. no reinfect"));
-    covid.set_prob_death(&model("Prob. death"));
+    covid.set_post_immunity(model.get_param_handle("Prob. no reinfect"));
+    covid.set_prob_death(model.get_param_handle("Prob. death"));
 
-    epiworld::VirusFun<TSeq> ptransmitfun = [](
+    epiworld::VirusFun<TSeq> ptransmitfun = [par_prob_transmission](
         epiworld::Agent<TSeq> * p,
         epiworld::Virus<TSeq> &,
         epiworld::Model<TSeq> * m
@@ -325,7 +334,7 @@ inline ModelSURV<TSeq>::ModelSURV(
             return static_cast<epiworld_double>(0.0);
 
         // Otherwise
-        return m->par("Prob of transmission");
+        return m->par(par_prob_transmission);
     };
 
     covid.set_prob_infecting_fun(ptransmitfun);
@@ -337,8 +346,8 @@ inline ModelSURV<TSeq>::ModelSURV(
    
     // Vaccine tool -----------------------------------------------------------
     epiworld::Tool<TSeq> vax("Vaccine", prop_vaccinated, true);
-    vax.set_susceptibility_reduction(&model("Vax efficacy"));
-    vax.set_transmission_reduction(&model("Vax redux transmission"));
+    vax.set_susceptibility_reduction(model.get_param_handle("Vax efficacy"));
+    vax.set_transmission_reduction(model.get_param_handle("Vax redux transmission"));
     
     model.add_tool(vax);
 
@@ -0,0 +1,145 @@
+#ifndef EPIWORLD_NEIGHBORS_BONES_HPP
+#define EPIWORLD_NEIGHBORS_BONES_HPP
+
+template<typename TSeq>
+class Agent;
+
+/**
+ * @brief Non-owning view of the neighbors of an agent
+ *
+ * @details
+ * Unlike `Agent::get_neighbors()`, this does not allocate. It holds a pointer
+ * to the (contiguous) array of neighbor ids and resolves each id into the
+ * model's population as it is iterated. Iterating yields `Agent<TSeq> *`,
+ * e.g., `for (auto * neighbor : p->get_neighbors_view())`.
+ *
+ * The view is invalidated by any change in the network (adding or rewiring
+ * ties) or the population.
+ *
+ * @tparam TSeq
+ */
+template<typename TSeq>
+class Neighbors {
+private:
+    const size_t * ids;
+    size_t n;
+    std::vector< Agent<TSeq> > * population;
+
+public:
+
+    /**
+     * @brief Iterator over the neighbors (yields `Agent<TSeq> *`)
+     */
+    class iterator {
+    private:
+        const size_t * id;
+        std::vector< Agent<TSeq> > * population;
+    public:
+
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = Agent<TSeq> *;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = Agent<TSeq> **;
+        using reference         = Agent<TSeq> *;
+
+        iterator(
+            const size_t * id_,
+            std::vector< Agent<TSeq> > * population_
+            ) : id(id_), population(population_) {};
+
+        Agent<TSeq> * operator*() const {
+            return &population->operator[](*id);
+        };
+
+        iterator & operator++() {
+            ++id;
+            return *this;
+        };
+
+        iterator operator++(int) {
+            iterator tmp = *this;
+            ++id;
+            return tmp;
+        };
+
+        bool operator==(const iterator & other) const {
+            return id == other.id;
+        };
+
+        bool operator!=(const iterator & other) const {
+            return id != other.id;
+        };
+
+    };
+
+    Neighbors() = delete;
+    Neighbors(
+        const size_t * ids_,
+        size_t n_,
+        std::vector< Agent<TSeq> > * population_
+        ) : ids(ids_), n(n_), population(population_) {};
+
+    iterator begin() const;
+    iterator end() const;
+
+    Agent<TSeq> * operator()(size_t i) const;
+    Agent<TSeq> * operator[](size_t i) const;
+
+    size_t size() const noexcept;
+    bool empty() const noexcept;
+
+    /**
+     * @brief Id of the i-th neighbor (no bounds check)
+     */
+    size_t get_id(size_t i) const noexcept;
+
+};
+
+template<typename TSeq>
+inline typename Neighbors<TSeq>::iterator Neighbors<TSeq>::begin() const
+{
+    return iterator(ids, population);
+}
+
+template<typename TSeq>
+inline typename Neighbors<TSeq>::iterator Neighbors<TSeq>::end() const
+{
+    return iterator(ids + n, population);
+}
+
+template<typename TSeq>
+inline Agent<TSeq> * Neighbors<TSeq>::operator()(size_t i) const
+{
+
+    if (i >= n)
+        throw std::range_error("Neighbor index out of range.");
+
+    return &population->operator[](ids[i]);
+
+}
+
+template<typename TSeq>
+inline Agent<TSeq> * Neighbors<TSeq>::operator[](size_t i) const
+{
+    return &population->operator[](ids[i]);
+}
+
+template<typename TSeq>
+inline size_t Neighbors<TSeq>::size() const noexcept
+{
+    return n;
+}
+
+template<typename TSeq>
+inline bool Neighbors<TSeq>::empty() const noexcept
+{
+    return n == 0u;
+}
+
+template<typename TSeq>
+inline size_t Neighbors<TSeq>::get_id(size_t i) const noexcept
+{
+    return ids[i];
+}
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef EPIWORLD_NETWORK_CSR_BONES_HPP
+#define EPIWORLD_NETWORK_CSR_BONES_HPP
+
+class AdjList;
+
+/**
+ * @brief Contact network in Compressed Sparse Row (CSR) format
+ *
+ * @details
+ * The network is stored in two contiguous arrays: `offsets` (of size `N + 1`)
+ * and `ids` (of size `offsets[N]`), so the neighbors of vertex `i` are
+ * `ids[offsets[i]], ..., ids[offsets[i + 1] - 1]`. As with the agents'
+ * neighbor lists, ties are stored in both directions, i.e., `j` is a
+ * neighbor of `i` iff `i` is a neighbor of `j`.
+ *
+ * The array `reverse` maps each tie `i -> j` (position in `ids`) to the
+ * position of `j -> i`. It is used to rewire the network while keeping it
+ * symmetric and is built the first time it is needed.
+ */
+class NetworkCSR {
+private:
+
+    std::vector< size_t > offsets;
+    std::vector< size_t > ids;
+    std::vector< size_t > reverse;
+
+    void build_reverse();
+
+    /**
+     * @brief Fills `offsets` and `ids` from a set of ties
+     * 
+     * @param n Number of vertices.
+     * @param for_each_tie Function that receives a function `add(i, j)` and
+     * calls it for each tie. It is called twice (counting and filling).
+     */
+    template<typename TFun>
+    void build(size_t n, TFun for_each_tie);
+
+public:
+
+    NetworkCSR() {};
+
+    /**
+     * @brief Construct a CSR network from an edgelist
+     *
+     * @details Ids are assumed to range from `0` to `size - 1`. Ties are
+     * added in both directions, and duplicated ties are dropped. The
+     * neighbors of each vertex are sorted by id.
+     *
+     * @param source Vector with the source
+     * @param target Vector with the target
+     * @param size Number of vertices in the network.
+     */
+    NetworkCSR(
+        const std::vector< int > & source,
+        const std::vector< int > & target,
+        int size
+        );
+
+    /**
+     * @brief Construct a CSR network from an `AdjList`
+     */
+    NetworkCSR(AdjList & al);
+
+    /**
+     * @brief Construct a CSR network from its arrays
+     *
+     * @param offsets_ Offsets (of size `N + 1`)
+     * @param ids_ Neighbor ids (of size `offsets_[N]`)
+     * @param reverse_ Either empty or the position of the reverse ties.
+     */
+    NetworkCSR(
+        std::vector< size_t > && offsets_,
+        std::vector< size_t > && ids_,
+        std::vector< size_t > && reverse_
+        );
+
+    size_t vcount() const noexcept; ///< Number of vertices.
+    size_t ecount() const noexcept; ///< Number of (directed) ties stored.
+
+    size_t degree(size_t i) const noexcept;
+    const size_t * neighbors(size_t i) const noexcept;
+
+    /**
+     * @brief Position of the `k`-th neighbor of `i` in `ids`
+     * @details With `EPI_DEBUG`, throws if `i` has fewer than `k + 1`
+     * neighbors.
+     */
+    size_t location(size_t i, size_t k) const;
+
+    /**
+     * @brief Position of the reverse of the tie stored at `e`.
+     */
+    size_t get_reverse(size_t e);
+
+    /**
+     * @brief Swaps the ties stored in positions `e0` and `e1`
+     *
+     * @details Equivalent to `Agent::swap_neighbors()`. If `directed` is
+     * `false`, the reverse ties are swapped as well, so
+     * {(i,j), (k,l)} -> {(i,l), (k,j)} and {(j,i), (l,k)} -> {(j,k), (l,i)}.
+     */
+    void swap_ties(size_t e0, size_t e1, bool directed = false);
+
+    const std::vector< size_t > & get_offsets() const;
+    const std::vector< size_t > & get_ids() const;
+
+    bool operator==(const NetworkCSR & other) const;
+    bool operator!=(const NetworkCSR & other) const {return !operator==(other);};
+
+};
+
+#endif
@@ -0,0 +1,287 @@
+#ifndef EPIWORLD_NETWORK_CSR_MEAT_HPP
+#define EPIWORLD_NETWORK_CSR_MEAT_HPP
+
+template<typename TFun>
+inline void NetworkCSR::build(size_t n, TFun for_each_tie)
+{
+
+    // Step 1: Counting the degree (ties go both ways)
+    std::vector< size_t > degree(n, 0u);
+    for_each_tie([&degree](size_t i, size_t j) -> void {
+        degree[i]++;
+        if (i != j)
+            degree[j]++;
+    });
+
+    offsets.assign(n + 1u, 0u);
+    for (size_t i = 0u; i < n; ++i)
+        offsets[i + 1u] = offsets[i] + degree[i];
+
+    // Step 2: Filling the ids (degree is reused as the insertion point)
+    ids.resize(offsets[n]);
+    for (size_t i = 0u; i < n; ++i)
+        degree[i] = offsets[i];
+
+    for_each_tie([&degree, this](size_t i, size_t j) -> void {
+        ids[degree[i]++] = j;
+        if (i != j)
+            ids[degree[j]++] = i;
+    });
+
+    // Step 3: Sorting and removing duplicates, compacting in place
+    size_t e = 0u;
+    for (size_t i = 0u; i < n; ++i)
+    {
+
+        auto start = ids.begin() + offsets[i];
+        auto end   = ids.begin() + offsets[i + 1u];
+        std::sort(start, end);
+        end = std::unique(start, end);
+
+        offsets[i] = e;
+        for (auto it = start; it != end; ++it)
+            ids[e++] = *it;
+
+    }
+
+    offsets[n] = e;
+    ids.resize(e);
+    ids.shrink_to_fit();
+
+    reverse.clear();
+
+}
+
+inline NetworkCSR::NetworkCSR(
+    const std::vector< int > & source,
+    const std::vector< int > & target,
+    int size
+)
+{
+
+    if (source.size() != target.size())
+        throw std::length_error(
+            "The source (" + std::to_string(source.size()) +
+            ") and target (" + std::to_string(target.size()) +
+            ") vectors must have the same length."
+            );
+
+    int max_id = size - 1;
+    for (size_t m = 0u; m < source.size(); ++m)
+    {
+
+        if ((source[m] > max_id) || (source[m] < 0))
+            throw std::range_error(
+                "The source["+std::to_string(m)+"] = " + std::to_string(source[m]) +
+                " is out of range [0, " + std::to_string(max_id) + "]."
+                );
+
+        if ((target[m] > max_id) || (target[m] < 0))
+            throw std::range_error(
+                "The target["+std::to_string(m)+"] = " + std::to_string(target[m]) +
+                " is out of range [0, " + std::to_string(max_id) + "]."
+                );
+
+    }
+
+    build(
+        static_cast< size_t >(size),
+        [&source, &target](auto add) -> void {
+            for (size_t m = 0u; m < source.size(); ++m)
+                add(
+                    static_cast< size_t >(source[m]),
+                    static_cast< size_t >(target[m])
+                    );
+        });
+
+}
+
+inline NetworkCSR::NetworkCSR(AdjList & al)
+{
+
+    const auto & dat = al.get_dat();
+    build(
+        al.vcount(),
+        [&dat](auto add) -> void {
+            for (size_t i = 0u; i < dat.size(); ++i)
+                for (const auto & link : dat[i])
+                    add(i, static_cast< size_t >(link.first));
+        });
+
+}
+
+inline NetworkCSR::NetworkCSR(
+    std::vector< size_t > && offsets_,
+    std::vector< size_t > && ids_,
+    std::vector< size_t > && reverse_
+) : offsets(std::move(offsets_)), ids(std::move(ids_)),
+    reverse(std::move(reverse_))
+{
+
+    if (offsets.size() == 0u)
+        throw std::length_error("The offsets vector must have at least one element.");
+
+    if (offsets.back() != ids.size())
+        throw std::length_error(
+            "The last offset (" + std::to_string(offsets.back()) +
+            ") must match the number of ids (" + std::to_string(ids.size()) +
+            ")."
+            );
+
+    if ((reverse.size() != 0u) && (reverse.size() != ids.size()))
+        throw std::length_error(
+            "The reverse vector must be either empty or of the same length as ids."
+            );
+
+}
+
+inline void NetworkCSR::build_reverse()
+{
+
+    // Ties are matched from the lower to the higher id. `next[j]` keeps
+    // track of the first unmatched entry of j, so when the rows are sorted
+    // (e.g., right after construction) the reverse is found in O(1).
+    reverse.resize(ids.size());
+
+    std::vector< size_t > next(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0u; i < vcount(); ++i)
+    {
+
+        for (size_t e = offsets[i]; e < offsets[i + 1u]; ++e)
+        {
+
+            size_t j = ids[e];
+
+            // Self-ties are their own reverse
+            if (j == i)
+            {
+                reverse[e] = e;
+                continue;
+            }
+
+            // Ties are only matched once (when i < j)
+            if (j < i)
+                continue;
+
+            // Looking for i in j's neighbors
+            size_t e_rev = offsets[j + 1u];
+            for (size_t k = next[j]; k < offsets[j + 1u]; ++k)
+                if (ids[k] == i)
+                {
+                    e_rev = k;
+                    break;
+                }
+
+            if (e_rev == offsets[j + 1u])
+            {
+                for (size_t k = offsets[j]; k < next[j]; ++k)
+                    if (ids[k] == i)
+                    {
+                        e_rev = k;
+                        break;
+                    }
+            }
+
+            if (e_rev == offsets[j + 1u])
+                throw std::logic_error(
+                    "The network is not symmetric: the tie " +
+                    std::to_string(i) + " -> " + std::to_string(j) +
+                    " has no reverse."
+                    );
+
+            reverse[e] = e_rev;
+            reverse[e_rev] = e;
+
+            if (e_rev == next[j])
+                next[j]++;
+
+        }
+
+    }
+
+}
+
+inline size_t NetworkCSR::vcount() const noexcept
+{
+    return offsets.size() == 0u ? 0u : offsets.size() - 1u;
+}
+
+inline size_t NetworkCSR::ecount() const noexcept
+{
+    return ids.size();
+}
+
+inline size_t NetworkCSR::degree(size_t i) const noexcept
+{
+    return offsets[i + 1u] - offsets[i];
+}
+
+inline const size_t * NetworkCSR::neighbors(size_t i) const noexcept
+{
+    return ids.data() + offsets[i];
+}
+
+inline size_t NetworkCSR::location(size_t i, size_t k) const
+{
+
+    #ifdef EPI_DEBUG
+    if ((i + 1u >= offsets.size()) || (k >= degree(i)))
+        throw std::range_error(
+            "[epi-debug] NetworkCSR::location: vertex " + std::to_string(i) +
+            " has no neighbor " + std::to_string(k) + "."
+            );
+    #endif
+
+    return offsets[i] + k;
+
+}
+
+inline size_t NetworkCSR::get_reverse(size_t e)
+{
+
+    if (reverse.size() != ids.size())
+        build_reverse();
+
+    return reverse[e];
+
+}
+
+inline void NetworkCSR::swap_ties(size_t e0, size_t e1, bool directed)
+{
+
+    if (reverse.size() != ids.size())
+        build_reverse();
+
+    size_t e0_rev = reverse[e0];
+    size_t e1_rev = reverse[e1];
+
+    // Changing ids
+    std::swap(ids[e0], ids[e1]);
+
+    if (!directed)
+    {
+        std::swap(ids[e0_rev], ids[e1_rev]);
+
+        // Changing the locations
+        std::swap(reverse[e0], reverse[e1]);
+        std::swap(reverse[e0_rev], reverse[e1_rev]);
+    }
+
+}
+
+inline const std::vector< size_t > & NetworkCSR::get_offsets() const
+{
+    return offsets;
+}
+
+inline const std::vector< size_t > & NetworkCSR::get_ids() const
+{
+    return ids;
+}
+
+inline bool NetworkCSR::operator==(const NetworkCSR & other) const
+{
+    return (offsets == other.offsets) && (ids == other.ids);
+}
+
+#endif
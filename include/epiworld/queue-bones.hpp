@@ -23,7 +23,22 @@ private:
      */
     std::vector< epiworld_fast_int > active;
     Model<TSeq> * model = nullptr;
-    int n_in_queue = 0;
+
+    /**
+     * @name Agents in the queue (count above zero)
+     * @details `members` lists their ids in no particular order, and
+     * `position` is the index of each of them in `members`, so agents are
+     * added and removed in O(1) (by swapping with the last one).
+     */
+    ///@{
+    std::vector< size_t > members;
+    std::vector< size_t > position;
+    std::vector< size_t > sorted;       ///< See `get_active_sorted()`
+    bool has_negative = false;          ///< Whether some count went below zero
+    ///@}
+
+    void add(size_t id);
+    void rm(size_t id);
 
     // Auxiliary variable that checks how many steps
     // left are there
@@ -34,7 +49,26 @@ public:
 
     void operator+=(Agent<TSeq> * p);
     void operator-=(Agent<TSeq> * p);
-    epiworld_fast_int & operator[](epiworld_fast_uint i);
+    epiworld_fast_int operator[](epiworld_fast_uint i) const;
+
+    /**
+     * @brief Adds/removes only the agent (see `OnlySelf`)
+     */
+    ///@{
+    void add_self(Agent<TSeq> * p) {add(p->id);};
+    void rm_self(Agent<TSeq> * p) {rm(p->id);};
+    ///@}
+
+    size_t size() const {return members.size();}; ///< Number of agents in the queue.
+
+    /**
+     * @brief Ids of the agents in the queue, in increasing order
+     * @details Sorts a copy of the list when few agents are in the queue,
+     * and scans the counts otherwise, so daily loops visit the agents in
+     * the same order as a scan of the population at a cost of
+     * O(min(k log k, n)).
+     */
+    const std::vector< size_t > & get_active_sorted();
 
     // void initialize(Model<TSeq> * m, Agent<TSeq> * p);
     void reset();
@@ -49,19 +83,44 @@ public:
 };
 
 template<typename TSeq>
-inline void Queue<TSeq>::operator+=(Agent<TSeq> * p)
+inline void Queue<TSeq>::add(size_t id)
 {
 
-    if (++active[p->id] == 1)
-        n_in_queue++;
+    if (++active[id] != 1)
+        return;
 
-    for (auto n : p->neighbors)
-    {
+    position[id] = members.size();
+    members.push_back(id);
 
-        if (++active[n] == 1)
-            n_in_queue++;
+}
 
-    }
+template<typename TSeq>
+inline void Queue<TSeq>::rm(size_t id)
+{
+
+    epiworld_fast_int count = --active[id];
+    if (count < 0)
+        has_negative = true;
+
+    if (count != 0)
+        return;
+
+    size_t last = members.back();
+    members[position[id]] = last;
+    position[last] = position[id];
+    members.pop_back();
+
+}
+
+template<typename TSeq>
+inline void Queue<TSeq>::operator+=(Agent<TSeq> * p)
+{
+
+    add(p->id);
+
+    const size_t * neighbors = p->get_neighbors_ids();
+    for (size_t i = 0u; i < p->get_n_neighbors(); ++i)
+        add(neighbors[i]);
 
 }
 
@@ -69,38 +128,76 @@ template<typename TSeq>
 inline void Queue<TSeq>::operator-=(Agent<TSeq> * p)
 {
 
-    if (--active[p->id] == 0)
-        n_in_queue--;
+    rm(p->id);
 
-    for (auto n : p->neighbors)
-    {
-        if (--active[n] == 0)
-            n_in_queue--;
-    }
+    const size_t * neighbors = p->get_neighbors_ids();
+    for (size_t i = 0u; i < p->get_n_neighbors(); ++i)
+        rm(neighbors[i]);
 
 }
 
 template<typename TSeq>
-inline epiworld_fast_int & Queue<TSeq>::operator[](epiworld_fast_uint i)
+inline epiworld_fast_int Queue<TSeq>::operator[](epiworld_fast_uint i) const
 {
     return active[i];
 }
 
+template<typename TSeq>
+inline const std::vector< size_t > & Queue<TSeq>::get_active_sorted()
+{
+
+    size_t k = members.size();
+    size_t n = active.size();
+
+    sorted.clear();
+    if (k == 0u)
+        return sorted;
+
+    if ((static_cast< double >(k) * std::log2(static_cast< double >(k))) <
+        static_cast< double >(n))
+    {
+
+        sorted.assign(members.begin(), members.end());
+        std::sort(sorted.begin(), sorted.end());
+
+    } else {
+
+        sorted.reserve(k);
+        for (size_t i = 0u; i < n; ++i)
+            if (active[i] > 0)
+                sorted.push_back(i);
+
+    }
+
+    return sorted;
+
+}
+
 template<typename TSeq>
 inline void Queue<TSeq>::reset()
 {
 
-    if (n_in_queue)
+    // Only the agents in the queue need clearing (unless some count
+    // went negative)
+    if (has_negative)
     {
 
         for (auto & q : this->active)
             q = 0;
 
-        n_in_queue = 0;
-        
+        has_negative = false;
+
+    } else {
+
+        for (auto id : members)
+            active[id] = 0;
+
     }
 
+    members.clear();
+
     active.resize(model->size(), 0);
+    position.resize(model->size(), 0u);
 
 }
 
@@ -28,7 +28,7 @@ inline void rewire_degseq(
     #ifdef EPI_DEBUG
     std::vector< int > _degree0(agents->size(), 0);
     for (size_t i = 0u; i < _degree0.size(); ++i)
-        _degree0[i] = model->get_agents()[i].get_neighbors().size();
+        _degree0[i] = model->get_agents()[i].get_n_neighbors();
     #endif
 
     // Identifying individuals with degree > 0
@@ -38,11 +38,11 @@ inline void rewire_degseq(
     
     for (epiworld_fast_uint i = 0u; i < agents->size(); ++i)
     {
-        if (agents->operator[](i).get_neighbors().size() > 0u)
+        if (agents->operator[](i).get_n_neighbors() > 0u)
         {
             non_isolates.push_back(i);
             epiworld_double wtemp = static_cast<epiworld_double>(
-                agents->operator[](i).get_neighbors().size()
+                agents->operator[](i).get_n_neighbors()
                 );
             weights.push_back(wtemp);
             nedges += wtemp;
@@ -67,24 +67,22 @@ inline void rewire_degseq(
     while (nrewires-- > 0)
     {
 
-        // Picking egos
+        // Picking egos (first i such that prob <= weights[i], or N - 1)
         prob = model->runif();
-        int id0 = N - 1;
-        for (epiworld_fast_uint i = 0u; i < N; ++i)
-            if (prob <= weights[i])
-            {
-                id0 = i;
-                break;
-            }
+        int id0 = static_cast< int >(std::min(
+            static_cast< size_t >(N - 1),
+            static_cast< size_t >(
+                std::lower_bound(weights.begin(), weights.end(), prob) -
+                weights.begin()
+            )));
 
         prob = model->runif();
-        int id1 = N - 1;
-        for (epiworld_fast_uint i = 0u; i < N; ++i)
-            if (prob <= weights[i])
-            {
-                id1 = i;
-                break;
-            }
+        int id1 = static_cast< int >(std::min(
+            static_cast< size_t >(N - 1),
+            static_cast< size_t >(
+                std::lower_bound(weights.begin(), weights.end(), prob) -
+                weights.begin()
+            )));
 
         // Correcting for under or overflow.
         if (id1 == id0)
@@ -104,12 +102,8 @@ inline void rewire_degseq(
         // When rewiring, we need to flip the individuals from the other
         // end as well, since we are dealing withi an undirected graph
         
-        // Finding what neighbour is id0
-        model->get_agents()[id0].swap_neighbors(
-            model->get_agents()[id1],
-            id01,
-            id11
-            );
+        // id0 and id1 are positions in non_isolates, not agent ids
+        p0.swap_neighbors(p1, id01, id11);
         
 
     }
@@ -198,24 +192,22 @@ inline void rewire_degseq(
     while (nrewires-- > 0)
     {
 
-        // Picking egos
+        // Picking egos (first i such that prob <= weights[i], or N - 1)
         prob = model->runif();
-        int id0 = N - 1;
-        for (epiworld_fast_uint i = 0u; i < N; ++i)
-            if (prob <= weights[i])
-            {
-                id0 = i;
-                break;
-            }
+        int id0 = static_cast< int >(std::min(
+            static_cast< size_t >(N - 1),
+            static_cast< size_t >(
+                std::lower_bound(weights.begin(), weights.end(), prob) -
+                weights.begin()
+            )));
 
         prob = model->runif();
-        int id1 = N - 1;
-        for (epiworld_fast_uint i = 0u; i < N; ++i)
-            if (prob <= weights[i])
-            {
-                id1 = i;
-                break;
-            }
+        int id1 = static_cast< int >(std::min(
+            static_cast< size_t >(N - 1),
+            static_cast< size_t >(
+                std::lower_bound(weights.begin(), weights.end(), prob) -
+                weights.begin()
+            )));
 
         // Correcting for under or overflow.
         if (id1 == id0)
@@ -299,21 +291,25 @@ inline AdjList rgraph_bernoulli(
         p
     );
 
-    epiworld_fast_uint m = d(model.get_rand_endgine());
+    epiworld_fast_uint m = d(*model.get_rand_endgine());
 
     source.resize(m);
     target.resize(m);
 
+    // Two draws per tie
+    std::vector< epiworld_double > u(2u * m);
+    model.runif_n(u.data(), u.size());
+
     epiworld_fast_uint a,b;
     for (epiworld_fast_uint i = 0u; i < m; ++i)
     {
-        a = floor(model.runif() * n);
+        a = floor(u[2u * i] * n);
 
         if (!directed)
-            b = floor(model.runif() * a);
+            b = floor(u[2u * i + 1u] * a);
         else
         {
-            b = floor(model.runif() * n);
+            b = floor(u[2u * i + 1u] * n);
             if (b == a)
                 b++;
             
@@ -353,7 +349,7 @@ inline AdjList rgraph_bernoulli2(
     // elements sampled. If n * n, then each diag element has
     // 1/(n^2) chance of sampling
 
-    epiworld_fast_uint m = d(model.get_rand_endgine());
+    epiworld_fast_uint m = d(*model.get_rand_endgine());
 
     source.resize(m);
     target.resize(m);
@@ -418,6 +414,292 @@ inline AdjList rgraph_ring_lattice(
 
 }
 
+/**
+ * @name Edge-array generators
+ * 
+ * @details These write the ties straight into `source` and `target`
+ * (replacing their contents) instead of building an `AdjList`, so the
+ * result can be passed to `Model::agents_from_edgelist()`, which builds the
+ * network without going through `std::map`s.
+ * 
+ * `rgraph_bernoulli_edges()` splits the pairs of vertices into a fixed number
+ * of chunks which are generated in parallel (with OpenMP). Each chunk has its
+ * own `Philox4x32` stream, keyed by a single draw from the model's engine,
+ * and skips over the pairs without a tie by drawing the gap from a geometric
+ * distribution. The result does not depend on the number of threads.
+ * 
+ * `rgraph_smallworld_edges()` rewires the ring lattice by swapping the ends of
+ * pairs of ties picked at random from the edge array. Like `rewire_degseq()`,
+ * the ego is picked with probability proportional to its degree and the alter
+ * uniformly, but each swap takes constant (expected) time. It makes
+ * `floor(p * m / 2)` swaps, where `m` is the number of ties, so about a
+ * proportion `p` of the ties change ends (directed or not). Swaps that would
+ * create a loop or a tie that already exists are skipped, so the degrees of
+ * the lattice are preserved exactly (the CSR would otherwise merge the
+ * duplicated ties), and the proportion rewired is slightly below `p`.
+ * 
+ * @param n Number of vertices.
+ * @param k Number of neighbors in the ring lattice (see
+ * `rgraph_ring_lattice()`).
+ * @param p Probability of a tie (Bernoulli) or proportion of ties to rewire
+ * (small-world).
+ * @param directed Whether the graph is directed.
+ * @param model Model (used as the source of random numbers).
+ * @param source,target Output vectors.
+ */
+///@{
+inline void rgraph_ring_lattice_edges(
+    epiworld_fast_uint n,
+    epiworld_fast_uint k,
+    bool directed,
+    std::vector< int > & source,
+    std::vector< int > & target
+) {
+
+    if ((n - 1u) < k)
+        throw std::logic_error("k can be at most n - 1.");
+
+    if (!directed)
+        if (k > 1u) k = static_cast< size_t >(floor(k / 2.0));
+
+    source.resize(n * k);
+    target.resize(n * k);
+
+    int n_int = static_cast< int >(n);
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(static)
+    #endif
+    for (int i = 0; i < n_int; ++i)
+    {
+
+        size_t e = static_cast< size_t >(i) * k;
+        for (size_t j = 1u; j <= k; ++j)
+        {
+
+            // Next neighbor
+            size_t l = i + j;
+            if (l >= n) l = l - n;
+
+            source[e] = i;
+            target[e] = static_cast< int >(l);
+            ++e;
+
+        }
+
+    }
+
+}
+
+template<typename TSeq>
+inline void rgraph_bernoulli_edges(
+    epiworld_fast_uint n,
+    epiworld_double p,
+    bool directed,
+    Model<TSeq> & model,
+    std::vector< int > & source,
+    std::vector< int > & target
+) {
+
+    source.clear();
+    target.clear();
+
+    // Number of possible ties. Undirected ties are the pairs (i, j) with
+    // j < i, indexed as i * (i - 1) / 2 + j. Directed ones are indexed as
+    // i * (n - 1) + j, skipping j == i.
+    std::uint64_t n64 = static_cast< std::uint64_t >(n);
+    std::uint64_t npairs = (n64 < 2u) ? 0u :
+        (directed ? n64 * (n64 - 1u) : n64 * (n64 - 1u) / 2u);
+
+    // A single draw from the model's engine keys all the chunks
+    std::uint64_t key = static_cast< std::uint64_t >(
+        (*model.get_rand_endgine())()
+        );
+
+    if ((npairs == 0u) || (p <= 0.0))
+        return;
+
+    static const std::uint64_t max_chunks = 256u;
+    std::uint64_t nchunks    = std::min(max_chunks, npairs);
+    std::uint64_t chunk_size = (npairs + nchunks - 1u) / nchunks;
+
+    std::vector< std::vector< std::uint64_t > > chunks(nchunks);
+    double log_q = std::log1p(-static_cast< double >(p));
+
+    int nchunks_int = static_cast< int >(nchunks);
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic)
+    #endif
+    for (int c = 0; c < nchunks_int; ++c)
+    {
+
+        std::uint64_t start = static_cast< std::uint64_t >(c) * chunk_size;
+        std::uint64_t end   = std::min(start + chunk_size, npairs);
+
+        auto & pairs = chunks[c];
+        if (p >= 1.0)
+        {
+            for (std::uint64_t l = start; l < end; ++l)
+                pairs.push_back(l);
+
+            continue;
+        }
+
+        Philox4x32 engine(key, static_cast< std::uint64_t >(c));
+        pairs.reserve(static_cast< size_t >((end - start) * p * 1.1) + 16u);
+
+        // Gaps between ties are Geometric(p). Only the gap is a double: the
+        // position stays exact beyond 2^53 pairs.
+        std::uint64_t pos = start;
+        while (true)
+        {
+
+            // U in (0, 1]
+            std::uint64_t hi = engine() >> 5u;
+            std::uint64_t lo = engine() >> 6u;
+            double u = static_cast< double >(((hi << 26u) | lo) + 1u) *
+                (1.0 / 9007199254740992.0);
+
+            double gap = std::floor(std::log(u) / log_q);
+            if (gap >= static_cast< double >(end - pos))
+                break;
+
+            pos += static_cast< std::uint64_t >(gap);
+            pairs.push_back(pos++);
+
+        }
+
+    }
+
+    // Concatenating in chunk order
+    std::vector< size_t > offsets(nchunks + 1u, 0u);
+    for (size_t c = 0u; c < nchunks; ++c)
+        offsets[c + 1u] = offsets[c] + chunks[c].size();
+
+    source.resize(offsets[nchunks]);
+    target.resize(offsets[nchunks]);
+
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(static)
+    #endif
+    for (int c = 0; c < nchunks_int; ++c)
+    {
+
+        size_t e = offsets[c];
+        for (auto l : chunks[c])
+        {
+
+            std::uint64_t i, j;
+            if (directed)
+            {
+                i = l / (n64 - 1u);
+                j = l % (n64 - 1u);
+                if (j >= i)
+                    ++j;
+            }
+            else
+            {
+                i = static_cast< std::uint64_t >(
+                    (1.0 + std::sqrt(1.0 + 8.0 * static_cast< double >(l))) / 2.0
+                    );
+
+                // Correcting for rounding
+                while ((i * (i - 1u) / 2u) > l)
+                    --i;
+                while (((i + 1u) * i / 2u) <= l)
+                    ++i;
+
+                j = l - i * (i - 1u) / 2u;
+            }
+
+            source[e] = static_cast< int >(i);
+            target[e] = static_cast< int >(j);
+            ++e;
+
+        }
+
+    }
+
+}
+
+template<typename TSeq>
+inline void rgraph_smallworld_edges(
+    epiworld_fast_uint n,
+    epiworld_fast_uint k,
+    epiworld_double p,
+    bool directed,
+    Model<TSeq> & model,
+    std::vector< int > & source,
+    std::vector< int > & target
+) {
+
+    rgraph_ring_lattice_edges(n, k, directed, source, target);
+
+    size_t m = source.size();
+    if (m < 2u)
+        return;
+
+    // Each swap changes the ends of two ties
+    size_t nrewires = static_cast< size_t >(std::floor(p * m / 2.0));
+
+    // Ties in the graph (undirected ones keyed by the sorted pair)
+    auto tie_key = [directed](int a, int b) -> std::uint64_t {
+        if (!directed && (a > b))
+            std::swap(a, b);
+
+        return (static_cast< std::uint64_t >(a) << 32u) |
+            static_cast< std::uint32_t >(b);
+    };
+
+    std::unordered_set< std::uint64_t > ties;
+    ties.reserve(m);
+    for (size_t e = 0u; e < m; ++e)
+        ties.insert(tie_key(source[e], target[e]));
+
+    // Three draws per swap: two ties and the orientation of the second
+    std::vector< epiworld_double > u(3u * nrewires);
+    model.runif_n(u.data(), u.size());
+
+    for (size_t r = 0u; r < nrewires; ++r)
+    {
+
+        size_t e0 = static_cast< size_t >(std::floor(u[3u * r] * m));
+        size_t e1 = static_cast< size_t >(std::floor(u[3u * r + 1u] * (m - 1u)));
+
+        // Correcting for possible overflow, and picking a different tie
+        if (e0 >= m)
+            e0 = m - 1u;
+
+        if (e1 >= e0)
+            e1 = (e1 + 1u < m) ? e1 + 1u : 0u;
+
+        if (e1 == e0)
+            continue;
+
+        // Undirected ties can be used in either direction
+        if (!directed && (u[3u * r + 2u] < 0.5))
+            std::swap(source[e1], target[e1]);
+
+        // {(a, b), (c, d)} -> {(a, d), (c, b)}
+        if ((source[e0] == target[e1]) || (source[e1] == target[e0]))
+            continue;
+
+        std::uint64_t key_0 = tie_key(source[e0], target[e1]);
+        std::uint64_t key_1 = tie_key(source[e1], target[e0]);
+        if ((key_0 == key_1) || ties.count(key_0) || ties.count(key_1))
+            continue;
+
+        ties.erase(tie_key(source[e0], target[e0]));
+        ties.erase(tie_key(source[e1], target[e1]));
+        ties.insert(key_0);
+        ties.insert(key_1);
+
+        std::swap(target[e0], target[e1]);
+
+    }
+
+}
+///@}
+
 /**
  * @brief Smallworld network (Watts-Strogatz)
  * 
@@ -0,0 +1,170 @@
+#ifndef EPIWORLD_RUNAGGREGATOR_BONES_HPP
+#define EPIWORLD_RUNAGGREGATOR_BONES_HPP
+
+/**
+ * @brief Summarizes the replicates of `Model::run_multiple()` in memory
+ *
+ * @details Each call to `add()` folds the history of a model into running
+ * statistics, so the replicates are never written to disk nor kept in
+ * memory. For each (date, state) (and virus, or transition, depending on
+ * what is aggregated) it keeps the number of replicates, the sum, the sum
+ * of squares, and a `QuantileSketch`. Sums of counts are exact, so, as with
+ * the quantiles, the results do not depend on the order in which the
+ * replicates are added. The average reproductive numbers are not integers,
+ * so they are kept (one number per replicate, virus, and date) and summed
+ * in the order of the replicates' indices when they are read.
+ *
+ * `add()` can be called from several threads at the same time. Use
+ * `make_aggregate_run()` to get a function to pass to `run_multiple()`:
+ *
+ * ```cpp
+ * auto agg = std::make_shared< RunAggregator<> >();
+ * model.run_multiple(100, 1000, 123, make_aggregate_run(agg));
+ * agg->get_hist_total(&date, &state, &mean, &var, &quantiles);
+ * ```
+ *
+ * @tparam TSeq
+ */
+template<typename TSeq = int>
+class RunAggregator {
+private:
+
+    struct Stats {
+        size_t n = 0u;
+        epiworld_double sum  = 0.0;
+        epiworld_double sum2 = 0.0;
+        QuantileSketch sketch;
+
+        Stats(epiworld_double alpha) : sketch(alpha) {};
+        void add(epiworld_double x);
+    };
+
+    bool do_total;
+    bool do_virus;
+    bool do_transition;
+    bool do_reproductive;
+    epiworld_double alpha;
+
+    size_t nreplicates = 0u;
+    std::vector< std::string > states;
+    std::vector< int > dates;                       ///< Date of each step
+    std::vector< Stats > total;                     ///< By (step, state)
+    std::map< int, std::vector< Stats > > virus;    ///< By virus, then (step, state)
+    std::vector< Stats > transition;                ///< By (step, to, from)
+
+    /// By (virus, date), the (replicate, average R) of each replicate
+    std::map<
+        std::pair< int, int >,
+        std::vector< std::pair< size_t, epiworld_double > >
+        > reproductive;
+
+    mutable std::mutex mtx;
+
+    void grow(std::vector< Stats > & x, size_t n) const;
+
+    /**
+     * @brief Appends the mean, variance, and quantiles of `s`
+     */
+    void summarize(
+        const Stats & s,
+        std::vector< epiworld_double > * mean,
+        std::vector< epiworld_double > * var,
+        std::vector< epiworld_double > * quantiles,
+        const std::vector< epiworld_double > & probs
+    ) const;
+
+public:
+
+    /**
+     * @param total,virus,transition,reproductive What to aggregate: the
+     * counts by state (`DataBase::get_hist_total()`), the counts by virus and
+     * state (`DataBase::get_hist_virus()`), the transition counts
+     * (`DataBase::get_hist_transition_matrix()`), and the average
+     * reproductive number of the cases of each date
+     * (`DataBase::reproductive_number()`).
+     * @param alpha Relative accuracy of the quantiles.
+     */
+    RunAggregator(
+        bool total = true,
+        bool virus = false,
+        bool transition = false,
+        bool reproductive = false,
+        epiworld_double alpha = 0.01
+    );
+
+    RunAggregator(const RunAggregator<TSeq> &) = delete;
+    RunAggregator<TSeq> & operator=(const RunAggregator<TSeq> &) = delete;
+
+    /**
+     * @brief Adds the results of the last run of `m`
+     * @param replicate Index of the replicate (as passed by
+     * `run_multiple()`). If negative, the number of replicates added so
+     * far is used.
+     */
+    void add(const Model<TSeq> & m, int replicate = -1);
+
+    size_t get_n_replicates() const;
+
+    /**
+     * @name Summaries across replicates
+     *
+     * @details Each row is a combination of the keys (e.g., date and
+     * state). Statistics only include the replicates where the row exists
+     * (e.g., a virus that appeared in some replicates only). The variance
+     * is `NaN` with fewer than two replicates.
+     *
+     * @param mean,var Mean and (sample) variance of each row.
+     * @param quantiles If not `nullptr`, the quantiles `probs` of each row
+     * (row major, `probs.size()` values per row).
+     */
+    ///@{
+    void get_hist_total(
+        std::vector< int > * date,
+        std::vector< std::string > * state,
+        std::vector< epiworld_double > * mean,
+        std::vector< epiworld_double > * var,
+        std::vector< epiworld_double > * quantiles = nullptr,
+        std::vector< epiworld_double > probs = {0.025, 0.5, 0.975}
+    ) const;
+
+    void get_hist_virus(
+        std::vector< int > * date,
+        std::vector< int > * id,
+        std::vector< std::string > * state,
+        std::vector< epiworld_double > * mean,
+        std::vector< epiworld_double > * var,
+        std::vector< epiworld_double > * quantiles = nullptr,
+        std::vector< epiworld_double > probs = {0.025, 0.5, 0.975}
+    ) const;
+
+    void get_hist_transition_matrix(
+        std::vector< int > * date,
+        std::vector< std::string > * state_from,
+        std::vector< std::string > * state_to,
+        std::vector< epiworld_double > * mean,
+        std::vector< epiworld_double > * var,
+        std::vector< epiworld_double > * quantiles = nullptr,
+        std::vector< epiworld_double > probs = {0.025, 0.5, 0.975}
+    ) const;
+
+    void get_reproductive_number(
+        std::vector< int > * virus_id,
+        std::vector< int > * date,
+        std::vector< epiworld_double > * mean,
+        std::vector< epiworld_double > * var,
+        std::vector< epiworld_double > * quantiles = nullptr,
+        std::vector< epiworld_double > probs = {0.025, 0.5, 0.975}
+    ) const;
+    ///@}
+
+};
+
+/**
+ * @brief Function for `run_multiple()` adding each replicate to `agg`
+ */
+template<typename TSeq = int>
+inline std::function<void(size_t,Model<TSeq>*)> make_aggregate_run(
+    std::shared_ptr< RunAggregator<TSeq> > agg
+);
+
+#endif
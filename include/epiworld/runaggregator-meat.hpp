@@ -0,0 +1,365 @@
+#ifndef EPIWORLD_RUNAGGREGATOR_MEAT_HPP
+#define EPIWORLD_RUNAGGREGATOR_MEAT_HPP
+
+template<typename TSeq>
+inline void RunAggregator<TSeq>::Stats::add(epiworld_double x)
+{
+    ++n;
+    sum  += x;
+    sum2 += x * x;
+    sketch.add(x);
+}
+
+template<typename TSeq>
+inline RunAggregator<TSeq>::RunAggregator(
+    bool total,
+    bool virus,
+    bool transition,
+    bool reproductive,
+    epiworld_double alpha
+) : do_total(total), do_virus(virus), do_transition(transition),
+    do_reproductive(reproductive), alpha(alpha)
+{
+
+    // Fails early if alpha is out of range
+    QuantileSketch check(alpha);
+
+}
+
+template<typename TSeq>
+inline void RunAggregator<TSeq>::grow(
+    std::vector< Stats > & x,
+    size_t n
+) const
+{
+
+    while (x.size() < n)
+        x.emplace_back(alpha);
+
+}
+
+template<typename TSeq>
+inline void RunAggregator<TSeq>::add(const Model<TSeq> & m, int replicate)
+{
+
+    const DataBase<TSeq> & db = m.get_db();
+
+    size_t nsteps = db.hist_date.size();
+    size_t ns     = m.get_states().size();
+
+    // The reproductive number is computed before locking
+    std::map< std::pair< int, int >, std::pair< epiworld_double, int > > rt;
+    if (do_reproductive)
+    {
+
+        std::vector< int > virus_id, source, date, counts;
+        db.reproductive_number(virus_id, source, date, counts);
+
+        for (size_t i = 0u; i < counts.size(); ++i)
+        {
+            auto & cell = rt[std::make_pair(virus_id[i], date[i])];
+            cell.first += static_cast< epiworld_double >(counts[i]);
+            cell.second++;
+        }
+
+    }
+
+    std::lock_guard< std::mutex > lock(mtx);
+
+    size_t index = (replicate < 0) ?
+        nreplicates : static_cast< size_t >(replicate);
+
+    ++nreplicates;
+
+    if (states.size() == 0u)
+        states = m.get_states();
+
+    for (size_t k = dates.size(); k < nsteps; ++k)
+        dates.push_back(db.hist_date[k]);
+
+    if (do_total)
+    {
+
+        grow(total, nsteps * ns);
+        for (size_t i = 0u; i < nsteps * ns; ++i)
+            total[i].add(db.hist_total_counts[i]);
+
+    }
+
+    if (do_virus)
+    {
+
+        size_t i = 0u;
+        for (size_t k = 0u; k < nsteps; ++k)
+            for (size_t v = 0u; v < db.hist_virus_n(k); ++v)
+            {
+
+                auto & stats = virus[static_cast< int >(v)];
+                grow(stats, (k + 1u) * ns);
+
+                for (size_t s = 0u; s < ns; ++s)
+                    stats[k * ns + s].add(db.hist_virus_counts[i++]);
+
+            }
+
+    }
+
+    if (do_transition)
+    {
+
+        size_t n = db.hist_transition_matrix.size();
+        grow(transition, n);
+        for (size_t i = 0u; i < n; ++i)
+            transition[i].add(db.hist_transition_matrix[i]);
+
+    }
+
+    for (const auto & r : rt)
+        reproductive[r.first].emplace_back(
+            index, r.second.first / r.second.second
+            );
+
+}
+
+template<typename TSeq>
+inline size_t RunAggregator<TSeq>::get_n_replicates() const
+{
+
+    std::lock_guard< std::mutex > lock(mtx);
+    return nreplicates;
+
+}
+
+template<typename TSeq>
+inline void RunAggregator<TSeq>::summarize(
+    const Stats & s,
+    std::vector< epiworld_double > * mean,
+    std::vector< epiworld_double > * var,
+    std::vector< epiworld_double > * quantiles,
+    const std::vector< epiworld_double > & probs
+) const
+{
+
+    epiworld_double n = static_cast< epiworld_double >(s.n);
+
+    if (mean != nullptr)
+        mean->push_back(s.sum / n);
+
+    if (var != nullptr)
+    {
+
+        if (s.n < 2u)
+            var->push_back(std::numeric_limits< epiworld_double >::quiet_NaN());
+        else
+            var->push_back(
+                std::max(0.0, (s.sum2 - s.sum * s.sum / n) / (n - 1.0))
+                );
+
+    }
+
+    if (quantiles != nullptr)
+        for (auto p : probs)
+            quantiles->push_back(s.sketch.quantile(p));
+
+}
+
+template<typename TSeq>
+inline void RunAggregator<TSeq>::get_hist_total(
+    std::vector< int > * date,
+    std::vector< std::string > * state,
+    std::vector< epiworld_double > * mean,
+    std::vector< epiworld_double > * var,
+    std::vector< epiworld_double > * quantiles,
+    std::vector< epiworld_double > probs
+) const
+{
+
+    std::lock_guard< std::mutex > lock(mtx);
+
+    for (auto * v : {mean, var, quantiles})
+        if (v != nullptr)
+            v->clear();
+
+    if (date != nullptr)
+        date->clear();
+
+    if (state != nullptr)
+        state->clear();
+
+    size_t ns = states.size();
+    for (size_t i = 0u; i < total.size(); ++i)
+    {
+
+        if (date != nullptr)
+            date->push_back(dates[i / ns]);
+
+        if (state != nullptr)
+            state->push_back(states[i % ns]);
+
+        summarize(total[i], mean, var, quantiles, probs);
+
+    }
+
+}
+
+template<typename TSeq>
+inline void RunAggregator<TSeq>::get_hist_virus(
+    std::vector< int > * date,
+    std::vector< int > * id,
+    std::vector< std::string > * state,
+    std::vector< epiworld_double > * mean,
+    std::vector< epiworld_double > * var,
+    std::vector< epiworld_double > * quantiles,
+    std::vector< epiworld_double > probs
+) const
+{
+
+    std::lock_guard< std::mutex > lock(mtx);
+
+    for (auto * v : {mean, var, quantiles})
+        if (v != nullptr)
+            v->clear();
+
+    if (date != nullptr)
+        date->clear();
+
+    if (id != nullptr)
+        id->clear();
+
+    if (state != nullptr)
+        state->clear();
+
+    size_t ns = states.size();
+    for (const auto & v : virus)
+        for (size_t i = 0u; i < v.second.size(); ++i)
+        {
+
+            // Steps before the virus appeared
+            if (v.second[i].n == 0u)
+                continue;
+
+            if (date != nullptr)
+                date->push_back(dates[i / ns]);
+
+            if (id != nullptr)
+                id->push_back(v.first);
+
+            if (state != nullptr)
+                state->push_back(states[i % ns]);
+
+            summarize(v.second[i], mean, var, quantiles, probs);
+
+        }
+
+}
+
+template<typename TSeq>
+inline void RunAggregator<TSeq>::get_hist_transition_matrix(
+    std::vector< int > * date,
+    std::vector< std::string > * state_from,
+    std::vector< std::string > * state_to,
+    std::vector< epiworld_double > * mean,
+    std::vector< epiworld_double > * var,
+    std::vector< epiworld_double > * quantiles,
+    std::vector< epiworld_double > probs
+) const
+{
+
+    std::lock_guard< std::mutex > lock(mtx);
+
+    for (auto * v : {mean, var, quantiles})
+        if (v != nullptr)
+            v->clear();
+
+    if (date != nullptr)
+        date->clear();
+
+    if (state_from != nullptr)
+        state_from->clear();
+
+    if (state_to != nullptr)
+        state_to->clear();
+
+    // Same order as DataBase::get_hist_transition_matrix()
+    size_t ns = states.size();
+    for (size_t i = 0u; i < transition.size(); ++i)
+    {
+
+        if (date != nullptr)
+            date->push_back(dates[i / (ns * ns)]);
+
+        if (state_from != nullptr)
+            state_from->push_back(states[i % ns]);
+
+        if (state_to != nullptr)
+            state_to->push_back(states[(i / ns) % ns]);
+
+        summarize(transition[i], mean, var, quantiles, probs);
+
+    }
+
+}
+
+template<typename TSeq>
+inline void RunAggregator<TSeq>::get_reproductive_number(
+    std::vector< int > * virus_id,
+    std::vector< int > * date,
+    std::vector< epiworld_double > * mean,
+    std::vector< epiworld_double > * var,
+    std::vector< epiworld_double > * quantiles,
+    std::vector< epiworld_double > probs
+) const
+{
+
+    std::lock_guard< std::mutex > lock(mtx);
+
+    for (auto * v : {mean, var, quantiles})
+        if (v != nullptr)
+            v->clear();
+
+    if (virus_id != nullptr)
+        virus_id->clear();
+
+    if (date != nullptr)
+        date->clear();
+
+    for (const auto & r : reproductive)
+    {
+
+        if (virus_id != nullptr)
+            virus_id->push_back(r.first.first);
+
+        if (date != nullptr)
+            date->push_back(r.first.second);
+
+        // Summing in the order of the replicates, not the order they
+        // finished in
+        auto values = r.second;
+        std::sort(values.begin(), values.end());
+
+        Stats stats(alpha);
+        for (const auto & v : values)
+            stats.add(v.second);
+
+        summarize(stats, mean, var, quantiles, probs);
+
+    }
+
+}
+
+template<typename TSeq>
+inline std::function<void(size_t,Model<TSeq>*)> make_aggregate_run(
+    std::shared_ptr< RunAggregator<TSeq> > agg
+)
+{
+
+    if (!agg)
+        throw std::logic_error("The aggregator -agg- cannot be a nullptr.");
+
+    return [agg](size_t i, Model<TSeq> * m) -> void {
+        agg->add(*m, static_cast< int >(i));
+    };
+
+}
+
+#endif
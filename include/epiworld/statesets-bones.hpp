@@ -0,0 +1,215 @@
+#ifndef EPIWORLD_STATESETS_BONES_HPP
+#define EPIWORLD_STATESETS_BONES_HPP
+
+/**
+ * @brief Sets of agents in a given state, updated as agents change state
+ *
+ * @details Each tracked state keeps the ids of the agents in it, optionally
+ * split by the first entity of the agents (agents without entities are then
+ * left out). The model updates the sets from `Model::events_run()`, so
+ * keeping them costs O(1) per state change instead of a scan of the
+ * population. Agents are removed by swapping them with the last element,
+ * so the order of the sets is arbitrary (but deterministic).
+ *
+ * @tparam TSeq
+ */
+template<typename TSeq>
+class StateSets
+{
+    friend class Model<TSeq>;
+
+private:
+
+    std::vector< int > state_slot;          ///< Slot of each state (-1 if not tracked)
+    std::vector< bool > slot_by_entity;     ///< Whether the slot is split by entity
+    std::vector< std::vector< std::vector< size_t > > > members; ///< [slot][group] agent ids
+
+    std::vector< int > agent_slot;          ///< Slot of each agent (-1 if none)
+    std::vector< size_t > agent_group;      ///< Group of each agent within its slot
+    std::vector< size_t > agent_pos;        ///< Position of each agent within its group
+
+    std::vector< size_t > empty = {};
+
+    void insert(size_t id, int slot, size_t group);
+    void remove(size_t id);
+
+public:
+
+    /**
+     * @brief Adds a state to the tracked ones
+     * @param state The state.
+     * @param by_entity If `true`, the agents are split by their first entity.
+     */
+    void track(epiworld_fast_uint state, bool by_entity = false);
+    void clear_tracking();
+    bool is_on() const {return members.size() > 0u;};
+    bool is_tracked(epiworld_fast_uint state) const;
+
+    /**
+     * @brief Moves the agent to the set of its current state (and entity)
+     */
+    void update(const Agent<TSeq> & p);
+
+    /**
+     * @brief Rebuilds the sets from scratch (once per run)
+     */
+    void rebuild(const std::vector< Agent<TSeq> > & population);
+
+    /**
+     * @brief Ids of the agents in `state` (and first entity `group`)
+     * @details Returns an empty set for groups without agents. If the state
+     * is not split by entity, `group` is ignored.
+     */
+    const std::vector< size_t > & get(
+        epiworld_fast_uint state,
+        size_t group = 0u
+        ) const;
+
+};
+
+template<typename TSeq>
+inline void StateSets<TSeq>::insert(size_t id, int slot, size_t group)
+{
+
+    auto & groups = members[slot];
+    if (group >= groups.size())
+        groups.resize(group + 1u);
+
+    agent_slot[id]  = slot;
+    agent_group[id] = group;
+    agent_pos[id]   = groups[group].size();
+    groups[group].push_back(id);
+
+}
+
+template<typename TSeq>
+inline void StateSets<TSeq>::remove(size_t id)
+{
+
+    auto & set = members[agent_slot[id]][agent_group[id]];
+    size_t last = set.back();
+
+    set[agent_pos[id]] = last;
+    agent_pos[last]    = agent_pos[id];
+    set.pop_back();
+
+    agent_slot[id] = -1;
+
+}
+
+template<typename TSeq>
+inline void StateSets<TSeq>::track(epiworld_fast_uint state, bool by_entity)
+{
+
+    if (state >= state_slot.size())
+        state_slot.resize(state + 1u, -1);
+
+    if (state_slot[state] >= 0)
+    {
+        slot_by_entity[state_slot[state]] = by_entity;
+        return;
+    }
+
+    state_slot[state] = static_cast< int >(members.size());
+    slot_by_entity.push_back(by_entity);
+    members.push_back({});
+
+}
+
+template<typename TSeq>
+inline void StateSets<TSeq>::clear_tracking()
+{
+
+    state_slot.clear();
+    slot_by_entity.clear();
+    members.clear();
+    agent_slot.clear();
+    agent_group.clear();
+    agent_pos.clear();
+
+}
+
+template<typename TSeq>
+inline bool StateSets<TSeq>::is_tracked(epiworld_fast_uint state) const
+{
+    return (state < state_slot.size()) && (state_slot[state] >= 0);
+}
+
+template<typename TSeq>
+inline void StateSets<TSeq>::update(const Agent<TSeq> & p)
+{
+
+    // Where the agent should be
+    int slot = (p.state < state_slot.size()) ? state_slot[p.state] : -1;
+    size_t group = 0u;
+    if ((slot >= 0) && slot_by_entity[slot])
+    {
+
+        if (p.n_entities == 0u)
+            slot = -1;
+        else
+            group = p.entities[0u];
+
+    }
+
+    // Sets not built yet (see rebuild())
+    if (static_cast< size_t >(p.id) >= agent_slot.size())
+        return;
+
+    // Nothing to do
+    int & slot_now = agent_slot[p.id];
+    if ((slot_now == slot) && ((slot < 0) || (agent_group[p.id] == group)))
+        return;
+
+    if (slot_now >= 0)
+        remove(p.id);
+
+    if (slot >= 0)
+        insert(p.id, slot, group);
+
+}
+
+template<typename TSeq>
+inline void StateSets<TSeq>::rebuild(
+    const std::vector< Agent<TSeq> > & population
+)
+{
+
+    for (auto & groups : members)
+        for (auto & set : groups)
+            set.clear();
+
+    agent_slot.assign(population.size(), -1);
+    agent_group.assign(population.size(), 0u);
+    agent_pos.assign(population.size(), 0u);
+
+    for (const auto & p : population)
+        update(p);
+
+}
+
+template<typename TSeq>
+inline const std::vector< size_t > & StateSets<TSeq>::get(
+    epiworld_fast_uint state,
+    size_t group
+) const
+{
+
+    if (!is_tracked(state))
+        throw std::logic_error(
+            "The state " + std::to_string(state) + " is not tracked. " +
+            "See Model::track_state()."
+            );
+
+    const auto & groups = members[state_slot[state]];
+    if (!slot_by_entity[state_slot[state]])
+        group = 0u;
+
+    if (group >= groups.size())
+        return empty;
+
+    return groups[group];
+
+}
+
+#endif
@@ -0,0 +1,241 @@
+#ifndef EPIWORLD_STATETIMERS_BONES_HPP
+#define EPIWORLD_STATETIMERS_BONES_HPP
+
+/**
+ * @brief Calendar of the transitions of agents in timed states
+ *
+ * @details In the default update, an agent that leaves a state with a daily
+ * probability `q` calls its update function (and draws a random number) on
+ * every day it stays there. For a timed state, the number of days until the
+ * agent leaves is drawn once, when the agent enters the state (see
+ * `Model::set_state_timer()`), and the agent is stored in the bucket of that
+ * day. The model then skips the agent until the day is due, when it calls
+ * the transition function of the state instead of the update function.
+ *
+ * Entries are never removed from the buckets: an agent that leaves the state
+ * early (or enters it again) gets a new due day, so its old entry no longer
+ * matches and is skipped.
+ *
+ * @tparam TSeq
+ */
+template<typename TSeq>
+class StateTimers
+{
+
+private:
+
+    std::vector< TimerFun<TSeq> > timer;       ///< [state] Days until the transition
+    std::vector< UpdateFun<TSeq> > transition; ///< [state] Transition once due
+    std::vector< bool > timed;                 ///< [state] Whether the state is timed
+    size_t ntimed = 0u;
+
+    std::vector< int > due;                       ///< [agent] Due day (-1 if none)
+    std::vector< epiworld_fast_uint > due_state;  ///< [agent] State of the due day
+    std::vector< std::vector< size_t > > buckets; ///< [day] Agents due
+    std::vector< size_t > processed;              ///< Agents processed today
+
+    bool is_pending(const Agent<TSeq> & p, int day) const;
+
+public:
+
+    void set(
+        epiworld_fast_uint state,
+        TimerFun<TSeq> timer_,
+        UpdateFun<TSeq> transition_
+        );
+
+    void clear_timers();
+    bool is_on() const {return ntimed > 0u;};
+    bool is_timed(epiworld_fast_uint state) const
+    {
+        return (state < timed.size()) && timed[state];
+    };
+
+    /**
+     * @brief Clears the calendar (at the start of each run)
+     * @param n Number of agents.
+     * @param ndays Last day of the run (later days are never due).
+     */
+    void start(size_t n, int ndays);
+
+    /**
+     * @brief Draws the due day of the agent if it entered a timed state
+     * @details Does nothing if the agent still has a pending day in its
+     * state, and clears the due day if the state is not timed.
+     */
+    void schedule(Agent<TSeq> & p, Model<TSeq> * m);
+
+    /**
+     * @brief Schedules the agents in timed states without a due day
+     */
+    void rebuild(Model<TSeq> * m);
+
+    /**
+     * @brief Calls the transitions that are due today
+     */
+    void run_due(Model<TSeq> * m);
+
+    /**
+     * @brief Draws a new due day for the agents that stayed in their state
+     * @details Called after the events of the day are applied.
+     */
+    void reschedule_due(Model<TSeq> * m);
+
+};
+
+template<typename TSeq>
+inline bool StateTimers<TSeq>::is_pending(const Agent<TSeq> & p, int day) const
+{
+    size_t id = static_cast< size_t >(p.get_id());
+    return (due_state[id] == p.get_state()) && (due[id] > day);
+}
+
+template<typename TSeq>
+inline void StateTimers<TSeq>::set(
+    epiworld_fast_uint state,
+    TimerFun<TSeq> timer_,
+    UpdateFun<TSeq> transition_
+)
+{
+
+    if (!timer_ || !transition_)
+        throw std::invalid_argument(
+            "The timer and the transition function of a timed state cannot be empty."
+            );
+
+    if (state >= timed.size())
+    {
+        timer.resize(state + 1u);
+        transition.resize(state + 1u);
+        timed.resize(state + 1u, false);
+    }
+
+    if (!timed[state])
+        ++ntimed;
+
+    timer[state]      = timer_;
+    transition[state] = transition_;
+    timed[state]      = true;
+
+}
+
+template<typename TSeq>
+inline void StateTimers<TSeq>::clear_timers()
+{
+
+    timer.clear();
+    transition.clear();
+    timed.clear();
+    ntimed = 0u;
+
+    due.clear();
+    due_state.clear();
+    buckets.clear();
+    processed.clear();
+
+}
+
+template<typename TSeq>
+inline void StateTimers<TSeq>::start(size_t n, int ndays)
+{
+
+    due.assign(n, -1);
+    due_state.assign(n, 0u);
+
+    for (auto & b : buckets)
+        b.clear();
+
+    buckets.resize(static_cast< size_t >(std::max(ndays, 0)) + 1u);
+    processed.clear();
+
+}
+
+template<typename TSeq>
+inline void StateTimers<TSeq>::schedule(Agent<TSeq> & p, Model<TSeq> * m)
+{
+
+    // Calendar not started yet (see start())
+    size_t id = static_cast< size_t >(p.get_id());
+    if (id >= due.size())
+        return;
+
+    if (!is_timed(p.get_state()))
+    {
+        due[id] = -1;
+        return;
+    }
+
+    int today = m->today();
+    if (is_pending(p, today))
+        return;
+
+    due_state[id] = p.get_state();
+
+    // Days beyond the end of the run are never due
+    int delay = timer[p.get_state()](&p, m);
+    int last  = static_cast< int >(buckets.size()) - 1;
+    if ((delay < 0) || (delay > (last - today)))
+    {
+        due[id] = std::numeric_limits< int >::max();
+        return;
+    }
+
+    due[id] = today + std::max(delay, 1);
+    if (due[id] <= last)
+        buckets[due[id]].push_back(id);
+
+}
+
+template<typename TSeq>
+inline void StateTimers<TSeq>::rebuild(Model<TSeq> * m)
+{
+
+    for (auto & p : m->get_agents())
+        if (is_timed(p.get_state()))
+            schedule(p, m);
+
+}
+
+template<typename TSeq>
+inline void StateTimers<TSeq>::run_due(Model<TSeq> * m)
+{
+
+    processed.clear();
+
+    int today = m->today();
+    if ((today < 0) || (static_cast< size_t >(today) >= buckets.size()))
+        return;
+
+    auto & agents = m->get_agents();
+    auto & bucket = buckets[today];
+    for (auto id : bucket)
+    {
+
+        // Stale entries (the agent left the state or was rescheduled)
+        Agent<TSeq> & p = agents[id];
+        if ((due[id] != today) || (due_state[id] != p.get_state()))
+            continue;
+
+        transition[p.get_state()](&p, m);
+        processed.push_back(id);
+
+    }
+
+    // Days are not revisited
+    std::vector< size_t >().swap(bucket);
+
+}
+
+template<typename TSeq>
+inline void StateTimers<TSeq>::reschedule_due(Model<TSeq> * m)
+{
+
+    auto & agents = m->get_agents();
+    for (auto id : processed)
+        schedule(agents[id], m);
+
+    processed.clear();
+
+}
+
+#endif
@@ -67,6 +67,11 @@ public:
     /**
      * @name Get and set the tool functions
      * 
+     * @details The setters taking a pointer read the value at every call,
+     * so it must outlive the tool. Pointers into the model (e.g.,
+     * `&model("name")`) are invalidated when parameters are added to it;
+     * the `ParamHandle` overloads remain valid.
+     * 
      * @param v The virus over which to operate
      * @param fun the function to be used
      * 
@@ -88,6 +93,11 @@ public:
     void set_recovery_enhancer(epiworld_double * prob);
     void set_death_reduction(epiworld_double * prob);
 
+    void set_susceptibility_reduction(ParamHandle prob);
+    void set_transmission_reduction(ParamHandle prob);
+    void set_recovery_enhancer(ParamHandle prob);
+    void set_death_reduction(ParamHandle prob);
+
     void set_susceptibility_reduction(epiworld_double prob);
     void set_transmission_reduction(epiworld_double prob);
     void set_recovery_enhancer(epiworld_double prob);
@@ -78,11 +78,14 @@ inline ToolToAgentFun<TSeq> distribute_tool_randomly(
             
             std::vector< int > idx(n);
             std::iota(idx.begin(), idx.end(), 0);
+            std::vector< epiworld_double > u(n_to_distribute);
+            model->runif_n(u.data(), u.size());
+
             auto & population = model->get_agents();
             for (int i = 0u; i < n_to_distribute; ++i)
             {
                 int loc = static_cast<epiworld_fast_uint>(
-                    floor(model->runif() * n--)
+                    floor(u[i] * n--)
                     );
 
                 if ((loc > 0) && (loc == n))
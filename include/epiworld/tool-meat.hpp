@@ -270,6 +270,62 @@ inline void Tool<TSeq>::set_death_reduction(epiworld_double * prob)
 
 // EPIWORLD_SET_LAMBDA(death_reduction)
 
+template<typename TSeq>
+inline void Tool<TSeq>::set_susceptibility_reduction(ParamHandle prob)
+{
+
+    ToolFun<TSeq> tmpfun =
+        [prob](Tool<TSeq> &, Agent<TSeq> *, VirusPtr<TSeq>, Model<TSeq> * m)
+        {
+            return m->par(prob);
+        };
+
+    susceptibility_reduction_fun = tmpfun;
+
+}
+
+template<typename TSeq>
+inline void Tool<TSeq>::set_transmission_reduction(ParamHandle prob)
+{
+
+    ToolFun<TSeq> tmpfun =
+        [prob](Tool<TSeq> &, Agent<TSeq> *, VirusPtr<TSeq>, Model<TSeq> * m)
+        {
+            return m->par(prob);
+        };
+
+    transmission_reduction_fun = tmpfun;
+
+}
+
+template<typename TSeq>
+inline void Tool<TSeq>::set_recovery_enhancer(ParamHandle prob)
+{
+
+    ToolFun<TSeq> tmpfun =
+        [prob](Tool<TSeq> &, Agent<TSeq> *, VirusPtr<TSeq>, Model<TSeq> * m)
+        {
+            return m->par(prob);
+        };
+
+    recovery_enhancer_fun = tmpfun;
+
+}
+
+template<typename TSeq>
+inline void Tool<TSeq>::set_death_reduction(ParamHandle prob)
+{
+
+    ToolFun<TSeq> tmpfun =
+        [prob](Tool<TSeq> &, Agent<TSeq> *, VirusPtr<TSeq>, Model<TSeq> * m)
+        {
+            return m->par(prob);
+        };
+
+    death_reduction_fun = tmpfun;
+
+}
+
 // #undef EPIWORLD_SET_LAMBDA
 template<typename TSeq>
 inline void Tool<TSeq>::set_susceptibility_reduction(
@@ -0,0 +1,495 @@
+#ifndef EPIWORLD_TRANSMISSIONLOG_HPP
+#define EPIWORLD_TRANSMISSIONLOG_HPP
+
+/**
+ * @brief Record of the transmission events of a run
+ *
+ * @details Transmissions are stored as five columns of 32-bit integers
+ * (date, source, target, virus, and date when the source was exposed). By
+ * default every transmission is kept in memory, but the log can be
+ * configured to use less memory:
+ *
+ * - `set_capacity(n)` keeps at most `n` transmissions in memory. When the
+ *   buffer is full, either the oldest transmissions are overwritten (ring
+ *   buffer) or, with `spill = true`, the buffer is appended to a temporary
+ *   file as fixed-width records (five int32 each) and emptied.
+ * - `set_sampling(p)` keeps each transmission with probability `p`. The
+ *   decision is a hash of the transmission, so it does not use the model's
+ *   random number generator (results do not change) and is reproducible.
+ * - `set_sampling_viruses(ids)` only keeps the transmissions of some viruses.
+ * - `off()` stops recording. Defining `EPI_NO_TRANSMISSION_LOG` removes the
+ *   recording at compile time.
+ *
+ * `is_complete()` tells whether every transmission of the run was kept.
+ */
+class TransmissionLog {
+private:
+
+    bool active = true;
+    size_t capacity = 0u;                ///< 0 means unlimited.
+    bool spill = false;
+    epiworld_double sampling_prob = 1.0;
+    std::vector< char > sampling_viruses; ///< Empty means all viruses.
+
+    std::vector< int > date;
+    std::vector< int > source;
+    std::vector< int > target;
+    std::vector< int > virus;
+    std::vector< int > source_exposure_date;
+
+    size_t head      = 0u;  ///< Oldest transmission in memory (ring buffer).
+    size_t n_seen    = 0u;  ///< Transmissions passed to `add()`.
+    size_t n_dropped = 0u;  ///< Overwritten in the ring buffer.
+    size_t n_spilled = 0u;  ///< Written to `spill_file`.
+    std::FILE * spill_file = nullptr;
+
+    bool sampled(int date, int source, int target, int virus) const;
+    void push(int date, int source, int target, int virus, int source_exposure_date);
+    void flush();
+
+public:
+
+    TransmissionLog() {};
+    TransmissionLog(const TransmissionLog & other);
+    TransmissionLog & operator=(const TransmissionLog & other);
+    ~TransmissionLog();
+
+    /**
+     * @name Configuration
+     *
+     * @details The configuration is kept by `clear()` (i.e., across runs).
+     * `set_capacity()` discards the transmissions recorded so far.
+     * @param n Maximum number of transmissions in memory (0 for no limit).
+     * @param spill If `true`, full buffers are written to a temporary file
+     * instead of being overwritten.
+     * @param prob Probability of keeping each transmission.
+     * @param ids Viruses whose transmissions are kept (empty for all).
+     */
+    ///@{
+    void on();
+    void off();
+    bool is_on() const;
+    void set_capacity(size_t n, bool spill = false);
+    void set_sampling(epiworld_double prob);
+    void set_sampling_viruses(std::vector< int > ids);
+    void reserve(size_t n);
+    ///@}
+
+    void clear();
+
+    /**
+     * @brief Records a transmission (if kept, see the details of the class)
+     */
+    void add(
+        int date,
+        int source,
+        int target,
+        int virus,
+        int source_exposure_date
+    );
+
+    size_t size() const;             ///< Number of transmissions kept
+    size_t get_n_seen() const;       ///< Number of transmissions recorded
+    bool is_complete() const;        ///< All transmissions are kept
+
+    /**
+     * @brief Calls `fun(date, source, target, virus, source_exposure_date)`
+     * on each transmission kept, from the oldest to the newest
+     */
+    template<typename TFun>
+    void for_each(TFun fun) const;
+
+    /**
+     * @brief Copies the transmissions kept (`size()` elements) to the arrays
+     */
+    void get(
+        int * date,
+        int * source,
+        int * target,
+        int * virus,
+        int * source_exposure_date
+    ) const;
+
+    bool operator==(const TransmissionLog & other) const;
+    bool operator!=(const TransmissionLog & other) const {return !operator==(other);};
+
+};
+
+inline TransmissionLog::TransmissionLog(const TransmissionLog & other)
+{
+    *this = other;
+}
+
+inline TransmissionLog & TransmissionLog::operator=(
+    const TransmissionLog & other
+)
+{
+
+    if (this == &other)
+        return *this;
+
+    active           = other.active;
+    capacity         = other.capacity;
+    spill            = other.spill;
+    sampling_prob    = other.sampling_prob;
+    sampling_viruses = other.sampling_viruses;
+
+    // The spilled transmissions go to a file of our own
+    clear();
+    other.for_each([this](int d, int s, int t, int v, int e) -> void {
+        push(d, s, t, v, e);
+    });
+
+    n_seen    = other.n_seen;
+    n_dropped = other.n_dropped;
+
+    return *this;
+
+}
+
+inline TransmissionLog::~TransmissionLog()
+{
+
+    if (spill_file != nullptr)
+        std::fclose(spill_file);
+
+}
+
+inline void TransmissionLog::on()
+{
+    active = true;
+}
+
+inline void TransmissionLog::off()
+{
+    active = false;
+}
+
+inline bool TransmissionLog::is_on() const
+{
+    return active;
+}
+
+inline void TransmissionLog::set_capacity(size_t n, bool spill_)
+{
+
+    if (spill_ && (n == 0u))
+        throw std::logic_error(
+            "Spilling to disk requires a capacity greater than zero."
+            );
+
+    // The buffer starts over
+    clear();
+    capacity = n;
+    spill    = spill_;
+
+}
+
+inline void TransmissionLog::set_sampling(epiworld_double prob)
+{
+
+    if ((prob < 0.0) || (prob > 1.0))
+        throw std::range_error(
+            "The sampling probability must be in [0, 1]."
+            );
+
+    sampling_prob = prob;
+
+}
+
+inline void TransmissionLog::set_sampling_viruses(std::vector< int > ids)
+{
+
+    sampling_viruses.clear();
+    for (auto id : ids)
+    {
+
+        if (id < 0)
+            throw std::range_error(
+                "Virus ids must be non-negative (got " + std::to_string(id) +
+                ")."
+                );
+
+        if (id >= static_cast< int >(sampling_viruses.size()))
+            sampling_viruses.resize(static_cast< size_t >(id) + 1u, 0);
+
+        sampling_viruses[id] = 1;
+
+    }
+
+}
+
+inline void TransmissionLog::reserve(size_t n)
+{
+
+    if (capacity > 0u)
+        n = std::min(n, capacity);
+
+    date.reserve(n);
+    source.reserve(n);
+    target.reserve(n);
+    virus.reserve(n);
+    source_exposure_date.reserve(n);
+
+}
+
+inline void TransmissionLog::clear()
+{
+
+    date.clear();
+    source.clear();
+    target.clear();
+    virus.clear();
+    source_exposure_date.clear();
+
+    head      = 0u;
+    n_seen    = 0u;
+    n_dropped = 0u;
+    n_spilled = 0u;
+
+    if (spill_file != nullptr)
+    {
+        std::fclose(spill_file);
+        spill_file = nullptr;
+    }
+
+}
+
+inline bool TransmissionLog::sampled(
+    int date_,
+    int source_,
+    int target_,
+    int virus_
+) const
+{
+
+    if (sampling_viruses.size() > 0u)
+    {
+
+        if ((virus_ < 0) ||
+            (virus_ >= static_cast< int >(sampling_viruses.size())) ||
+            !sampling_viruses[virus_])
+            return false;
+
+    }
+
+    if (sampling_prob >= 1.0)
+        return true;
+
+    std::uint64_t h = static_cast< std::uint32_t >(date_);
+    h = h * 0x9E3779B97F4A7C15ull + static_cast< std::uint32_t >(source_);
+    h = h * 0x9E3779B97F4A7C15ull + static_cast< std::uint32_t >(target_);
+    h = h * 0x9E3779B97F4A7C15ull + static_cast< std::uint32_t >(virus_);
+
+    // Final mix (from splitmix64)
+    h ^= h >> 30u;
+    h *= 0xBF58476D1CE4E5B9ull;
+    h ^= h >> 27u;
+    h *= 0x94D049BB133111EBull;
+    h ^= h >> 31u;
+
+    return static_cast< epiworld_double >(h >> 11u) *
+        (1.0 / 9007199254740992.0) < sampling_prob;
+
+}
+
+inline void TransmissionLog::flush()
+{
+
+    if (spill_file == nullptr)
+    {
+        spill_file = std::tmpfile();
+        if (spill_file == nullptr)
+            throw std::runtime_error(
+                "Could not create a temporary file for the transmission log."
+                );
+    }
+
+    // Fixed-width records
+    size_t n = date.size();
+    std::vector< int > records(5u * n);
+    for (size_t i = 0u; i < n; ++i)
+    {
+        records[5u * i]      = date[i];
+        records[5u * i + 1u] = source[i];
+        records[5u * i + 2u] = target[i];
+        records[5u * i + 3u] = virus[i];
+        records[5u * i + 4u] = source_exposure_date[i];
+    }
+
+    if (std::fwrite(records.data(), sizeof(int), records.size(), spill_file)
+        != records.size())
+        throw std::runtime_error(
+            "I/O error while writing the transmission log to disk."
+            );
+
+    n_spilled += n;
+
+    date.clear();
+    source.clear();
+    target.clear();
+    virus.clear();
+    source_exposure_date.clear();
+
+}
+
+inline void TransmissionLog::push(
+    int date_,
+    int source_,
+    int target_,
+    int virus_,
+    int source_exposure_date_
+)
+{
+
+    if ((capacity > 0u) && (date.size() == capacity))
+    {
+
+        if (spill)
+            flush();
+        else
+        {
+
+            // Overwriting the oldest
+            date[head]                 = date_;
+            source[head]               = source_;
+            target[head]               = target_;
+            virus[head]                = virus_;
+            source_exposure_date[head] = source_exposure_date_;
+
+            head = (head + 1u) % capacity;
+            ++n_dropped;
+            return;
+
+        }
+
+    }
+
+    date.push_back(date_);
+    source.push_back(source_);
+    target.push_back(target_);
+    virus.push_back(virus_);
+    source_exposure_date.push_back(source_exposure_date_);
+
+}
+
+inline void TransmissionLog::add(
+    int date_,
+    int source_,
+    int target_,
+    int virus_,
+    int source_exposure_date_
+)
+{
+
+    ++n_seen;
+
+    if (!active || !sampled(date_, source_, target_, virus_))
+        return;
+
+    push(date_, source_, target_, virus_, source_exposure_date_);
+
+}
+
+inline size_t TransmissionLog::size() const
+{
+    return n_spilled + date.size();
+}
+
+inline size_t TransmissionLog::get_n_seen() const
+{
+    return n_seen;
+}
+
+inline bool TransmissionLog::is_complete() const
+{
+    return (size() == n_seen) && (n_dropped == 0u);
+}
+
+template<typename TFun>
+inline void TransmissionLog::for_each(TFun fun) const
+{
+
+    if (n_spilled > 0u)
+    {
+
+        std::fflush(spill_file);
+        std::rewind(spill_file);
+
+        const size_t chunk = 4096u;
+        std::vector< int > records(5u * chunk);
+        size_t left = n_spilled;
+        while (left > 0u)
+        {
+
+            size_t k = std::min(chunk, left);
+            if (std::fread(records.data(), 5u * sizeof(int), k, spill_file) != k)
+                throw std::runtime_error(
+                    "I/O error while reading the transmission log from disk."
+                    );
+
+            for (size_t i = 0u; i < k; ++i)
+                fun(
+                    records[5u * i], records[5u * i + 1u],
+                    records[5u * i + 2u], records[5u * i + 3u],
+                    records[5u * i + 4u]
+                );
+
+            left -= k;
+
+        }
+
+        // Back to the end for the next spill
+        std::fseek(spill_file, 0, SEEK_END);
+
+    }
+
+    size_t n = date.size();
+    for (size_t k = 0u; k < n; ++k)
+    {
+        size_t i = (head + k) % n;
+        fun(date[i], source[i], target[i], virus[i], source_exposure_date[i]);
+    }
+
+}
+
+inline void TransmissionLog::get(
+    int * date_,
+    int * source_,
+    int * target_,
+    int * virus_,
+    int * source_exposure_date_
+) const
+{
+
+    size_t i = 0u;
+    for_each([&](int d, int s, int t, int v, int e) -> void {
+        date_[i]                 = d;
+        source_[i]               = s;
+        target_[i]               = t;
+        virus_[i]                = v;
+        source_exposure_date_[i] = e;
+        ++i;
+    });
+
+}
+
+inline bool TransmissionLog::operator==(const TransmissionLog & other) const
+{
+
+    if (size() != other.size())
+        return false;
+
+    size_t n = size();
+    if (n == 0u)
+        return true;
+
+    std::vector< int > a(5u * n), b(5u * n);
+    get(&a[0u], &a[n], &a[2u * n], &a[3u * n], &a[4u * n]);
+    other.get(&b[0u], &b[n], &b[2u * n], &b[3u * n], &b[4u * n]);
+
+    return a == b;
+
+}
+
+#endif
@@ -0,0 +1,263 @@
+#ifndef EPIWORLD_TRANSMISSIONSTATS_HPP
+#define EPIWORLD_TRANSMISSIONSTATS_HPP
+
+/**
+ * @brief Hash table of counts keyed by three integers
+ *
+ * @details Open addressing with linear probing. Keys are stored inline
+ * (no allocation per key), which makes it much lighter than a map keyed by
+ * `std::vector<int>`. Counts must be non-negative.
+ */
+class TripletCounter {
+private:
+
+    struct Slot {
+        int a, b, c;
+        int count = -1; ///< -1 marks an empty slot.
+    };
+
+    std::vector< Slot > slots;
+    size_t n = 0u;
+
+    static size_t hash(int a, int b, int c);
+    size_t find(int a, int b, int c) const;
+    void rehash(size_t capacity);
+
+public:
+
+    void clear();
+
+    /**
+     * @brief Count of (a, b, c), inserted with a zero count if missing
+     */
+    int & operator()(int a, int b, int c);
+
+    size_t size() const {return n;};
+
+    /**
+     * @brief Keys and counts, sorted by (a, b, c)
+     */
+    void get(
+        std::vector< int > & a,
+        std::vector< int > & b,
+        std::vector< int > & c,
+        std::vector< int > & counts
+    ) const;
+
+};
+
+inline size_t TripletCounter::hash(int a, int b, int c)
+{
+
+    std::uint64_t h = static_cast< std::uint32_t >(a);
+    h = h * 0x9E3779B97F4A7C15ull + static_cast< std::uint32_t >(b);
+    h = h * 0x9E3779B97F4A7C15ull + static_cast< std::uint32_t >(c);
+
+    // Final mix (from splitmix64)
+    h ^= h >> 30u;
+    h *= 0xBF58476D1CE4E5B9ull;
+    h ^= h >> 27u;
+    h *= 0x94D049BB133111EBull;
+    h ^= h >> 31u;
+
+    return static_cast< size_t >(h);
+
+}
+
+inline size_t TripletCounter::find(int a, int b, int c) const
+{
+
+    size_t mask = slots.size() - 1u;
+    size_t i = hash(a, b, c) & mask;
+    while (true)
+    {
+
+        const Slot & s = slots[i];
+        if ((s.count < 0) || ((s.a == a) && (s.b == b) && (s.c == c)))
+            return i;
+
+        i = (i + 1u) & mask;
+
+    }
+
+}
+
+inline void TripletCounter::rehash(size_t capacity)
+{
+
+    std::vector< Slot > old(capacity);
+    old.swap(slots);
+
+    for (const auto & s : old)
+        if (s.count >= 0)
+            slots[find(s.a, s.b, s.c)] = s;
+
+}
+
+inline void TripletCounter::clear()
+{
+    slots.clear();
+    n = 0u;
+}
+
+inline int & TripletCounter::operator()(int a, int b, int c)
+{
+
+    // Keeping the load below 1/2
+    if (2u * (n + 1u) > slots.size())
+        rehash(std::max(static_cast< size_t >(64u), 2u * slots.size()));
+
+    Slot & s = slots[find(a, b, c)];
+    if (s.count < 0)
+    {
+        s.a = a;
+        s.b = b;
+        s.c = c;
+        s.count = 0;
+        ++n;
+    }
+
+    return s.count;
+
+}
+
+inline void TripletCounter::get(
+    std::vector< int > & a,
+    std::vector< int > & b,
+    std::vector< int > & c,
+    std::vector< int > & counts
+) const
+{
+
+    std::vector< const Slot * > used;
+    used.reserve(n);
+    for (const auto & s : slots)
+        if (s.count >= 0)
+            used.push_back(&s);
+
+    std::sort(used.begin(), used.end(), [](const Slot * x, const Slot * y) {
+        if (x->a != y->a)
+            return x->a < y->a;
+
+        if (x->b != y->b)
+            return x->b < y->b;
+
+        return x->c < y->c;
+    });
+
+    a.resize(n);
+    b.resize(n);
+    c.resize(n);
+    counts.resize(n);
+    for (size_t i = 0u; i < n; ++i)
+    {
+        a[i] = used[i]->a;
+        b[i] = used[i]->b;
+        c[i] = used[i]->c;
+        counts[i] = used[i]->count;
+    }
+
+}
+
+/**
+ * @brief Reproductive numbers and generation times of a transmission log
+ *
+ * @details Transmissions are processed in the order they were recorded, so
+ * the statistics can be updated as each one is recorded (see
+ * `DataBase::incremental_stats_on()`) or computed at once in a single pass.
+ * - The reproductive number of a case (virus, agent, date of exposure) is
+ *   the number of transmissions from it.
+ * - The generation time of a transmission is the time until the target
+ *   first becomes a source (-1 if it never does).
+ */
+class TransmissionStats {
+private:
+
+    TripletCounter rt;              ///< By (virus, agent, exposure date)
+    std::vector< int > gentime;     ///< One per transmission
+    std::vector< int > date;        ///< Date of each transmission
+    std::vector< int > next;        ///< Next transmission waiting on the same target
+    std::vector< int > first;       ///< First transmission waiting on each agent
+
+public:
+
+    void clear();
+    void reserve(size_t n);
+
+    /**
+     * @brief Adds the next transmission
+     */
+    void add(int date, int source, int target, int virus, int source_exposure_date);
+
+    size_t size() const {return gentime.size();};
+
+    const TripletCounter & get_rt() const {return rt;};
+    const std::vector< int > & get_gentime() const {return gentime;};
+
+};
+
+inline void TransmissionStats::clear()
+{
+
+    rt.clear();
+    gentime.clear();
+    date.clear();
+    next.clear();
+    first.clear();
+
+}
+
+inline void TransmissionStats::reserve(size_t n)
+{
+
+    gentime.reserve(n);
+    date.reserve(n);
+    next.reserve(n);
+
+}
+
+inline void TransmissionStats::add(
+    int date_,
+    int source,
+    int target,
+    int virus,
+    int source_exposure_date
+)
+{
+
+    // The target is a new case; the source has one more transmission
+    rt(virus, source, source_exposure_date)++;
+    rt(virus, target, date_) = 0;
+
+    // The transmission waits for its target to become a source (including
+    // in this same transmission)
+    int i = static_cast< int >(gentime.size());
+    gentime.push_back(-1);
+    date.push_back(date_);
+
+    if (target >= 0)
+    {
+
+        if (target >= static_cast< int >(first.size()))
+            first.resize(static_cast< size_t >(target) + 1u, -1);
+
+        next.push_back(first[target]);
+        first[target] = i;
+
+    }
+    else
+        next.push_back(-1);
+
+    if ((source >= 0) && (source < static_cast< int >(first.size())))
+    {
+
+        for (int j = first[source]; j >= 0; j = next[j])
+            gentime[j] = date_ - date[j];
+
+        first[source] = -1;
+
+    }
+
+}
+
+#endif
@@ -28,35 +28,56 @@ class Virus {
     friend void default_add_virus<TSeq>(Event<TSeq> & a, Model<TSeq> * m);
     friend void default_rm_virus<TSeq>(Event<TSeq> & a, Model<TSeq> * m);
 private:
-    
+
+    /**
+     * @brief Per-variant state shared by all the carriers of the virus
+     * 
+     * @details Copying a virus (e.g., at each transmission) only copies the
+     * pointer to this object. It is copied (copy-on-write) the first time
+     * one of its members is modified through a virus that shares it, so
+     * setters never affect other copies.
+     */
+    struct Shared {
+
+        std::shared_ptr<std::string> virus_name = nullptr;
+        MutFun<TSeq>          mutation_fun                 = nullptr;
+        PostRecoveryFun<TSeq> post_recovery_fun            = nullptr;
+        VirusFun<TSeq>        probability_of_infecting_fun = nullptr;
+        VirusFun<TSeq>        probability_of_recovery_fun  = nullptr;
+        VirusFun<TSeq>        probability_of_death_fun     = nullptr;
+        VirusFun<TSeq>        incubation_fun               = nullptr;
+
+        epiworld_fast_int state_init    = -99; ///< Change of state when added to agent.
+        epiworld_fast_int state_post    = -99; ///< Change of state when removed from agent.
+        epiworld_fast_int state_removed = -99; ///< Change of state when agent is removed
+
+        epiworld_fast_int queue_init    = Queue<TSeq>::Everyone; ///< Change of state when added to agent.
+        epiworld_fast_int queue_post    = -Queue<TSeq>::Everyone; ///< Change of state when removed from agent.
+        epiworld_fast_int queue_removed = -99; ///< Change of state when agent is removed
+
+        // Information about how distribution works
+        VirusToAgentFun<TSeq> dist_fun = nullptr;
+
+    };
+
+    std::shared_ptr< Shared > shared = std::make_shared< Shared >();
+
+    /**
+     * @brief Writable access to the shared state (detaches it if needed)
+     */
+    Shared & shared_mut();
+
+    // Per-agent (infection) record
     Agent<TSeq> * agent       = nullptr;
 
     std::shared_ptr<TSeq> baseline_sequence = nullptr;
-    std::shared_ptr<std::string> virus_name = nullptr;
     int date = -99;
     int id   = -99;
     bool active = true;
-    MutFun<TSeq>          mutation_fun                 = nullptr;
-    PostRecoveryFun<TSeq> post_recovery_fun            = nullptr;
-    VirusFun<TSeq>        probability_of_infecting_fun = nullptr;
-    VirusFun<TSeq>        probability_of_recovery_fun  = nullptr;
-    VirusFun<TSeq>        probability_of_death_fun     = nullptr;
-    VirusFun<TSeq>        incubation_fun               = nullptr;
 
     // Setup parameters
     std::vector< epiworld_double > data = {};
 
-    epiworld_fast_int state_init    = -99; ///< Change of state when added to agent.
-    epiworld_fast_int state_post    = -99; ///< Change of state when removed from agent.
-    epiworld_fast_int state_removed = -99; ///< Change of state when agent is removed
-
-    epiworld_fast_int queue_init    = Queue<TSeq>::Everyone; ///< Change of state when added to agent.
-    epiworld_fast_int queue_post    = -Queue<TSeq>::Everyone; ///< Change of state when removed from agent.
-    epiworld_fast_int queue_removed = -99; ///< Change of state when agent is removed
-
-    // Information about how distribution works
-    VirusToAgentFun<TSeq> dist_fun = nullptr;
-
 public:
     Virus(std::string name = "unknown virus");
 
@@ -84,6 +105,11 @@ public:
     /**
      * @name Get and set the tool functions
      * 
+     * @details The setters taking a pointer read the value at every call,
+     * so it must outlive the virus. Pointers into the model (e.g.,
+     * `&model("name")`) are invalidated when parameters are added to it;
+     * the `ParamHandle` overloads remain valid.
+     * 
      * @param v The virus over which to operate
      * @param fun the function to be used
      * 
@@ -99,6 +125,7 @@ public:
     void set_post_recovery(PostRecoveryFun<TSeq> fun);
     void set_post_immunity(epiworld_double prob);
     void set_post_immunity(epiworld_double * prob);
+    void set_post_immunity(ParamHandle prob);
 
     void set_prob_infecting_fun(VirusFun<TSeq> fun);
     void set_prob_recovery_fun(VirusFun<TSeq> fun);
@@ -109,6 +136,11 @@ public:
     void set_prob_recovery(const epiworld_double * prob);
     void set_prob_death(const epiworld_double * prob);
     void set_incubation(const epiworld_double * prob);
+
+    void set_prob_infecting(ParamHandle prob);
+    void set_prob_recovery(ParamHandle prob);
+    void set_prob_death(ParamHandle prob);
+    void set_incubation(ParamHandle prob);
     
     void set_prob_infecting(epiworld_double prob);
     void set_prob_recovery(epiworld_double prob);
@@ -85,12 +85,16 @@ inline VirusToAgentFun<TSeq> distribute_virus_randomly(
                 std::to_string(n_to_sample)
             );
         
+        // Drawing all the uniforms at once
+        std::vector< epiworld_double > u(n_to_sample);
+        model->runif_n(u.data(), u.size());
+
         auto & population = model->get_agents();
         for (int i = 0; i < n_to_sample; ++i)
         {
 
             int loc = static_cast<epiworld_fast_uint>(
-                floor(model->runif() * (n_available--))
+                floor(u[i] * (n_available--))
                 );
 
             // Correcting for possible overflow
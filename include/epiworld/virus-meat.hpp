@@ -79,6 +79,18 @@ inline VirusFun<TSeq> virus_fun_logit(
 
 }
 
+template<typename TSeq>
+inline typename Virus<TSeq>::Shared & Virus<TSeq>::shared_mut()
+{
+
+    // Copy-on-write: only detach if someone else is using it
+    if (shared.use_count() > 1)
+        shared = std::make_shared< Shared >(*shared);
+
+    return *shared;
+
+}
+
 template<typename TSeq>
 inline Virus<TSeq>::Virus(
     std::string name
@@ -106,8 +118,8 @@ inline void Virus<TSeq>::mutate(
     Model<TSeq> * model
 ) {
 
-    if (mutation_fun)
-        if (mutation_fun(agent, *this, model))
+    if (shared->mutation_fun)
+        if (shared->mutation_fun(agent, *this, model))
             model->get_db().record_virus(*this);
 
     return;
@@ -118,7 +130,7 @@ template<typename TSeq>
 inline void Virus<TSeq>::set_mutation(
     MutFun<TSeq> fun
 ) {
-    mutation_fun = MutFun<TSeq>(fun);
+    shared_mut().mutation_fun = MutFun<TSeq>(fun);
 }
 
 template<typename TSeq>
@@ -192,8 +204,8 @@ inline epiworld_double Virus<TSeq>::get_prob_infecting(
 )
 {
 
-    if (probability_of_infecting_fun)
-        return probability_of_infecting_fun(agent, *this, model);
+    if (shared->probability_of_infecting_fun)
+        return shared->probability_of_infecting_fun(agent, *this, model);
         
     return EPI_DEFAULT_VIRUS_PROB_INFECTION;
 
@@ -207,8 +219,8 @@ inline epiworld_double Virus<TSeq>::get_prob_recovery(
 )
 {
 
-    if (probability_of_recovery_fun)
-        return probability_of_recovery_fun(agent, *this, model);
+    if (shared->probability_of_recovery_fun)
+        return shared->probability_of_recovery_fun(agent, *this, model);
         
     return EPI_DEFAULT_VIRUS_PROB_RECOVERY;
 
@@ -222,8 +234,8 @@ inline epiworld_double Virus<TSeq>::get_prob_death(
 )
 {
 
-    if (probability_of_death_fun)
-        return probability_of_death_fun(agent, *this, model);
+    if (shared->probability_of_death_fun)
+        return shared->probability_of_death_fun(agent, *this, model);
         
     return EPI_DEFAULT_VIRUS_PROB_DEATH;
 
@@ -235,8 +247,8 @@ inline epiworld_double Virus<TSeq>::get_incubation(
 )
 {
 
-    if (incubation_fun)
-        return incubation_fun(agent, *this, model);
+    if (shared->incubation_fun)
+        return shared->incubation_fun(agent, *this, model);
         
     return EPI_DEFAULT_INCUBATION_DAYS;
 
@@ -245,25 +257,25 @@ inline epiworld_double Virus<TSeq>::get_incubation(
 template<typename TSeq>
 inline void Virus<TSeq>::set_prob_infecting_fun(VirusFun<TSeq> fun)
 {
-    probability_of_infecting_fun = fun;
+    shared_mut().probability_of_infecting_fun = fun;
 }
 
 template<typename TSeq>
 inline void Virus<TSeq>::set_prob_recovery_fun(VirusFun<TSeq> fun)
 {
-    probability_of_recovery_fun = fun;
+    shared_mut().probability_of_recovery_fun = fun;
 }
 
 template<typename TSeq>
 inline void Virus<TSeq>::set_prob_death_fun(VirusFun<TSeq> fun)
 {
-    probability_of_death_fun = fun;
+    shared_mut().probability_of_death_fun = fun;
 }
 
 template<typename TSeq>
 inline void Virus<TSeq>::set_incubation_fun(VirusFun<TSeq> fun)
 {
-    incubation_fun = fun;
+    shared_mut().incubation_fun = fun;
 }
 
 template<typename TSeq>
@@ -275,7 +287,7 @@ inline void Virus<TSeq>::set_prob_infecting(const epiworld_double * prob)
             return *prob;
         };
     
-    probability_of_infecting_fun = tmpfun;
+    shared_mut().probability_of_infecting_fun = tmpfun;
 }
 
 template<typename TSeq>
@@ -287,7 +299,7 @@ inline void Virus<TSeq>::set_prob_recovery(const epiworld_double * prob)
             return *prob;
         };
     
-    probability_of_recovery_fun = tmpfun;
+    shared_mut().probability_of_recovery_fun = tmpfun;
 }
 
 template<typename TSeq>
@@ -299,7 +311,7 @@ inline void Virus<TSeq>::set_prob_death(const epiworld_double * prob)
             return *prob;
         };
     
-    probability_of_death_fun = tmpfun;
+    shared_mut().probability_of_death_fun = tmpfun;
 }
 
 template<typename TSeq>
@@ -311,7 +323,55 @@ inline void Virus<TSeq>::set_incubation(const epiworld_double * prob)
             return *prob;
         };
     
-    incubation_fun = tmpfun;
+    shared_mut().incubation_fun = tmpfun;
+}
+
+template<typename TSeq>
+inline void Virus<TSeq>::set_prob_infecting(ParamHandle prob)
+{
+    VirusFun<TSeq> tmpfun = 
+        [prob](Agent<TSeq> *, Virus<TSeq> &, Model<TSeq> * m)
+        {
+            return m->par(prob);
+        };
+    
+    shared_mut().probability_of_infecting_fun = tmpfun;
+}
+
+template<typename TSeq>
+inline void Virus<TSeq>::set_prob_recovery(ParamHandle prob)
+{
+    VirusFun<TSeq> tmpfun = 
+        [prob](Agent<TSeq> *, Virus<TSeq> &, Model<TSeq> * m)
+        {
+            return m->par(prob);
+        };
+    
+    shared_mut().probability_of_recovery_fun = tmpfun;
+}
+
+template<typename TSeq>
+inline void Virus<TSeq>::set_prob_death(ParamHandle prob)
+{
+    VirusFun<TSeq> tmpfun = 
+        [prob](Agent<TSeq> *, Virus<TSeq> &, Model<TSeq> * m)
+        {
+            return m->par(prob);
+        };
+    
+    shared_mut().probability_of_death_fun = tmpfun;
+}
+
+template<typename TSeq>
+inline void Virus<TSeq>::set_incubation(ParamHandle prob)
+{
+    VirusFun<TSeq> tmpfun = 
+        [prob](Agent<TSeq> *, Virus<TSeq> &, Model<TSeq> * m)
+        {
+            return m->par(prob);
+        };
+    
+    shared_mut().incubation_fun = tmpfun;
 }
 
 template<typename TSeq>
@@ -323,7 +383,7 @@ inline void Virus<TSeq>::set_prob_infecting(epiworld_double prob)
             return prob;
         };
     
-    probability_of_infecting_fun = tmpfun;
+    shared_mut().probability_of_infecting_fun = tmpfun;
 }
 
 template<typename TSeq>
@@ -335,7 +395,7 @@ inline void Virus<TSeq>::set_prob_recovery(epiworld_double prob)
             return prob;
         };
     
-    probability_of_recovery_fun = tmpfun;
+    shared_mut().probability_of_recovery_fun = tmpfun;
 }
 
 template<typename TSeq>
@@ -347,7 +407,7 @@ inline void Virus<TSeq>::set_prob_death(epiworld_double prob)
             return prob;
         };
     
-    probability_of_death_fun = tmpfun;
+    shared_mut().probability_of_death_fun = tmpfun;
 }
 
 template<typename TSeq>
@@ -359,20 +419,20 @@ inline void Virus<TSeq>::set_incubation(epiworld_double prob)
             return prob;
         };
     
-    incubation_fun = tmpfun;
+    shared_mut().incubation_fun = tmpfun;
 }
 
 template<typename TSeq>
 inline void Virus<TSeq>::set_post_recovery(PostRecoveryFun<TSeq> fun)
 {
-    if (post_recovery_fun)
+    if (shared->post_recovery_fun)
     {
         printf_epiworld(
             "Warning: a PostRecoveryFun is alreay in place (overwriting)."
             );
     }
 
-    post_recovery_fun = fun;
+    shared_mut().post_recovery_fun = fun;
 }
 
 template<typename TSeq>
@@ -381,8 +441,8 @@ inline void Virus<TSeq>::post_recovery(
 )
 {
 
-    if (post_recovery_fun)
-        post_recovery_fun(agent, *this, model);    
+    if (shared->post_recovery_fun)
+        shared->post_recovery_fun(agent, *this, model);    
 
     return;
         
@@ -394,7 +454,7 @@ inline void Virus<TSeq>::set_post_immunity(
 )
 {
 
-    if (post_recovery_fun)
+    if (shared->post_recovery_fun)
     {
 
         std::string msg =
@@ -411,7 +471,7 @@ inline void Virus<TSeq>::set_post_immunity(
 
     // To make sure that we keep registering the virus
     ToolPtr<TSeq> __no_reinfect = std::make_shared<Tool<TSeq>>(
-        "Immunity (" + *virus_name + ")"
+        "Immunity (" + *shared->virus_name + ")"
     );
 
     __no_reinfect->set_susceptibility_reduction(prob);
@@ -435,7 +495,7 @@ inline void Virus<TSeq>::set_post_immunity(
 
         };
 
-    post_recovery_fun = tmpfun;
+    shared_mut().post_recovery_fun = tmpfun;
 
 }
 
@@ -445,7 +505,56 @@ inline void Virus<TSeq>::set_post_immunity(
 )
 {
 
-    if (post_recovery_fun)
+    if (shared->post_recovery_fun)
+    {
+
+        std::string msg =
+            std::string(
+                "You cannot set post immunity when a post_recovery "
+                ) +
+            std::string(
+                "function is already in place. Redesign the post_recovery function."
+                );
+
+        throw std::logic_error(msg);
+
+    }
+
+    // To make sure that we keep registering the virus
+    ToolPtr<TSeq> __no_reinfect = std::make_shared<Tool<TSeq>>(
+        "Immunity (" + *shared->virus_name + ")"
+    );
+
+    __no_reinfect->set_susceptibility_reduction(prob);
+    __no_reinfect->set_death_reduction(0.0);
+    __no_reinfect->set_transmission_reduction(0.0);
+    __no_reinfect->set_recovery_enhancer(0.0);
+
+    PostRecoveryFun<TSeq> tmpfun = 
+        [__no_reinfect](Agent<TSeq> * p, Virus<TSeq> &, Model<TSeq> * m)
+        {
+
+            // Have we registered the tool?
+            if (__no_reinfect->get_id() == -99)
+                m->get_db().record_tool(*__no_reinfect);
+
+            p->add_tool(__no_reinfect, m);
+
+            return;
+
+        };
+
+    shared_mut().post_recovery_fun = tmpfun;
+
+}
+
+template<typename TSeq>
+inline void Virus<TSeq>::set_post_immunity(
+    ParamHandle prob
+)
+{
+
+    if (shared->post_recovery_fun)
     {
 
         std::string msg =
@@ -462,7 +571,7 @@ inline void Virus<TSeq>::set_post_immunity(
 
     // To make sure that we keep registering the virus
     ToolPtr<TSeq> __no_reinfect = std::make_shared<Tool<TSeq>>(
-        "Immunity (" + *virus_name + ")"
+        "Immunity (" + *shared->virus_name + ")"
     );
 
     __no_reinfect->set_susceptibility_reduction(prob);
@@ -484,7 +593,7 @@ inline void Virus<TSeq>::set_post_immunity(
 
         };
 
-    post_recovery_fun = tmpfun;
+    shared_mut().post_recovery_fun = tmpfun;
 
 }
 
@@ -493,9 +602,9 @@ inline void Virus<TSeq>::set_name(std::string name)
 {
 
     if (name == "")
-        virus_name = nullptr;
+        shared_mut().virus_name = nullptr;
     else
-        virus_name = std::make_shared<std::string>(name);
+        shared_mut().virus_name = std::make_shared<std::string>(name);
 
 }
 
@@ -503,8 +612,8 @@ template<typename TSeq>
 inline std::string Virus<TSeq>::get_name() const
 {
 
-    if (virus_name)
-        return *virus_name;
+    if (shared->virus_name)
+        return *shared->virus_name;
     
     return "unknown virus";
 
@@ -522,9 +631,9 @@ inline void Virus<TSeq>::set_state(
     epiworld_fast_int removed
 )
 {
-    state_init    = init;
-    state_post    = end;
-    state_removed = removed;
+    shared_mut().state_init    = init;
+    shared_mut().state_post    = end;
+    shared_mut().state_removed = removed;
 }
 
 template<typename TSeq>
@@ -535,9 +644,9 @@ inline void Virus<TSeq>::set_queue(
 )
 {
 
-    queue_init    = init;
-    queue_post     = end;
-    queue_removed = removed;
+    shared_mut().queue_init    = init;
+    shared_mut().queue_post     = end;
+    shared_mut().queue_removed = removed;
 
 }
 
@@ -550,13 +659,13 @@ inline void Virus<TSeq>::get_state(
 {
 
     if (init != nullptr)
-        *init = state_init;
+        *init = shared->state_init;
 
     if (end != nullptr)
-        *end = state_post;
+        *end = shared->state_post;
 
     if (removed != nullptr)
-        *removed = state_removed;
+        *removed = shared->state_removed;
 
 }
 
@@ -569,13 +678,13 @@ inline void Virus<TSeq>::get_queue(
 {
 
     if (init != nullptr)
-        *init = queue_init;
+        *init = shared->queue_init;
 
     if (end != nullptr)
-        *end = queue_post;
+        *end = shared->queue_post;
 
     if (removed != nullptr)
-        *removed = queue_removed;
+        *removed = shared->queue_removed;
         
 }
 
@@ -602,37 +711,37 @@ inline bool Virus<std::vector<int>>::operator==(
     }
 
     EPI_DEBUG_FAIL_AT_TRUE(
-        virus_name != other.virus_name,
+        shared->virus_name != other.shared->virus_name,
         "Virus:: virus_name don't match"
         )
     
     EPI_DEBUG_FAIL_AT_TRUE(
-        state_init != other.state_init,
+        shared->state_init != other.shared->state_init,
         "Virus:: state_init don't match"
         )
 
     EPI_DEBUG_FAIL_AT_TRUE(
-        state_post != other.state_post,
+        shared->state_post != other.shared->state_post,
         "Virus:: state_post don't match"
         )
 
     EPI_DEBUG_FAIL_AT_TRUE(
-        state_removed != other.state_removed,
+        shared->state_removed != other.shared->state_removed,
         "Virus:: state_removed don't match"
         )
 
     EPI_DEBUG_FAIL_AT_TRUE(
-        queue_init != other.queue_init,
+        shared->queue_init != other.shared->queue_init,
         "Virus:: queue_init don't match"
         )
 
     EPI_DEBUG_FAIL_AT_TRUE(
-        queue_post != other.queue_post,
+        shared->queue_post != other.shared->queue_post,
         "Virus:: queue_post don't match"
         )
 
     EPI_DEBUG_FAIL_AT_TRUE(
-        queue_removed != other.queue_removed,
+        shared->queue_removed != other.shared->queue_removed,
         "Virus:: queue_removed don't match"
         )
 
@@ -650,37 +759,37 @@ inline bool Virus<TSeq>::operator==(const Virus<TSeq> & other) const
     )
 
     EPI_DEBUG_FAIL_AT_TRUE(
-        virus_name != other.virus_name,
+        shared->virus_name != other.shared->virus_name,
         "Virus:: virus_name don't match"
     )
     
     EPI_DEBUG_FAIL_AT_TRUE(
-        state_init != other.state_init,
+        shared->state_init != other.shared->state_init,
         "Virus:: state_init don't match"
     )
 
     EPI_DEBUG_FAIL_AT_TRUE(
-        state_post != other.state_post,
+        shared->state_post != other.shared->state_post,
         "Virus:: state_post don't match"
     )
 
     EPI_DEBUG_FAIL_AT_TRUE(
-        state_removed != other.state_removed,
+        shared->state_removed != other.shared->state_removed,
         "Virus:: state_removed don't match"
     )
 
     EPI_DEBUG_FAIL_AT_TRUE(
-        queue_init != other.queue_init,
+        shared->queue_init != other.shared->queue_init,
         "Virus:: queue_init don't match"
     )
 
     EPI_DEBUG_FAIL_AT_TRUE(
-        queue_post != other.queue_post,
+        shared->queue_post != other.shared->queue_post,
         "Virus:: queue_post don't match"
     )
 
     EPI_DEBUG_FAIL_AT_TRUE(
-        queue_removed != other.queue_removed,
+        shared->queue_removed != other.shared->queue_removed,
         "Virus:: queue_removed don't match"
     )
 
@@ -692,14 +801,14 @@ template<typename TSeq>
 inline void Virus<TSeq>::print() const
 {
 
-    printf_epiworld("Virus         : %s\n", virus_name->c_str());
+    printf_epiworld("Virus         : %s\n", shared->virus_name->c_str());
     printf_epiworld("Id            : %s\n", (id < 0)? std::string("(empty)").c_str() : std::to_string(id).c_str());
-    printf_epiworld("state_init    : %i\n", static_cast<int>(state_init));
-    printf_epiworld("state_post    : %i\n", static_cast<int>(state_post));
-    printf_epiworld("state_removed : %i\n", static_cast<int>(state_removed));
-    printf_epiworld("queue_init    : %i\n", static_cast<int>(queue_init));
-    printf_epiworld("queue_post    : %i\n", static_cast<int>(queue_post));
-    printf_epiworld("queue_removed : %i\n", static_cast<int>(queue_removed));
+    printf_epiworld("state_init    : %i\n", static_cast<int>(shared->state_init));
+    printf_epiworld("state_post    : %i\n", static_cast<int>(shared->state_post));
+    printf_epiworld("state_removed : %i\n", static_cast<int>(shared->state_removed));
+    printf_epiworld("queue_init    : %i\n", static_cast<int>(shared->queue_init));
+    printf_epiworld("queue_post    : %i\n", static_cast<int>(shared->queue_post));
+    printf_epiworld("queue_removed : %i\n", static_cast<int>(shared->queue_removed));
 
 }
 
@@ -707,10 +816,10 @@ template<typename TSeq>
 inline void Virus<TSeq>::distribute(Model<TSeq> * model)
 {
 
-    if (dist_fun)
+    if (shared->dist_fun)
     {
 
-        dist_fun(*this, model);
+        shared->dist_fun(*this, model);
 
     }
 
@@ -719,7 +828,7 @@ inline void Virus<TSeq>::distribute(Model<TSeq> * model)
 template<typename TSeq>
 inline void Virus<TSeq>::set_distribution(VirusToAgentFun<TSeq> fun)
 {
-    dist_fun = fun;
+    shared_mut().dist_fun = fun;
 }
 
 #endif
@@ -39,6 +39,46 @@ EPIWORLD_TEST_CASE("Cloning", "[clone]") {
         std::cout << n << ", ";
     std::cout << std::endl;
 
+    // The neighbor view should point to the clone's population
+    bool view_matches = true;
+    for (auto & a : m2.get_agents())
+    {
+        auto neighbors = a.get_neighbors();
+        auto view      = a.get_neighbors_view();
+
+        if (neighbors.size() != view.size())
+        {
+            view_matches = false;
+            break;
+        }
+
+        size_t i = 0u;
+        for (auto * n : view)
+            if (n != neighbors[i++])
+                view_matches = false;
+    }
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE(view_matches);
+    #endif
+
+    // Copies of a virus share its state until one of them is modified
+    epiworld::Virus<bool> v2 = v;
+    v2.set_prob_infecting(0.1);
+    v2.set_state(0, 0);
+
+    epiworld_fast_int v_post, v2_post;
+    v.get_state(nullptr, &v_post);
+    v2.get_state(nullptr, &v2_post);
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE(v.get_prob_infecting(&m) == Approx(EPI_DEFAULT_VIRUS_PROB_INFECTION));
+    REQUIRE(v2.get_prob_infecting(&m) == Approx(0.1));
+    REQUIRE(v_post == 1);
+    REQUIRE(v2_post == 0);
+    REQUIRE(v.get_name() == v2.get_name());
+    #endif
+
     // std::cout << "Agent[0] in m tools  : " <<
     //     // m.get_agents()[0u].get_virus()->get_agent() << ", " <<
     //     m.get_agents()[0u].get_tool(0u)->get_agent() << std::endl;
@@ -19,6 +19,30 @@ EPIWORLD_TEST_CASE("SIR multiple", "[SIR-multiple]") {
 
     model_0.run_multiple(100, 10, 1231, nullptr, true, true, 2);
 
+    // Replicates are handed out on demand across threads
+    std::vector< size_t > nreplicates;
+    std::vector< epiworld_double > utilization;
+    model_0.get_run_multiple_stats(&nreplicates, &utilization);
+
+    size_t nreplicates_total = 0u;
+    for (auto n : nreplicates)
+        nreplicates_total += n;
+
+    bool utilization_ok = true;
+    for (auto u : utilization)
+        if ((u < 0.0) || (u > 1.0))
+            utilization_ok = false;
+
+    #ifdef CATCH_CONFIG_MAIN
+    #ifdef _OPENMP
+    REQUIRE(nreplicates.size() == 2u);
+    #endif
+    REQUIRE(nreplicates_total == 10u);
+    REQUIRE(utilization.size() == nreplicates.size());
+    REQUIRE(utilization_ok);
+    REQUIRE(model_0.get_n_replicates() == 10u);
+    #endif
+
     #ifndef CATCH_CONFIG_MAIN
     return 0;
     #endif
@@ -0,0 +1,84 @@
+#ifndef CATCH_CONFIG_MAIN
+#define EPI_DEBUG
+#endif
+
+#include "tests.hpp"
+
+using namespace epiworld;
+
+EPIWORLD_TEST_CASE("Roulette", "[roulette]") {
+
+    Model<> model;
+    model.seed(1545);
+
+    std::vector< epiworld_double > probs = {.1, .2, .3, .05};
+    size_t n = probs.size();
+
+    // Expected probabilities: P(none) and P(only i)
+    std::vector< double > expected(n + 1u, 0.0);
+    double p_none = 1.0;
+    for (auto p : probs)
+        p_none *= (1.0 - p);
+
+    double p_none_or_single = p_none;
+    for (size_t i = 0u; i < n; ++i)
+    {
+        expected[i + 1u] = probs[i] * p_none / (1.0 - probs[i]);
+        p_none_or_single += expected[i + 1u];
+    }
+
+    expected[0u] = p_none;
+    for (auto & e : expected)
+        e /= p_none_or_single;
+
+    // Using both the vector and the scratch space versions
+    model.array_double_tmp.resize(n * 2);
+    std::vector< double > observed_vec(n + 1u, 0.0);
+    std::vector< double > observed_tmp(n + 1u, 0.0);
+
+    size_t nsims = 200000u;
+    for (size_t i = 0u; i < nsims; ++i)
+    {
+
+        observed_vec[roulette(probs, &model) + 1]++;
+
+        for (size_t j = 0u; j < n; ++j)
+            model.array_double_tmp[j] = probs[j];
+
+        observed_tmp[roulette(n, &model) + 1]++;
+
+    }
+
+    for (size_t i = 0u; i <= n; ++i)
+    {
+
+        observed_vec[i] /= static_cast< double >(nsims);
+        observed_tmp[i] /= static_cast< double >(nsims);
+
+        printf(
+            "P(%2i) = %.4f | %.4f | %.4f\n",
+            static_cast< int >(i) - 1,
+            expected[i], observed_vec[i], observed_tmp[i]
+            );
+
+    }
+
+    // Certain events are drawn uniformly
+    std::vector< epiworld_double > probs_certain = {.5, 1.0, .2, 1.0};
+    std::vector< int > ncertain(probs_certain.size(), 0);
+    for (size_t i = 0u; i < 10000u; ++i)
+        ncertain[roulette(probs_certain, &model)]++;
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE_THAT(observed_vec, Catch::Approx(expected).margin(0.005));
+    REQUIRE_THAT(observed_tmp, Catch::Approx(expected).margin(0.005));
+    REQUIRE(ncertain[0u] == 0);
+    REQUIRE(ncertain[2u] == 0);
+    REQUIRE(std::abs(ncertain[1u] - ncertain[3u]) < 500);
+    #endif
+
+    #ifndef CATCH_CONFIG_MAIN
+    return 0;
+    #endif
+
+}
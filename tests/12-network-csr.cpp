@@ -0,0 +1,146 @@
+#ifndef CATCH_CONFIG_MAIN
+#define EPI_DEBUG
+#endif
+
+#include "tests.hpp"
+
+using namespace epiworld;
+
+EPIWORLD_TEST_CASE("CSR network", "[network-csr]") {
+
+    // Same model with and without the CSR backend (including rewiring)
+    epimodels::ModelSIR<> model_0("a virus", 0.01, .5, .3);
+    model_0.agents_smallworld(2000, 5, false, 0.01);
+    model_0.set_rewire_fun(rewire_degseq<int>);
+    model_0.set_rewire_prop(0.1);
+    model_0.verbose_off();
+
+    epimodels::ModelSIR<> model_1("a virus", 0.01, .5, .3);
+    model_1.agents_smallworld(2000, 5, false, 0.01);
+    model_1.set_rewire_fun(rewire_degseq<int>);
+    model_1.set_rewire_prop(0.1);
+    model_1.verbose_off();
+    model_1.network_csr_on();
+
+    std::vector< int > h_0, h_1;
+    model_0.run(50, 223);
+    model_1.run(50, 223);
+    model_0.get_db().get_hist_total(nullptr, nullptr, &h_0);
+    model_1.get_db().get_hist_total(nullptr, nullptr, &h_1);
+
+    // Network before the replicates
+    std::vector< int > source_init, target_init;
+    model_0.write_edgelist(source_init, target_init);
+
+    // Multiple runs restore the network from the backup
+    std::vector< int > h_2, h_3;
+    model_0.run_multiple(50, 3, 11, nullptr, true, false);
+    model_1.run_multiple(50, 3, 11, nullptr, true, false);
+    model_0.get_db().get_hist_total(nullptr, nullptr, &h_2);
+    model_1.get_db().get_hist_total(nullptr, nullptr, &h_3);
+
+    std::vector< int > source_0, target_0, source_1, target_1;
+    model_0.write_edgelist(source_0, target_0);
+    model_1.write_edgelist(source_1, target_1);
+
+    // Moving the ties back into the agents
+    model_1.network_csr_off();
+    std::vector< int > source_2, target_2;
+    model_1.write_edgelist(source_2, target_2);
+
+    // Resetting restores the rewired ties (in both representations)
+    model_0.reset();
+    model_1.reset();
+    std::vector< int > source_3, target_3, source_4, target_4;
+    model_0.write_edgelist(source_3, target_3);
+    model_1.write_edgelist(source_4, target_4);
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE_THAT(h_0, Catch::Equals(h_1));
+    REQUIRE_THAT(h_2, Catch::Equals(h_3));
+    REQUIRE_THAT(source_0, Catch::Equals(source_1));
+    REQUIRE_THAT(target_0, Catch::Equals(target_1));
+    REQUIRE_THAT(source_1, Catch::Equals(source_2));
+    REQUIRE_THAT(target_1, Catch::Equals(target_2));
+    REQUIRE_THAT(source_3, !Catch::Equals(source_0));
+    REQUIRE_THAT(source_3, Catch::Equals(source_init));
+    REQUIRE_THAT(target_3, Catch::Equals(target_init));
+    REQUIRE_THAT(source_4, Catch::Equals(source_init));
+    REQUIRE_THAT(target_4, Catch::Equals(target_init));
+    #endif
+
+    // Building the CSR directly from an edgelist
+    std::vector< int > source = {0, 1, 2, 3, 3, 4, 1};
+    std::vector< int > target = {1, 2, 0, 4, 0, 3, 0};
+
+    Model<> model_2;
+    model_2.network_csr_on();
+    model_2.agents_from_edgelist(source, target, 6, false);
+
+    const auto & net = model_2.get_network_csr();
+    std::vector< size_t > offsets_expected = {0, 3, 5, 7, 9, 10, 10};
+    std::vector< size_t > ids_expected = {1, 2, 3, 0, 2, 0, 1, 0, 4, 3};
+
+    std::vector< size_t > neighbors_3;
+    for (auto * n : model_2.get_agent(3).get_neighbors_view())
+        neighbors_3.push_back(n->get_id());
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE_THAT(net.get_offsets(), Catch::Equals(offsets_expected));
+    REQUIRE_THAT(net.get_ids(), Catch::Equals(ids_expected));
+    REQUIRE(model_2.get_agent(5).get_n_neighbors() == 0u);
+    REQUIRE_THAT(neighbors_3, Catch::Equals(std::vector< size_t >({0, 4})));
+    REQUIRE_THROWS(
+        model_2.get_agent(5).add_neighbor(model_2.get_agent(0))
+    );
+    #endif
+
+    // Rewiring with isolates (positions among the non-isolates are not ids)
+    std::vector< int > source_iso, target_iso;
+    for (int i = 0; i < 100; ++i)
+    {
+        source_iso.push_back(100 + i);
+        target_iso.push_back(100 + (i + 1) % 100);
+    }
+
+    std::vector< std::vector< int > > edges_iso(4u);
+    std::vector< int > source_iso_0, target_iso_0;
+    std::vector< size_t > degrees_iso;
+    for (int csr = 0; csr < 2; ++csr)
+    {
+
+        Model<> model_iso;
+        if (csr)
+            model_iso.network_csr_on();
+
+        model_iso.agents_from_edgelist(source_iso, target_iso, 200, false);
+        model_iso.set_rewire_fun(rewire_degseq<int>);
+        model_iso.set_rewire_prop(0.5);
+        if (!csr)
+            model_iso.write_edgelist(source_iso_0, target_iso_0);
+
+        model_iso.seed(554);
+        model_iso.rewire();
+        model_iso.write_edgelist(edges_iso[2 * csr], edges_iso[2 * csr + 1]);
+
+        for (auto & p : model_iso.get_agents())
+            degrees_iso.push_back(p.get_n_neighbors());
+
+    }
+
+    std::vector< size_t > degrees_expected(400u, 0u);
+    for (size_t i = 0u; i < 100u; ++i)
+        degrees_expected[100u + i] = degrees_expected[300u + i] = 2u;
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE_THAT(edges_iso[0u], Catch::Equals(edges_iso[2u]));
+    REQUIRE_THAT(edges_iso[1u], Catch::Equals(edges_iso[3u]));
+    REQUIRE_THAT(edges_iso[1u], !Catch::Equals(target_iso_0));
+    REQUIRE_THAT(degrees_iso, Catch::Equals(degrees_expected));
+    #endif
+
+    #ifndef CATCH_CONFIG_MAIN
+    return 0;
+    #endif
+
+}
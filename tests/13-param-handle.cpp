@@ -0,0 +1,92 @@
+#ifndef CATCH_CONFIG_MAIN
+#define EPI_DEBUG
+#endif
+
+#include "tests.hpp"
+
+using namespace epiworld;
+
+EPIWORLD_TEST_CASE("Parameter handles", "[param-handle]") {
+
+    Model<> model;
+    model.add_param(0.5, "b");
+    model.add_param(0.1, "a");
+    model.add_param(0.9, "b"); // Already in the model (ignored)
+
+    ParamHandle h_a = model.get_param_handle("a");
+    ParamHandle h_b = model.get_param_handle("b");
+
+    // Handles remain valid after adding parameters
+    for (int i = 0; i < 100; ++i)
+        model.add_param(0.01 * i, "extra " + std::to_string(i));
+
+    model.add_param(0.3, "c");
+    bool same_handle = (model.get_param_handle("a").id == h_a.id);
+    auto by_name = model.params();
+
+    std::vector< epiworld_double > values = {
+        model.par(h_a), model.par(h_b), model.get_param(0u),
+        model.get_param(1u), model.get_param(102u)
+    };
+
+    model.set_param(h_a, 0.2);
+    model(h_b) = 0.6;
+
+    // Copies share the handles but not the values
+    Model<> model_copy(model);
+    model_copy.set_param("a", 0.4);
+
+    // Viruses and tools can read parameters through handles
+    Virus<> virus("v");
+    virus.set_prob_infecting(h_a);
+
+    // Global event updating the parameter by handle
+    auto event = epimodels::globalevent_set_param<int>(h_b, 0.7);
+    event(&model_copy);
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE(h_b.id == 0u);
+    REQUIRE(h_a.id == 1u);
+    REQUIRE_THAT(
+        values,
+        Catch::Approx(std::vector< epiworld_double >({0.1, 0.5, 0.5, 0.1, 0.3}))
+        );
+    REQUIRE(model.par("a") == Approx(0.2));
+    REQUIRE(model.par("b") == Approx(0.6));
+    REQUIRE(model.par(h_a) == Approx(0.2));
+    REQUIRE(model_copy.par(h_a) == Approx(0.4));
+    REQUIRE(model_copy.par("b") == Approx(0.7));
+    REQUIRE(virus.get_prob_infecting(&model) == Approx(0.2));
+    REQUIRE(virus.get_prob_infecting(&model_copy) == Approx(0.4));
+    REQUIRE(same_handle);
+    REQUIRE(by_name.size() == 103u);
+    REQUIRE(by_name.at("a") == Approx(0.1));
+    REQUIRE(by_name.at("c") == Approx(0.3));
+    REQUIRE(model.par("c") == Approx(0.3));
+    REQUIRE_THROWS(model.get_param_handle("d"));
+    REQUIRE_THROWS(model.get_param(103u));
+    REQUIRE_THROWS(model(ParamHandle(103u)));
+    #endif
+
+    // Changing a parameter by handle in a built-in model
+    epimodels::ModelSIRCONN<> sir_0("a virus", 5000, 0.01, 4.0, 0.5, 0.3);
+    epimodels::ModelSIRCONN<> sir_1("a virus", 5000, 0.01, 2.0, 0.5, 0.3);
+    sir_0.verbose_off();
+    sir_1.verbose_off();
+    sir_0.set_param(sir_0.get_param_handle("Contact rate"), 2.0);
+
+    std::vector< int > h_0, h_1;
+    sir_0.run(50, 331);
+    sir_1.run(50, 331);
+    sir_0.get_db().get_hist_total(nullptr, nullptr, &h_0);
+    sir_1.get_db().get_hist_total(nullptr, nullptr, &h_1);
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE_THAT(h_0, Catch::Equals(h_1));
+    #endif
+
+    #ifndef CATCH_CONFIG_MAIN
+    return 0;
+    #endif
+
+}
@@ -0,0 +1,71 @@
+#ifndef CATCH_CONFIG_MAIN
+#define EPI_DEBUG
+#endif
+
+#include "tests.hpp"
+
+using namespace epiworld;
+
+EPIWORLD_TEST_CASE("Parallel update", "[parallel-update]") {
+
+    // Known answer (Random123's kat_vectors, counter = key = 0)
+    Philox4x32 philox;
+    std::vector< std::uint32_t > kat(4u);
+    for (auto & k : kat)
+        k = philox();
+
+    // Jumping ahead
+    Philox4x32 philox_0(112, 3), philox_1(112, 3);
+    for (size_t i = 0u; i < 9u; ++i)
+        philox_0();
+
+    philox_1.discard(9u);
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE_THAT(kat, Catch::Equals(std::vector< std::uint32_t >({
+        0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u
+    })));
+    REQUIRE(philox_0 == philox_1);
+    REQUIRE(philox_0() == philox_1());
+    #endif
+
+    // Results do not depend on the number of threads
+    std::vector< std::vector< int > > hists(3u);
+    std::vector< std::vector< int > > hists_seir(3u);
+    for (int nthreads = 1; nthreads <= 3; ++nthreads)
+    {
+
+        epimodels::ModelSIRCONN<> model(
+            "a virus", 10000, 0.01, 4.0, 0.3, 0.2
+            );
+        model.verbose_off();
+        model.parallel_update_on(nthreads);
+        model.run(50, 1231);
+        model.get_db().get_hist_total(
+            nullptr, nullptr, &hists[nthreads - 1]
+            );
+
+        epimodels::ModelSEIR<> model_seir("a virus", 0.01, .5, 4.0, .3);
+        model_seir.agents_smallworld(10000, 5, false, 0.01);
+        model_seir.verbose_off();
+        model_seir.parallel_update_on(nthreads);
+        model_seir.run(50, 1231);
+        model_seir.get_db().get_hist_total(
+            nullptr, nullptr, &hists_seir[nthreads - 1]
+            );
+
+    }
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE_THAT(hists[0u], Catch::Equals(hists[1u]));
+    REQUIRE_THAT(hists[0u], Catch::Equals(hists[2u]));
+    REQUIRE_THAT(hists_seir[0u], Catch::Equals(hists_seir[1u]));
+    REQUIRE_THAT(hists_seir[0u], Catch::Equals(hists_seir[2u]));
+    REQUIRE_THROWS(Model<>().parallel_update_on(0));
+    #endif
+
+    #ifndef CATCH_CONFIG_MAIN
+    return 0;
+    #endif
+
+}
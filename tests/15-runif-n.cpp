@@ -0,0 +1,60 @@
+#ifndef CATCH_CONFIG_MAIN
+#define EPI_DEBUG
+#endif
+
+#include "tests.hpp"
+
+using namespace epiworld;
+
+EPIWORLD_TEST_CASE("Batched uniforms", "[runif-n]") {
+
+    // With the default engine, runif_n() is the same as calling runif()
+    Model<> model_0, model_1;
+    model_0.seed(882);
+    model_1.seed(882);
+
+    std::vector< epiworld_double > u_0(1001u), u_1(1001u);
+    model_0.runif_n(u_0.data(), u_0.size());
+    for (auto & u : u_1)
+        u = model_1.runif();
+
+    // Philox: batched output matches the sequential one (including the
+    // leftovers of a partially used block)
+    Philox4x32 philox_0(3321, 7), philox_1(3321, 7);
+    philox_0();
+    philox_1();
+
+    std::vector< std::uint32_t > bits_0(203u), bits_1(203u);
+    philox_0.generate_n(bits_0.data(), bits_0.size());
+    for (auto & b : bits_1)
+        b = philox_1();
+
+    bool same_next = philox_0() == philox_1();
+
+    // Draws from U(0, 1)
+    std::vector< double > unif(20000u);
+    philox_0.uniform_n(unif.data(), unif.size());
+
+    double umin = 1.0, umax = 0.0, umean = 0.0;
+    for (auto u : unif)
+    {
+        umin = std::min(umin, u);
+        umax = std::max(umax, u);
+        umean += u / static_cast< double >(unif.size());
+    }
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE_THAT(u_0, Catch::Equals(u_1));
+    REQUIRE(model_0.runif() == model_1.runif());
+    REQUIRE_THAT(bits_0, Catch::Equals(bits_1));
+    REQUIRE(same_next);
+    REQUIRE(umin >= 0.0);
+    REQUIRE(umax < 1.0);
+    REQUIRE(umean == Approx(0.5).epsilon(0.01));
+    #endif
+
+    #ifndef CATCH_CONFIG_MAIN
+    return 0;
+    #endif
+
+}
@@ -0,0 +1,84 @@
+#ifndef CATCH_CONFIG_MAIN
+#define EPI_DEBUG
+#endif
+
+#include "tests.hpp"
+
+using namespace epiworld;
+
+EPIWORLD_TEST_CASE("DataBase history", "[db-history]") {
+
+    // A virus that mutates, so new variants show up during the run
+    epimodels::ModelSIR<> model("a virus", 0.01, .9, .3);
+    model.agents_smallworld(5000, 5, false, 0.01);
+    model.verbose_off();
+
+    model.get_virus(0u).set_mutation(
+        [](Agent<> *, Virus<> & v, Model<> * m) -> bool {
+
+            if (m->runif() > 0.001)
+                return false;
+
+            v.set_sequence(m->today() + 1);
+            return true;
+
+        });
+
+    model.run(60, 1231);
+
+    const auto & db = model.get_db();
+    size_t nstates = model.get_states().size();
+
+    std::vector< int > t_date, t_counts;
+    std::vector< std::string > t_state;
+    db.get_hist_total(&t_date, &t_state, &t_counts);
+
+    std::vector< int > v_date, v_id, v_counts;
+    std::vector< std::string > v_state;
+    db.get_hist_virus(v_date, v_id, v_state, v_counts);
+
+    std::vector< int > today_id, today_counts;
+    std::vector< std::string > today_state;
+    db.get_today_virus(today_state, today_id, today_counts);
+
+    // Totals: one row per (day, state), adding up to the population size
+    bool totals_ok = t_date.size() == (61u * nstates);
+    for (size_t i = 0u; totals_ok && (i < t_date.size()); ++i)
+        totals_ok = (t_date[i] == static_cast< int >(i / nstates)) &&
+            (t_state[i] == model.get_states()[i % nstates]);
+
+    int total_last = 0;
+    for (size_t s = 0u; s < nstates; ++s)
+        total_last += t_counts[t_counts.size() - 1u - s];
+
+    // Viruses: the last day matches today's counts
+    std::vector< int > last_id, last_counts;
+    std::vector< std::string > last_state;
+    for (size_t i = 0u; i < v_date.size(); ++i)
+    {
+        if (v_date[i] != 60)
+            continue;
+
+        last_id.push_back(v_id[i]);
+        last_state.push_back(v_state[i]);
+        last_counts.push_back(v_counts[i]);
+    }
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE(db.get_n_viruses() > 1u);
+    REQUIRE(totals_ok);
+    REQUIRE(total_last == 5000);
+    REQUIRE(v_id.size() == v_counts.size());
+    REQUIRE(v_state.size() == v_counts.size());
+    REQUIRE(v_date.front() == 0);
+    REQUIRE(std::is_sorted(v_date.begin(), v_date.end()));
+    REQUIRE_THAT(last_id, Catch::Equals(today_id));
+    REQUIRE_THAT(last_state, Catch::Equals(today_state));
+    REQUIRE_THAT(last_counts, Catch::Equals(today_counts));
+    #endif
+
+    #ifndef CATCH_CONFIG_MAIN
+    return 0;
+    #endif
+
+}
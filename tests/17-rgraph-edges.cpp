@@ -0,0 +1,177 @@
+#ifndef CATCH_CONFIG_MAIN
+#define EPI_DEBUG
+#endif
+
+#include "tests.hpp"
+
+using namespace epiworld;
+
+EPIWORLD_TEST_CASE("Edge-array generators", "[rgraph-edges]") {
+
+    Model<> model;
+    model.seed(5512);
+
+    // Ring lattice: same ties as the AdjList version
+    std::vector< int > ring_source, ring_target;
+    rgraph_ring_lattice_edges(200, 4, false, ring_source, ring_target);
+
+    AdjList ring = rgraph_ring_lattice(200, 4, false);
+    bool ring_matches =
+        NetworkCSR(ring) == NetworkCSR(ring_source, ring_target, 200);
+
+    // Small world: rewiring keeps the degree of each vertex
+    rgraph_ring_lattice_edges(1000, 6, false, ring_source, ring_target);
+
+    std::vector< int > sw_source, sw_target;
+    rgraph_smallworld_edges(1000, 6, 0.2, false, model, sw_source, sw_target);
+
+    std::vector< int > degree_ring(1000, 0), degree_sw(1000, 0);
+    std::set< std::pair< int, int > > sw_ties;
+    size_t nloops = 0u;
+    for (size_t e = 0u; e < ring_source.size(); ++e)
+    {
+        degree_ring[ring_source[e]]++;
+        degree_ring[ring_target[e]]++;
+    }
+
+    for (size_t e = 0u; e < sw_source.size(); ++e)
+    {
+        degree_sw[sw_source[e]]++;
+        degree_sw[sw_target[e]]++;
+        nloops += (sw_source[e] == sw_target[e]) ? 1u : 0u;
+        sw_ties.insert({
+            std::min(sw_source[e], sw_target[e]),
+            std::max(sw_source[e], sw_target[e])
+        });
+    }
+
+    // About a proportion p of the ties are rewired (directed or not)
+    std::vector< double > prop_rewired;
+    for (int d = 0; d < 2; ++d)
+    {
+
+        std::vector< int > rs, rt, ss, st;
+        rgraph_ring_lattice_edges(1000, 6, d == 1, rs, rt);
+        rgraph_smallworld_edges(1000, 6, 0.2, d == 1, model, ss, st);
+
+        auto key = [d](int a, int b) {
+            return (d == 1) ?
+                std::make_pair(a, b) :
+                std::make_pair(std::min(a, b), std::max(a, b));
+        };
+
+        std::set< std::pair< int, int > > ring_ties;
+        for (size_t e = 0u; e < rs.size(); ++e)
+            ring_ties.insert(key(rs[e], rt[e]));
+
+        double nnew = 0.0;
+        for (size_t e = 0u; e < ss.size(); ++e)
+            nnew += ring_ties.count(key(ss[e], st[e])) ? 0.0 : 1.0;
+
+        prop_rewired.push_back(nnew / static_cast< double >(ss.size()));
+
+    }
+
+    // The degrees survive the CSR (no duplicated ties to merge)
+    Model<> model_sw;
+    model_sw.agents_from_edgelist(sw_source, sw_target, 1000, false);
+    std::vector< int > degree_agents;
+    for (auto & a : model_sw.get_agents())
+        degree_agents.push_back(static_cast< int >(a.get_n_neighbors()));
+
+    // Round trip through write_edgelist()
+    std::vector< int > wsource, wtarget;
+    model_sw.write_edgelist(wsource, wtarget);
+    std::set< std::pair< int, int > > written_ties;
+    for (size_t e = 0u; e < wsource.size(); ++e)
+        written_ties.insert({
+            std::min(wsource[e], wtarget[e]),
+            std::max(wsource[e], wtarget[e])
+        });
+
+    // Bernoulli: ties are below the diagonal, unique, about n^2 * p / 2,
+    // and do not depend on the number of threads
+    size_t n = 2000u;
+    double p = 0.01;
+    Model<> model_0, model_1;
+    model_0.seed(8812);
+    model_1.seed(8812);
+
+    std::vector< int > source_0, target_0, source_1, target_1;
+
+    // (the number of threads is restored for the tests that follow)
+    #ifdef _OPENMP
+    int nthreads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    #endif
+    rgraph_bernoulli_edges(n, p, false, model_0, source_0, target_0);
+
+    #ifdef _OPENMP
+    omp_set_num_threads(3);
+    #endif
+    rgraph_bernoulli_edges(n, p, false, model_1, source_1, target_1);
+
+    #ifdef _OPENMP
+    omp_set_num_threads(nthreads);
+    #endif
+
+    bool lower = true;
+    std::set< std::pair< int, int > > unique_ties;
+    for (size_t e = 0u; e < source_0.size(); ++e)
+    {
+        lower = lower && (target_0[e] < source_0[e]) &&
+            (source_0[e] < static_cast< int >(n));
+        unique_ties.insert({source_0[e], target_0[e]});
+    }
+
+    double expected = n * (n - 1.0) / 2.0 * p;
+    double sd       = std::sqrt(expected * (1 - p));
+
+    // Building the agents' network from the edge array
+    Model<> model_2;
+    model_2.agents_from_edgelist(
+        source_0, target_0, static_cast< int >(n), false
+        );
+
+    size_t nties_agents = 0u;
+    for (auto & a : model_2.get_agents())
+        nties_agents += a.get_n_neighbors();
+
+    // Directed graphs have no loops
+    std::vector< int > source_d, target_d;
+    rgraph_bernoulli_edges(300, 0.1, true, model, source_d, target_d);
+    size_t nloops_directed = 0u;
+    for (size_t e = 0u; e < source_d.size(); ++e)
+        nloops_directed += (source_d[e] == target_d[e]) ? 1u : 0u;
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE(ring_matches);
+    REQUIRE(sw_source.size() == 3000u);
+    REQUIRE_THAT(degree_sw, Catch::Equals(degree_ring));
+    REQUIRE_THAT(sw_target, !Catch::Equals(ring_target));
+    REQUIRE(nloops == 0u);
+    for (auto & pr : prop_rewired)
+    {
+        REQUIRE(pr > 0.8 * 0.2);
+        REQUIRE(pr <= 0.2);
+    }
+    REQUIRE(sw_ties.size() == sw_source.size());
+    REQUIRE_THAT(degree_agents, Catch::Equals(degree_sw));
+    REQUIRE(!model_sw.is_directed());
+    REQUIRE(wsource.size() == sw_source.size());
+    REQUIRE(written_ties == sw_ties);
+    REQUIRE_THAT(source_0, Catch::Equals(source_1));
+    REQUIRE_THAT(target_0, Catch::Equals(target_1));
+    REQUIRE(lower);
+    REQUIRE(unique_ties.size() == source_0.size());
+    REQUIRE(std::abs(source_0.size() - expected) < 5 * sd);
+    REQUIRE(nties_agents == 2u * source_0.size());
+    REQUIRE(source_d.size() > 0u);
+    REQUIRE(nloops_directed == 0u);
+    #endif
+
+    #ifndef CATCH_CONFIG_MAIN
+    return 0;
+    #endif
+
+}
@@ -0,0 +1,86 @@
+#ifndef CATCH_CONFIG_MAIN
+#define EPI_DEBUG
+#endif
+
+#include "tests.hpp"
+
+using namespace epiworld;
+
+EPIWORLD_TEST_CASE("Edgelist I/O", "[edgelist-io]") {
+
+    // A small file with a header, Windows line breaks, and a trailing line
+    // that is not part of the edgelist
+    std::string fn_small = "18-edgelist-io-small.txt";
+    {
+        std::ofstream f(fn_small);
+        f << "source target\r\n0 1\r\n1   2\n\t3 0\n4 2\nend of data\n5 5\n";
+    }
+
+    std::vector< int > source, target;
+    read_edgelist_text(fn_small, source, target, 1);
+
+    AdjList al;
+    al.read_edgelist(fn_small, 5, 1, false);
+
+    // A file large enough to be parsed in several chunks
+    Model<> model;
+    model.seed(223);
+
+    std::vector< int > source_big, target_big;
+    rgraph_bernoulli_edges(20000, 0.005, false, model, source_big, target_big);
+
+    std::string fn_big = "18-edgelist-io-big.txt";
+    {
+        std::ofstream f(fn_big);
+        for (size_t e = 0u; e < source_big.size(); ++e)
+            f << source_big[e] << " " << target_big[e] << "\n";
+    }
+
+    std::vector< int > source_txt, target_txt;
+    read_edgelist_text(fn_big, source_txt, target_txt);
+
+    // Binary round trip
+    std::string fn_bin = "18-edgelist-io.bin";
+    write_edgelist_binary(fn_bin, source_big, target_big, 20000, false);
+
+    std::vector< int > source_bin, target_bin;
+    size_t n_bin = 0u;
+    bool directed_bin = true;
+    read_edgelist_binary(fn_bin, source_bin, target_bin, &n_bin, &directed_bin);
+
+    // Loading the agents from both formats
+    Model<> model_txt, model_bin;
+    model_txt.agents_from_adjlist(fn_big, 20000, 0, false);
+    model_bin.agents_from_binary_edgelist(fn_bin);
+
+    std::vector< int > s_txt, t_txt, s_bin, t_bin;
+    model_txt.write_edgelist(s_txt, t_txt);
+    model_bin.write_edgelist(s_bin, t_bin);
+
+    std::remove(fn_small.c_str());
+    std::remove(fn_big.c_str());
+    std::remove(fn_bin.c_str());
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE_THAT(source, Catch::Equals(std::vector< int >({0, 1, 3, 4})));
+    REQUIRE_THAT(target, Catch::Equals(std::vector< int >({1, 2, 0, 2})));
+    REQUIRE(al.ecount() == 4u);
+    REQUIRE(al.vcount() == 5u);
+    REQUIRE(source_big.size() * 8u > (4u << 20u));
+    REQUIRE_THAT(source_txt, Catch::Equals(source_big));
+    REQUIRE_THAT(target_txt, Catch::Equals(target_big));
+    REQUIRE_THAT(source_bin, Catch::Equals(source_big));
+    REQUIRE_THAT(target_bin, Catch::Equals(target_big));
+    REQUIRE(n_bin == 20000u);
+    REQUIRE_FALSE(directed_bin);
+    REQUIRE(model_bin.size() == 20000u);
+    REQUIRE_THAT(s_txt, Catch::Equals(s_bin));
+    REQUIRE_THAT(t_txt, Catch::Equals(t_bin));
+    REQUIRE_THROWS(read_edgelist_binary(fn_bin, source_bin, target_bin));
+    #endif
+
+    #ifndef CATCH_CONFIG_MAIN
+    return 0;
+    #endif
+
+}
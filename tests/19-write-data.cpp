@@ -0,0 +1,121 @@
+#ifndef CATCH_CONFIG_MAIN
+#define EPI_DEBUG
+#endif
+
+#include "tests.hpp"
+
+using namespace epiworld;
+
+EPIWORLD_TEST_CASE("Writing data", "[write-data]") {
+
+    epimodels::ModelSEIRCONN<> model(
+        "a virus", 5000, 0.01, 4.0, 0.5, 0.3, 0.2
+        );
+    model.verbose_off();
+    model.run(60, 22);
+
+    std::string p = "19-write-data-saves/";
+    std::vector< std::string > files = {
+        "virus_info", "virus_hist", "tool_info", "tool_hist", "total_hist",
+        "transmission", "transition", "reproductive", "generation"
+    };
+
+    // Text and binary versions of the same tables
+    model.write_data(
+        p + "virus_info.csv", p + "virus_hist.csv", p + "tool_info.csv",
+        p + "tool_hist.csv", p + "total_hist.csv", p + "transmission.csv",
+        p + "transition.csv", p + "reproductive.csv", p + "generation.csv"
+        );
+
+    model.write_data(
+        p + "virus_info.bin", p + "virus_hist.bin", p + "tool_info.bin",
+        p + "tool_hist.bin", p + "total_hist.bin", p + "transmission.bin",
+        p + "transition.bin", p + "reproductive.bin", p + "generation.bin",
+        true
+        );
+
+    std::vector< std::string > csv_text, bin_text;
+    for (auto & f : files)
+    {
+        MappedFile csv(p + f + ".csv");
+        csv_text.push_back(std::string(csv.data(), csv.size()));
+        bin_text.push_back(DataTable::read_binary(p + f + ".bin").to_csv());
+    }
+
+    // The binary columns match the database
+    DataTable total = DataTable::read_binary(p + "total_hist.bin");
+    std::vector< int > date, counts;
+    std::vector< std::string > state;
+    model.get_db().get_hist_total(&date, &state, &counts);
+
+    #ifdef CATCH_CONFIG_MAIN
+    for (size_t i = 0u; i < files.size(); ++i)
+        REQUIRE(csv_text[i] == bin_text[i]);
+
+    REQUIRE_THAT(total.get_column("date"), Catch::Equals(date));
+    REQUIRE_THAT(total.get_column("counts"), Catch::Equals(counts));
+    REQUIRE_THAT(total.get_column_str("state"), Catch::Equals(state));
+    #endif
+
+    // Writing in the background gives the same files
+    auto writer = std::make_shared< DataWriter >();
+    auto saver_sync = make_save_run<int>(
+        p + "sync_%lu", true, true, true, false, false, true, true, true, true
+        );
+    auto saver_async = make_save_run<int>(
+        p + "async_%lu", true, true, true, false, false, true, true, true,
+        true, false, writer
+        );
+
+    model.run_multiple(60, 4, 1231, saver_sync, true, false, 2);
+    model.run_multiple(60, 4, 1231, saver_async, true, false, 2);
+    writer->wait();
+
+    std::vector< std::string > saved = {
+        "total_hist", "virus_info", "virus_hist", "transmission",
+        "transition", "reproductive", "generation"
+    };
+
+    bool async_equal = true;
+    for (size_t i = 0u; i < 4u; ++i)
+        for (auto & f : saved)
+            async_equal &= (
+                file_reader(p + "sync_" + std::to_string(i) + "_" + f + ".csv") ==
+                file_reader(p + "async_" + std::to_string(i) + "_" + f + ".csv")
+                );
+
+    // Large tables are formatted by blocks
+    size_t n = 200000u;
+    std::vector< int > x(n), code(n);
+    std::string expected = "x y\n";
+    for (size_t i = 0u; i < n; ++i)
+    {
+        x[i]    = static_cast< int >(i) - 100000;
+        code[i] = static_cast< int >(i % 3u);
+        expected += std::to_string(x[i]) + " \"" +
+            std::string(1u, static_cast< char >('a' + code[i])) + "\"\n";
+    }
+
+    DataTable big(n);
+    big.add_column("x", x);
+    big.add_column("y", code, {"a", "b", "c"});
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE(async_equal);
+    REQUIRE(big.to_csv() == expected);
+    REQUIRE_THROWS(big.add_column("z", std::vector< int >(n - 1u)));
+    REQUIRE_THROWS(big.add_column("z", std::vector< int >(n, 3), {"a", "b"}));
+    REQUIRE_THROWS(big.get_column("z"));
+    REQUIRE_THROWS(DataTable::read_binary(p + "total_hist.csv"));
+
+    // Errors from the background thread are reported by wait()
+    writer->write("19-write-data-saves/no/such/dir.csv", "x\n");
+    REQUIRE_THROWS(writer->wait());
+    REQUIRE_NOTHROW(writer->wait());
+    #endif
+
+    #ifndef CATCH_CONFIG_MAIN
+    return 0;
+    #endif
+
+}
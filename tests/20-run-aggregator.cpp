@@ -0,0 +1,136 @@
+#ifndef CATCH_CONFIG_MAIN
+#define EPI_DEBUG
+#endif
+
+#include "tests.hpp"
+
+using namespace epiworld;
+
+EPIWORLD_TEST_CASE("Replicate aggregator", "[run-aggregator]") {
+
+    // Quantile sketches
+    QuantileSketch sketch, sketch_a, sketch_b;
+    for (int i = 1000; i >= 0; --i)
+    {
+        sketch.add(i);
+        if (i % 2)
+            sketch_a.add(i);
+        else
+            sketch_b.add(i);
+    }
+
+    sketch_a.merge(sketch_b);
+
+    std::vector< epiworld_double > q, q_merged;
+    for (auto p : {0.0, 0.01, 0.25, 0.5, 0.9, 1.0})
+    {
+        q.push_back(sketch.quantile(p));
+        q_merged.push_back(sketch_a.quantile(p));
+    }
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE(q[0u] == 0.0);
+    REQUIRE(q[1u] == 10.0); // Small integers are exact
+    REQUIRE(std::abs(q[2u] / 250.0 - 1.0) <= 0.01);
+    REQUIRE(std::abs(q[3u] / 500.0 - 1.0) <= 0.01);
+    REQUIRE(std::abs(q[4u] / 900.0 - 1.0) <= 0.01);
+    REQUIRE(std::abs(q[5u] / 1000.0 - 1.0) <= 0.01);
+    REQUIRE_THAT(q, Catch::Equals(q_merged));
+    REQUIRE(std::isnan(QuantileSketch().quantile(0.5)));
+    REQUIRE_THROWS(sketch.add(-1.0));
+    REQUIRE_THROWS(QuantileSketch(0.0));
+    #endif
+
+    // Aggregating the replicates of a model
+    std::vector< std::vector< int > > totals;
+    auto keep = [&totals](size_t, Model<> * m) -> void {
+        std::vector< int > counts;
+        m->get_db().get_hist_total(nullptr, nullptr, &counts);
+        totals.push_back(counts);
+    };
+
+    epimodels::ModelSIRCONN<> model("a virus", 2000, 0.01, 4.0, 0.5, 0.3);
+    model.verbose_off();
+    model.run_multiple(50, 20, 1231, keep, true, false, 1);
+
+    std::vector< std::vector< epiworld_double > > means(2u), vars(2u);
+    std::vector< std::vector< epiworld_double > > quants(2u), rts(2u);
+    std::vector< std::vector< epiworld_double > > trans(2u), virus(2u);
+    std::vector< int > date;
+    std::vector< std::string > state;
+    for (int nthreads = 1; nthreads <= 2; ++nthreads)
+    {
+
+        auto agg = std::make_shared< RunAggregator<> >(true, true, true, true);
+        model.run_multiple(
+            50, 20, 1231, make_aggregate_run(agg), true, false, nthreads
+            );
+
+        size_t i = static_cast< size_t >(nthreads - 1);
+        agg->get_hist_total(
+            &date, &state, &means[i], &vars[i], &quants[i], {0.5}
+            );
+        agg->get_reproductive_number(nullptr, nullptr, &rts[i], nullptr);
+        agg->get_hist_transition_matrix(
+            nullptr, nullptr, nullptr, &trans[i], nullptr
+            );
+        agg->get_hist_virus(nullptr, nullptr, nullptr, &virus[i], nullptr);
+
+        #ifdef CATCH_CONFIG_MAIN
+        REQUIRE(agg->get_n_replicates() == 20u);
+        #endif
+
+    }
+
+    // Expected values from the replicates
+    size_t nrows = totals[0u].size();
+    std::vector< epiworld_double > mean_0(nrows, 0.0), var_0(nrows, 0.0);
+    std::vector< epiworld_double > median_0(nrows);
+    for (size_t i = 0u; i < nrows; ++i)
+    {
+
+        std::vector< int > x;
+        for (auto & t : totals)
+            x.push_back(t[i]);
+
+        for (auto v : x)
+            mean_0[i] += v / 20.0;
+
+        for (auto v : x)
+            var_0[i] += (v - mean_0[i]) * (v - mean_0[i]) / 19.0;
+
+        std::sort(x.begin(), x.end());
+        median_0[i] = x[9u];
+
+    }
+
+    bool median_ok = true;
+    for (size_t i = 0u; i < nrows; ++i)
+        median_ok &= std::abs(quants[0u][i] - median_0[i]) <=
+            0.01 * median_0[i];
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE(date.size() == nrows);
+    REQUIRE(state[1u] == model.get_states()[1u]);
+    REQUIRE_THAT(means[0u], Catch::Approx(mean_0).epsilon(1e-10));
+    REQUIRE_THAT(vars[0u], Catch::Approx(var_0).epsilon(1e-8));
+    REQUIRE(median_ok);
+    REQUIRE(rts[0u].size() > 0u);
+    REQUIRE(trans[0u].size() == nrows * model.get_states().size());
+    REQUIRE(virus[0u].size() == nrows);
+
+    // The results do not depend on the number of threads
+    REQUIRE_THAT(means[0u], Catch::Equals(means[1u]));
+    REQUIRE_THAT(vars[0u], Catch::Equals(vars[1u]));
+    REQUIRE_THAT(quants[0u], Catch::Equals(quants[1u]));
+    REQUIRE_THAT(trans[0u], Catch::Equals(trans[1u]));
+    REQUIRE_THAT(virus[0u], Catch::Equals(virus[1u]));
+    REQUIRE_THAT(rts[0u], Catch::Equals(rts[1u]));
+    REQUIRE_THROWS(make_aggregate_run<int>(nullptr));
+    #endif
+
+    #ifndef CATCH_CONFIG_MAIN
+    return 0;
+    #endif
+
+}
@@ -0,0 +1,77 @@
+#ifndef CATCH_CONFIG_MAIN
+#define EPI_DEBUG
+#endif
+
+#include "tests.hpp"
+
+using namespace epiworld;
+
+EPIWORLD_TEST_CASE("Transmission statistics", "[transmission-stats]") {
+
+    epimodels::ModelSEIRCONN<> model("a virus", 5000, 0.01, 4.0, 0.5, 0.3, 0.2);
+    model.verbose_off();
+    model.run(60, 1412);
+
+    // Computing the statistics directly from the transmissions
+    std::vector< int > date, source, target, virus, expo;
+    model.get_db().get_transmissions(date, source, target, virus, expo);
+    size_t n = date.size();
+
+    std::map< std::vector< int >, int > rt_0;
+    std::vector< int > gentime_0(n, -1);
+    for (size_t i = 0u; i < n; ++i)
+    {
+
+        rt_0[{virus[i], source[i], expo[i]}]++;
+        rt_0[{virus[i], target[i], date[i]}] = 0;
+
+        for (size_t j = i; j < n; ++j)
+            if (source[j] == target[i])
+            {
+                gentime_0[i] = date[j] - date[i];
+                break;
+            }
+
+    }
+
+    std::vector< int > rt_v, rt_s, rt_d, rt_n;
+    model.get_db().reproductive_number(rt_v, rt_s, rt_d, rt_n);
+
+    std::map< std::vector< int >, int > rt_1;
+    for (size_t i = 0u; i < rt_n.size(); ++i)
+        rt_1[{rt_v[i], rt_s[i], rt_d[i]}] = rt_n[i];
+
+    std::map< std::vector< int >, int > rt_map;
+    for (auto & r : model.get_db().reproductive_number())
+        rt_map[r.first] = r.second;
+
+    std::vector< int > agent_id, virus_id, time, gentime_1;
+    model.get_db().generation_time(agent_id, virus_id, time, gentime_1);
+
+    // Updating the statistics as transmissions are recorded
+    model.get_db().incremental_stats_on();
+    model.run(60, 1412);
+
+    std::vector< int > rt_v2, rt_s2, rt_d2, rt_n2, a2, v2, t2, gentime_2;
+    auto model_copy = model;
+    model_copy.get_db().reproductive_number(rt_v2, rt_s2, rt_d2, rt_n2);
+    model_copy.get_db().generation_time(a2, v2, t2, gentime_2);
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE(n > 100u);
+    REQUIRE(rt_0 == rt_1);
+    REQUIRE(rt_0 == rt_map);
+    REQUIRE_THAT(gentime_0, Catch::Equals(gentime_1));
+    REQUIRE_THAT(agent_id, Catch::Equals(target));
+    REQUIRE_THAT(time, Catch::Equals(date));
+    REQUIRE(model_copy.get_db().is_incremental_stats_on());
+    REQUIRE_THAT(rt_n, Catch::Equals(rt_n2));
+    REQUIRE_THAT(rt_s, Catch::Equals(rt_s2));
+    REQUIRE_THAT(gentime_1, Catch::Equals(gentime_2));
+    #endif
+
+    #ifndef CATCH_CONFIG_MAIN
+    return 0;
+    #endif
+
+}
@@ -0,0 +1,140 @@
+#ifndef CATCH_CONFIG_MAIN
+#define EPI_DEBUG
+#endif
+
+#include "tests.hpp"
+
+using namespace epiworld;
+
+EPIWORLD_TEST_CASE("Transmission log", "[transmission-log]") {
+
+    epimodels::ModelSEIRCONN<> model("a virus", 5000, 0.01, 4.0, 0.5, 0.3, 0.2);
+    model.verbose_off();
+
+    // Every transmission
+    model.run(60, 1412);
+
+    std::vector< int > date, source, target, virus, expo;
+    model.get_db().get_transmissions(date, source, target, virus, expo);
+
+    std::vector< int > hist, rt, rt_v, rt_s, rt_d, gentime, a, v, t;
+    model.get_db().get_hist_total(nullptr, nullptr, &hist);
+    model.get_db().reproductive_number(rt_v, rt_s, rt_d, rt);
+    model.get_db().generation_time(a, v, t, gentime);
+
+    size_t n = date.size();
+    auto & log = model.get_db().get_transmission_log();
+    bool complete = log.is_complete();
+
+    // Ring buffer: only the last 100
+    log.set_capacity(100u);
+    model.run(60, 1412);
+
+    std::vector< int > date_r, source_r, target_r, virus_r, expo_r;
+    model.get_db().get_transmissions(
+        date_r, source_r, target_r, virus_r, expo_r
+        );
+
+    bool ring_complete = log.is_complete();
+
+    // Spilling to disk
+    log.clear();
+    log.set_capacity(64u, true);
+    model.run(60, 1412);
+
+    std::vector< int > date_s, source_s, target_s, virus_s, expo_s;
+    model.get_db().get_transmissions(
+        date_s, source_s, target_s, virus_s, expo_s
+        );
+
+    auto model_copy = model;
+    std::vector< int > target_c, tmp;
+    model_copy.get_db().get_transmissions(tmp, tmp, target_c, tmp, tmp);
+
+    // Sampling does not change the simulation
+    log.clear();
+    log.set_capacity(0u);
+    log.set_sampling(0.5);
+    model.run(60, 1412);
+
+    std::vector< int > hist_p;
+    model.get_db().get_hist_total(nullptr, nullptr, &hist_p);
+    size_t n_sampled = log.size();
+
+    model.run(60, 1412);
+    size_t n_sampled_again = log.size();
+
+    log.set_sampling(1.0);
+    log.set_sampling_viruses({1});
+    model.run(60, 1412);
+    size_t n_other_virus = log.size();
+
+    // Without the log, incremental statistics still see every transmission
+    log.set_sampling_viruses({});
+    log.off();
+    model.get_db().incremental_stats_on();
+    model.run(60, 1412);
+
+    std::vector< int > rt_o, rt_vo, rt_so, rt_do;
+    model.get_db().reproductive_number(rt_vo, rt_so, rt_do, rt_o);
+    size_t n_kept_off = log.size();
+    size_t n_seen_off = log.get_n_seen();
+
+    // Same with the ring buffer. Without incremental statistics, R is not
+    // computed from the last 100 transmissions only
+    std::vector< int > rt_r, rt_vr, rt_sr, rt_dr;
+    log.on();
+    log.set_capacity(100u);
+    model.run(60, 1412);
+    model.get_db().reproductive_number(rt_vr, rt_sr, rt_dr, rt_r);
+
+    epimodels::ModelSEIRCONN<> model_ring(model);
+    model_ring.get_db().incremental_stats_off();
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE(complete);
+    REQUIRE(n > 200u);
+
+    REQUIRE_FALSE(ring_complete);
+    REQUIRE(date_r.size() == 100u);
+    REQUIRE_THAT(
+        target_r,
+        Catch::Equals(std::vector< int >(target.end() - 100, target.end()))
+        );
+    REQUIRE_THAT(
+        date_r,
+        Catch::Equals(std::vector< int >(date.end() - 100, date.end()))
+        );
+
+    REQUIRE_THAT(date_s, Catch::Equals(date));
+    REQUIRE_THAT(source_s, Catch::Equals(source));
+    REQUIRE_THAT(target_s, Catch::Equals(target));
+    REQUIRE_THAT(virus_s, Catch::Equals(virus));
+    REQUIRE_THAT(expo_s, Catch::Equals(expo));
+    REQUIRE_THAT(target_c, Catch::Equals(target));
+
+    REQUIRE_THAT(hist_p, Catch::Equals(hist));
+    REQUIRE(n_sampled > n / 3);
+    REQUIRE(n_sampled < 2 * n / 3);
+    REQUIRE(n_sampled == n_sampled_again);
+    REQUIRE(n_other_virus == 0u);
+
+    REQUIRE(n_kept_off == 0u);
+    REQUIRE(n_seen_off == n);
+    REQUIRE_THAT(rt_o, Catch::Equals(rt));
+    REQUIRE_THAT(rt_so, Catch::Equals(rt_s));
+    REQUIRE_THAT(rt_r, Catch::Equals(rt));
+    REQUIRE_THROWS(model.get_db().generation_time(a, v, t, gentime));
+    REQUIRE_THROWS_AS(
+        model_ring.get_db().reproductive_number(rt_vr, rt_sr, rt_dr, rt_r),
+        std::logic_error
+        );
+    REQUIRE_THROWS(log.set_sampling(1.5));
+    REQUIRE_THROWS(TransmissionLog().set_capacity(0u, true));
+    #endif
+
+    #ifndef CATCH_CONFIG_MAIN
+    return 0;
+    #endif
+
+}
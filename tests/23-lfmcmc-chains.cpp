@@ -0,0 +1,157 @@
+#ifndef CATCH_CONFIG_MAIN
+#define EPI_DEBUG
+#endif
+
+#include "tests.hpp"
+
+using namespace epiworld;
+
+EPIWORLD_TEST_CASE("LFMCMC chains", "[lfmcmc-chains]") {
+
+    typedef std::vector< epiworld_double > vec_dbl;
+
+    auto rand = std::make_shared< std::mt19937 >();
+    rand->seed(2231);
+    std::normal_distribution< epiworld_double > rnorm(5, 1.5);
+
+    vec_dbl obsdata;
+    for (size_t i = 0u; i < 5000; ++i)
+        obsdata.push_back(rnorm(*rand));
+
+    auto simfun = [](
+        const vec_dbl & p,
+        LFMCMC< vec_dbl > * m
+    ) -> vec_dbl {
+
+        if (m->get_chain_id() >= 4u)
+            throw std::logic_error("There are only four chains.");
+
+        vec_dbl res(500u);
+        for (auto & r : res)
+            r = m->rnorm(p[0u], p[1u]);
+
+        return res;
+
+    };
+
+    auto sumfun = [](vec_dbl & res, const vec_dbl & x, LFMCMC< vec_dbl > *) {
+
+        res.assign(2u, 0.0);
+        epiworld_double n = static_cast< epiworld_double >(x.size());
+        for (auto & v : x)
+            res[0u] += v / n;
+
+        for (auto & v : x)
+            res[1u] += std::pow(v - res[0u], 2.0) / (n - 1.0);
+
+        res[1u] = std::sqrt(res[1u]);
+
+    };
+
+    LFMCMC< vec_dbl > model(obsdata);
+    model.set_rand_engine(rand);
+    model.set_simulation_fun(simfun);
+    model.set_summary_fun(sumfun);
+    model.set_proposal_fun(
+        make_proposal_norm_reflective< vec_dbl >(.2, .0000001, 10)
+        );
+    model.set_kernel_fun([](
+        const vec_dbl & sim,
+        const vec_dbl & obs,
+        epiworld_double eps,
+        LFMCMC< vec_dbl > *
+    ) -> epiworld_double {
+        epiworld_double d = std::pow(sim[0u] - obs[0u], 2.0) +
+            std::pow(sim[1u] - obs[1u], 2.0);
+        return std::exp(-.5 * d / (eps * eps));
+    });
+
+    // Chains starting at different points
+    std::vector< vec_dbl > inits = {{1, 1}, {9, 3}, {3, 5}, {7, 0.5}};
+
+    model.run_chains(inits, 5000, 0.25, 1331, 1);
+    auto params_1 = model.get_accepted_params();
+    auto means_1  = model.get_mean_params();
+    auto rhat_1   = model.get_rhat(2500);
+    auto chain    = model.get_sample_chain();
+
+    model.run_chains(inits, 5000, 0.25, 1331, 4);
+    auto params_4 = model.get_accepted_params();
+
+    model.print(2500);
+
+    // Computing R-hat by hand
+    std::vector< epiworld_double > rhat_0(2u);
+    for (size_t k = 0u; k < 2u; ++k)
+    {
+
+        std::vector< epiworld_double > means(4u, 0.0), vars(4u, 0.0);
+        for (size_t c = 0u; c < 4u; ++c)
+        {
+
+            for (size_t i = 2500u; i < 5000u; ++i)
+                means[c] += params_1[(c * 5000u + i) * 2u + k] / 2500.0;
+
+            for (size_t i = 2500u; i < 5000u; ++i)
+                vars[c] += std::pow(
+                    params_1[(c * 5000u + i) * 2u + k] - means[c], 2.0
+                    ) / 2499.0;
+
+        }
+
+        epiworld_double w = 0.0, mean = 0.0, b = 0.0;
+        for (size_t c = 0u; c < 4u; ++c)
+        {
+            w    += vars[c] / 4.0;
+            mean += means[c] / 4.0;
+        }
+
+        for (size_t c = 0u; c < 4u; ++c)
+            b += 2500.0 * std::pow(means[c] - mean, 2.0) / 3.0;
+
+        rhat_0[k] = std::sqrt((2499.0 / 2500.0 * w + b / 2500.0) / w);
+
+    }
+
+    // Chains that barely move do not mix
+    model.set_proposal_fun(
+        make_proposal_norm_reflective< vec_dbl >(.001, .0000001, 10)
+        );
+    model.run_chains(inits, 500, 0.25, 1331, 2);
+    auto rhat_stuck = model.get_rhat();
+
+    // A single chain behaves as run()
+    model.run_chains({1, 1}, 2000, 0.25, 1u, 1331);
+    auto rhat_single = model.get_rhat();
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE(model.get_n_chains() == 1u);
+    REQUIRE(std::isnan(rhat_single[0u]));
+    REQUIRE(chain.size() == 20000u);
+    REQUIRE(chain[4999u] == 0u);
+    REQUIRE(chain[5000u] == 1u);
+    REQUIRE(chain[19999u] == 3u);
+    REQUIRE(params_1.size() == 40000u);
+
+    // Same results regardless of the number of threads
+    REQUIRE_THAT(params_1, Catch::Equals(params_4));
+
+    std::vector< epiworld_double > expected = {5.0, 1.5};
+    REQUIRE_THAT(means_1, Catch::Approx(expected).margin(0.5));
+
+    // Chains mixed after the burnin
+    REQUIRE(rhat_1[0u] < 1.1);
+    REQUIRE(rhat_1[1u] < 1.1);
+    REQUIRE_THAT(rhat_1, Catch::Approx(rhat_0).epsilon(1e-8));
+    REQUIRE(rhat_stuck[0u] > 2.0);
+
+    REQUIRE_THROWS(model.run_chains(std::vector< vec_dbl >(), 100, 0.25));
+    REQUIRE_THROWS(model.run_chains({{1, 1}, {1}}, 100, 0.25));
+    REQUIRE_THROWS(model.run_chains({1, 1}, 100, 0.25, 5u, -1, 2));
+    #endif
+
+    #ifndef CATCH_CONFIG_MAIN
+    return 0;
+    #endif
+
+}
@@ -0,0 +1,147 @@
+#ifndef CATCH_CONFIG_MAIN
+#define EPI_DEBUG
+#endif
+
+#include "tests.hpp"
+
+using namespace epiworld;
+
+EPIWORLD_TEST_CASE("ABC-SMC", "[abcsmc]") {
+
+    typedef std::vector< epiworld_double > vec_dbl;
+
+    auto rand = std::make_shared< std::mt19937 >();
+    rand->seed(8812);
+    std::normal_distribution< epiworld_double > rnorm(5, 1.5);
+
+    vec_dbl obsdata;
+    for (size_t i = 0u; i < 5000; ++i)
+        obsdata.push_back(rnorm(*rand));
+
+    auto simfun = [](const vec_dbl & p, LFMCMC< vec_dbl > * m) -> vec_dbl {
+
+        if (m->get_chain_id() >= 4u)
+            throw std::logic_error("There are only four threads.");
+
+        vec_dbl res(500u);
+        for (auto & r : res)
+            r = m->rnorm(p[0u], p[1u]);
+
+        return res;
+
+    };
+
+    auto sumfun = [](vec_dbl & res, const vec_dbl & x, LFMCMC< vec_dbl > *) {
+
+        res.assign(2u, 0.0);
+        epiworld_double n = static_cast< epiworld_double >(x.size());
+        for (auto & v : x)
+            res[0u] += v / n;
+
+        for (auto & v : x)
+            res[1u] += std::pow(v - res[0u], 2.0) / (n - 1.0);
+
+        res[1u] = std::sqrt(res[1u]);
+
+    };
+
+    auto kernfun = [](
+        const vec_dbl & sim,
+        const vec_dbl & obs,
+        epiworld_double eps,
+        LFMCMC< vec_dbl > *
+    ) -> epiworld_double {
+        epiworld_double d = std::pow(sim[0u] - obs[0u], 2.0) +
+            std::pow(sim[1u] - obs[1u], 2.0);
+        return std::exp(-.5 * d / (eps * eps));
+    };
+
+    LFMCMC< vec_dbl > sampler(obsdata);
+    sampler.set_rand_engine(rand);
+    sampler.set_simulation_fun(simfun);
+    sampler.set_summary_fun(sumfun);
+    sampler.set_kernel_fun(kernfun);
+
+    ABCSMC< vec_dbl > smc(sampler);
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE_THROWS(smc.run(100, 0.1));
+    REQUIRE_THROWS(smc.set_prior_uniform({0, 0}, {10}));
+    REQUIRE_THROWS(smc.set_ess_fraction(1.0));
+    #endif
+
+    smc.set_prior_uniform({0.0, 0.1}, {10.0, 5.0});
+    smc.run(500, 0.1, 123, 1);
+
+    auto particles_1 = smc.get_particles();
+    auto weights_1   = smc.get_weights();
+    auto means       = smc.get_mean_params();
+    auto epsilons    = smc.get_epsilons();
+
+    smc.print();
+
+    smc.run(500, 0.1, 123, 4);
+
+    bool decreasing = true;
+    for (size_t i = 1u; i < epsilons.size(); ++i)
+        decreasing &= epsilons[i] < epsilons[i - 1u];
+
+    epiworld_double weight_sum = 0.0;
+    for (auto & w : weights_1)
+        weight_sum += w;
+
+    // Once the kernel is zero for every particle, the run stops
+    size_t nsims = 0u;
+    auto simfun_0 = [&nsims](const vec_dbl & p, LFMCMC< vec_dbl > * m) -> vec_dbl {
+        ++nsims;
+        return vec_dbl(500u, m->rnorm(p[0u], p[1u]));
+    };
+
+    auto kernfun_0 = [&nsims, kernfun](
+        const vec_dbl & sim,
+        const vec_dbl & obs,
+        epiworld_double eps,
+        LFMCMC< vec_dbl > * m
+    ) -> epiworld_double {
+        return (nsims > 100u) ? 0.0 : kernfun(sim, obs, eps, m);
+    };
+
+    LFMCMC< vec_dbl > sampler_0(sampler);
+    sampler_0.set_simulation_fun(simfun_0);
+    sampler_0.set_kernel_fun(kernfun_0);
+
+    ABCSMC< vec_dbl > smc_0(sampler_0);
+    smc_0.set_prior_uniform({0.0, 0.1}, {10.0, 5.0});
+    smc_0.set_min_acceptance(0.0);
+    smc_0.run(100, 0.1, 123, 1);
+
+    bool finite_weights = true;
+    for (auto & w : smc_0.get_weights())
+        finite_weights &= std::isfinite(w);
+
+    #ifdef CATCH_CONFIG_MAIN
+    std::vector< epiworld_double > expected = {5.0, 1.5};
+    REQUIRE_THAT(means, Catch::Approx(expected).margin(0.2));
+    REQUIRE(epsilons.back() == 0.1);
+    REQUIRE(decreasing);
+    REQUIRE(std::abs(weight_sum - 1.0) < 1e-8);
+    REQUIRE(particles_1.size() == 1000u);
+    REQUIRE(smc.get_n_simulations() <= 500u * (epsilons.size() + 1u));
+
+    // Same results regardless of the number of threads
+    REQUIRE_THAT(particles_1, Catch::Equals(smc.get_particles()));
+    REQUIRE_THAT(weights_1, Catch::Equals(smc.get_weights()));
+
+    REQUIRE(smc_0.get_acceptance().back() == 0.0);
+    REQUIRE(smc_0.get_epsilons().size() == 2u);
+    REQUIRE(finite_weights);
+    #ifdef _OPENMP
+    REQUIRE_THROWS(smc.run(500, 0.1, 123, 5));
+    #endif
+    #endif
+
+    #ifndef CATCH_CONFIG_MAIN
+    return 0;
+    #endif
+
+}
@@ -0,0 +1,118 @@
+#ifndef CATCH_CONFIG_MAIN
+#define EPI_DEBUG
+#endif
+
+#include "tests.hpp"
+
+using namespace epiworld;
+
+EPIWORLD_TEST_CASE("LFMCMC early rejection", "[early-rejection]") {
+
+    typedef std::vector< epiworld_double > vec_dbl;
+
+    epimodels::ModelSIR<> model("a virus", 0.01, .5, .3);
+    model.agents_smallworld(2000, 5, false, 0.01);
+    model.verbose_off();
+
+    // Cumulative cases
+    auto cases = [](Model<> * m) -> epiworld_double {
+        return static_cast< epiworld_double >(
+            m->size() - m->get_db().get_today_total("Susceptible")
+            );
+    };
+
+    // Observed data and a stop function
+    model.run(50, 331);
+    epiworld_double observed = cases(&model);
+
+    int ndays = 0;
+    model.set_stop_fun([](Model<> * m) -> bool {
+        return m->today() >= 9;
+    });
+    model.run(50, 331);
+    ndays = model.today();
+    bool stopped = model.get_stopped_early();
+
+    model.set_stop_fun(nullptr);
+    model.run(50, 331);
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE(stopped);
+    REQUIRE(ndays == 9);
+    REQUIRE(!model.get_stopped_early());
+    REQUIRE(cases(&model) == observed);
+    #endif
+
+    // Calibrating the transmission rate
+    bool early = false;
+    int days_simulated = 0;
+    auto simfun = [&](const vec_dbl & p, LFMCMC< vec_dbl > * m) -> vec_dbl {
+
+        model.set_param("Transmission rate", p[0u]);
+
+        // Cumulative cases only go up, so once they exceed the observed
+        // ones by epsilon the kernel score is zero
+        if (early)
+            model.set_stop_fun([m, &cases, observed](Model<> * mod) -> bool {
+
+                if (cases(mod) - observed < m->get_epsilon())
+                    return false;
+
+                return m->reject_proposal(0.0);
+
+            });
+        else
+            model.set_stop_fun(nullptr);
+
+        model.run(50, static_cast< int >(
+            std::floor(m->runif() * 2147483647.0)
+            ));
+
+        days_simulated += model.today();
+
+        return {cases(&model)};
+
+    };
+
+    auto sumfun = [](vec_dbl & res, const vec_dbl & x, LFMCMC< vec_dbl > *) {
+        res = x;
+    };
+
+    LFMCMC< vec_dbl > sampler({observed});
+    auto engine = std::make_shared< std::mt19937 >();
+    sampler.set_rand_engine(engine);
+    sampler.set_simulation_fun(simfun);
+    sampler.set_summary_fun(sumfun);
+    sampler.set_proposal_fun(make_proposal_norm_reflective< vec_dbl >(.1, 0, 1));
+    sampler.set_kernel_fun(kernel_fun_uniform< vec_dbl >);
+
+    sampler.run({.5}, 300, 50, 1412);
+    auto params_0 = sampler.get_accepted_params();
+    auto scores_0 = sampler.get_accepted_kernel_scores();
+    int days_0    = days_simulated;
+
+    early = true;
+    days_simulated = 0;
+    sampler.run({.5}, 300, 50, 1412);
+    auto params_1 = sampler.get_accepted_params();
+    auto scores_1 = sampler.get_accepted_kernel_scores();
+    int days_1    = days_simulated;
+
+    size_t n_nan = 0u;
+    for (auto & s : sampler.get_sample_stats())
+        n_nan += std::isnan(s) ? 1u : 0u;
+
+    #ifdef CATCH_CONFIG_MAIN
+    // Same samples with fewer simulated days
+    REQUIRE(sampler.get_n_rejected_early() > 0u);
+    REQUIRE(n_nan == sampler.get_n_rejected_early());
+    REQUIRE_THAT(params_0, Catch::Equals(params_1));
+    REQUIRE_THAT(scores_0, Catch::Equals(scores_1));
+    REQUIRE(days_1 < days_0);
+    #endif
+
+    #ifndef CATCH_CONFIG_MAIN
+    return 0;
+    #endif
+
+}
@@ -0,0 +1,138 @@
+#ifndef CATCH_CONFIG_MAIN
+#define EPI_DEBUG
+#endif
+
+#include "tests.hpp"
+
+using namespace epiworld;
+
+EPIWORLD_TEST_CASE("LFMCMC cache", "[lfmcmc-cache]") {
+
+    typedef std::vector< epiworld_double > vec_dbl;
+
+    // Reusing cells
+    LFMCMCCache cache;
+    vec_dbl stats;
+    cache.set({0.1}, 2u, 0u, 1u);
+
+    bool miss_empty = !cache.lookup({0.51}, stats);
+    size_t n_cells_empty = cache.size();
+    cache.store({0.51}, {1.0});
+    bool hit_1  = cache.lookup({0.55}, stats);
+    bool hit_2  = cache.lookup({0.59}, stats);
+    bool miss_3 = !cache.lookup({0.52}, stats);
+    bool miss_other = !cache.lookup({0.61}, stats);
+    cache.store({0.52}, {2.0});
+    bool hit_new = cache.lookup({0.50}, stats);
+
+    // Nearest neighbors
+    LFMCMCCache cache_knn;
+    vec_dbl stats_knn;
+    cache_knn.set({1.0, 1.0}, 5u, 2u, 1u);
+    cache_knn.store({0.5, 0.5}, {1.0});
+    cache_knn.store({1.5, 0.5}, {3.0});
+    cache_knn.store({5.5, 0.5}, {100.0});
+    bool knn_hit  = cache_knn.lookup({1.0, 0.6}, stats_knn);
+    bool knn_miss = !cache_knn.lookup({4.0, 0.6}, stats_knn);
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE(miss_empty);
+    REQUIRE(n_cells_empty == 0u);
+    REQUIRE(hit_1);
+    REQUIRE(hit_2);
+    REQUIRE(miss_3);
+    REQUIRE(miss_other);
+    REQUIRE(hit_new);
+    REQUIRE(stats[0u] == 2.0);
+    REQUIRE(knn_hit);
+    REQUIRE(knn_miss);
+    REQUIRE(cache_knn.size() == 3u);
+    REQUIRE(stats_knn[0u] == 2.0);
+    REQUIRE_THROWS(cache.set({0.0}, 1u, 0u, 1u));
+    REQUIRE_THROWS(cache.set({}, 1u, 0u, 1u));
+    REQUIRE_THROWS(cache_knn.lookup({1.0, 1.0, 1.0}, stats_knn));
+    #endif
+
+    // Using the cache in LFMCMC
+    auto rand = std::make_shared< std::mt19937 >();
+    rand->seed(5523);
+    std::normal_distribution< epiworld_double > rnorm(5, 1.5);
+
+    vec_dbl obsdata;
+    for (size_t i = 0u; i < 5000; ++i)
+        obsdata.push_back(rnorm(*rand));
+
+    size_t n_sims = 0u;
+    auto simfun = [&n_sims](const vec_dbl & p, LFMCMC< vec_dbl > * m) -> vec_dbl {
+
+        ++n_sims;
+        vec_dbl res(500u);
+        for (auto & r : res)
+            r = m->rnorm(p[0u], p[1u]);
+
+        return res;
+
+    };
+
+    auto sumfun = [](vec_dbl & res, const vec_dbl & x, LFMCMC< vec_dbl > *) {
+
+        res.assign(2u, 0.0);
+        epiworld_double n = static_cast< epiworld_double >(x.size());
+        for (auto & v : x)
+            res[0u] += v / n;
+
+        for (auto & v : x)
+            res[1u] += std::pow(v - res[0u], 2.0) / (n - 1.0);
+
+        res[1u] = std::sqrt(res[1u]);
+
+    };
+
+    LFMCMC< vec_dbl > model(obsdata);
+    model.set_rand_engine(rand);
+    model.set_simulation_fun(simfun);
+    model.set_summary_fun(sumfun);
+    model.set_proposal_fun(
+        make_proposal_norm_reflective< vec_dbl >(.05, .0000001, 10)
+        );
+    model.set_kernel_fun(kernel_fun_gaussian< vec_dbl >);
+
+    model.run({4.5, 1}, 5000, .125, 771);
+    size_t hits_off = model.get_n_cache_hits();
+    size_t sims_off = n_sims;
+
+    n_sims = 0u;
+    model.set_cache({.05, .05}, 3u);
+    model.run({4.5, 1}, 5000, .125, 771);
+    size_t hits_on = model.get_n_cache_hits();
+    size_t sims_on = n_sims;
+    auto params_1 = model.get_accepted_params();
+    auto means    = model.get_mean_params();
+
+    model.run({4.5, 1}, 5000, .125, 771);
+    auto params_2 = model.get_accepted_params();
+
+    model.set_cache({.05}, 3u, 3u, 1u);
+    model.run({4.5, 1}, 5000, .125, 771);
+    size_t hits_knn = model.get_n_cache_hits();
+
+    model.cache_off();
+    model.run({4.5, 1}, 100, .125, 771);
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE(hits_off == 0u);
+    REQUIRE(hits_on > 0u);
+    REQUIRE(sims_on + hits_on == sims_off);
+    REQUIRE(hits_knn > hits_on);
+    REQUIRE(model.get_n_cache_hits() == 0u);
+    REQUIRE_THAT(params_1, Catch::Equals(params_2));
+
+    std::vector< epiworld_double > expected = {5.0, 1.5};
+    REQUIRE_THAT(means, Catch::Approx(expected).margin(0.5));
+    #endif
+
+    #ifndef CATCH_CONFIG_MAIN
+    return 0;
+    #endif
+
+}
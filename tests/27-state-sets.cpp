@@ -0,0 +1,142 @@
+#ifndef CATCH_CONFIG_MAIN
+#define EPI_DEBUG
+#endif
+
+#include "tests.hpp"
+
+using namespace epiworld;
+
+// Compares the tracked set against a scan of the population
+template<typename TSeq>
+inline bool state_set_matches(
+    Model<TSeq> * m,
+    epiworld_fast_uint state,
+    int group = -1
+) {
+
+    std::vector< size_t > expected;
+    for (auto & a : m->get_agents())
+    {
+
+        if (a.get_state() != state)
+            continue;
+
+        if (group >= 0)
+        {
+            if ((a.get_n_entities() == 0u) ||
+                (a.get_entity(0u).get_id() != group))
+                continue;
+        }
+
+        expected.push_back(static_cast< size_t >(a.get_id()));
+
+    }
+
+    std::vector< size_t > tracked = m->get_agents_in_state(
+        state, group >= 0 ? static_cast< size_t >(group) : 0u
+        );
+
+    std::sort(tracked.begin(), tracked.end());
+
+    return tracked == expected;
+
+}
+
+EPIWORLD_TEST_CASE("State sets", "[state-sets]") {
+
+    // Connected model: checked every day
+    int n_wrong_conn = 0;
+    int n_checks     = 0;
+    epimodels::ModelSEIRCONN<> model_conn(
+        "a virus", 10000u, 0.01, 4.0, .5, 4.0, 1.0/7.0
+        );
+
+    model_conn.add_globalevent(
+        [&n_wrong_conn, &n_checks](Model<> * m) -> void {
+            ++n_checks;
+            if (!state_set_matches(m, epimodels::ModelSEIRCONN<>::INFECTED))
+                ++n_wrong_conn;
+        },
+        "Check sets"
+        );
+
+    model_conn.verbose_off();
+    model_conn.run(60, 1231);
+
+    size_t n_infected = static_cast< size_t >(
+        model_conn.get_db().get_today_total("Infected")
+        );
+
+    int n_checks_run = n_checks;
+
+    // Copies keep tracking their own agents (and run the checks too)
+    epimodels::ModelSEIRCONN<> model_copy(model_conn);
+    model_copy.run(60, 1231);
+
+    // Mixing model: checked every day per entity
+    int n_wrong_mix = 0;
+    std::vector< double > contact_matrix = {
+        0.8, 0.1, 0.1,
+        0.1, 0.8, 0.1,
+        0.1, 0.1, 0.8
+    };
+
+    epimodels::ModelSIRMixing<> model_mix(
+        "Flu", 9000, 0.01, 10.0, 0.1, 1.0/7.0, contact_matrix
+        );
+
+    model_mix.add_entity(Entity<>("A", dist_factory<>(0, 3000)));
+    model_mix.add_entity(Entity<>("B", dist_factory<>(3000, 6000)));
+    model_mix.add_entity(Entity<>("C", dist_factory<>(6000, 9000)));
+
+    model_mix.add_globalevent(
+        [&n_wrong_mix](Model<> * m) -> void {
+            for (int g = 0; g < 3; ++g)
+                if (!state_set_matches(m, epimodels::ModelSIRMixing<>::INFECTED, g))
+                    ++n_wrong_mix;
+        },
+        "Check sets"
+        );
+
+    model_mix.verbose_off();
+    model_mix.run(60, 331);
+
+    size_t n_infected_mix = 0u;
+    for (size_t g = 0u; g < 3u; ++g)
+        n_infected_mix += model_mix.get_n_infected(g);
+
+    // Opt-in tracking in a plain model
+    epimodels::ModelSIR<> model_sir("a virus", 0.01, .5, .3);
+    model_sir.agents_smallworld(1000, 5, false, 0.01);
+    model_sir.verbose_off();
+    model_sir.track_state(2u); // Recovered
+    model_sir.run(30, 22);
+
+    bool sir_ok = state_set_matches(&model_sir, 2u);
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE(n_checks_run == 60);
+    REQUIRE(n_checks == 120);
+    REQUIRE(n_wrong_conn == 0);
+    REQUIRE(model_conn.get_n_infected() == n_infected);
+    REQUIRE(state_set_matches(&model_copy, epimodels::ModelSEIRCONN<>::INFECTED));
+    REQUIRE(model_copy.get_n_infected() == n_infected);
+    REQUIRE(n_wrong_mix == 0);
+    REQUIRE(n_infected_mix == static_cast< size_t >(
+        model_mix.get_db().get_today_total("Infected")
+        ));
+    REQUIRE(sir_ok);
+    REQUIRE_THROWS(model_sir.get_agents_in_state(0u));
+    #endif
+
+    model_sir.track_states_off();
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE_THROWS(model_sir.get_agents_in_state(2u));
+    #endif
+
+    #ifndef CATCH_CONFIG_MAIN
+    return 0;
+    #endif
+
+}
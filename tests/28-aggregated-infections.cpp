@@ -0,0 +1,178 @@
+#ifndef CATCH_CONFIG_MAIN
+#define EPI_DEBUG
+#endif
+
+#include "tests.hpp"
+
+using namespace epiworld;
+
+// Mean and variance of the cases (non-susceptible agents) of each group
+template<typename TModel>
+inline void cases_moments(
+    TModel & model,
+    size_t nreps,
+    size_t ndays,
+    size_t ngroups,
+    std::vector< double > & mean,
+    std::vector< double > & var
+) {
+
+    mean.assign(ngroups, 0.0);
+    var.assign(ngroups, 0.0);
+    for (size_t r = 0u; r < nreps; ++r)
+    {
+
+        model.run(ndays, 100 + static_cast< int >(r));
+
+        std::vector< double > cases(ngroups, 0.0);
+        for (auto & a : model.get_agents())
+        {
+
+            if (a.get_state() == 0u)
+                continue;
+
+            size_t g = (ngroups > 1u) ?
+                static_cast< size_t >(a.get_entity(0u).get_id()) : 0u;
+
+            cases[g] += 1.0;
+
+        }
+
+        for (size_t g = 0u; g < ngroups; ++g)
+        {
+            mean[g] += cases[g] / nreps;
+            var[g]  += cases[g] * cases[g] / nreps;
+        }
+
+    }
+
+    for (size_t g = 0u; g < ngroups; ++g)
+        var[g] = (var[g] - mean[g] * mean[g]) * nreps / (nreps - 1.0);
+
+}
+
+// Whether the means are within four standard errors
+inline bool same_means(
+    const std::vector< double > & mean_0,
+    const std::vector< double > & var_0,
+    const std::vector< double > & mean_1,
+    const std::vector< double > & var_1,
+    size_t nreps
+) {
+
+    for (size_t g = 0u; g < mean_0.size(); ++g)
+    {
+
+        double se = std::sqrt((var_0[g] + var_1[g]) / nreps);
+        if (std::fabs(mean_0[g] - mean_1[g]) > 4.0 * se)
+        {
+            printf_epiworld(
+                "Group %i: %.2f vs %.2f (se %.2f)\n",
+                static_cast< int >(g), mean_0[g], mean_1[g], se
+                );
+            return false;
+        }
+
+    }
+
+    return true;
+
+}
+
+EPIWORLD_TEST_CASE("Aggregated infections", "[aggregated-infections]") {
+
+    size_t nreps = 200u;
+    std::vector< double > mean_0, var_0, mean_1, var_1;
+
+    // Connected model
+    epimodels::ModelSIRCONN<> model_conn(
+        "a virus", 2000u, 0.01, 4.0, 0.3, 1.0/7.0
+        );
+    model_conn.verbose_off();
+
+    cases_moments(model_conn, nreps, 10u, 1u, mean_0, var_0);
+
+    model_conn.aggregated_infections_on();
+    cases_moments(model_conn, nreps, 10u, 1u, mean_1, var_1);
+
+    bool same_conn = same_means(mean_0, var_0, mean_1, var_1, nreps);
+
+    // Reproducible
+    model_conn.run(10, 55);
+    auto counts_0 = model_conn.get_db().get_today_total("Susceptible");
+    model_conn.run(10, 55);
+    auto counts_1 = model_conn.get_db().get_today_total("Susceptible");
+
+    // Certain transmission (p = 1)
+    model_conn.set_param("Transmission rate", 1.0);
+    model_conn.aggregated_infections_off();
+    cases_moments(model_conn, nreps, 4u, 1u, mean_0, var_0);
+
+    model_conn.aggregated_infections_on();
+    cases_moments(model_conn, nreps, 4u, 1u, mean_1, var_1);
+
+    bool same_certain = same_means(mean_0, var_0, mean_1, var_1, nreps);
+
+    // Mixing model (by group)
+    std::vector< double > contact_matrix = {
+        0.8, 0.15, 0.05,
+        0.1, 0.7, 0.2,
+        0.1, 0.15, 0.75
+    };
+
+    epimodels::ModelSEIRMixing<> model_mix(
+        "Flu", 3000, 0.01, 6.0, 0.2, 3.0, 1.0/5.0, contact_matrix
+        );
+
+    model_mix.add_entity(Entity<>("A", dist_factory<>(0, 1000)));
+    model_mix.add_entity(Entity<>("B", dist_factory<>(1000, 2000)));
+    model_mix.add_entity(Entity<>("C", dist_factory<>(2000, 3000)));
+    model_mix.verbose_off();
+
+    cases_moments(model_mix, nreps, 15u, 3u, mean_0, var_0);
+
+    model_mix.aggregated_infections_on();
+    cases_moments(model_mix, nreps, 15u, 3u, mean_1, var_1);
+
+    bool same_mix = same_means(mean_0, var_0, mean_1, var_1, nreps);
+
+    // Tools are not supported
+    epimodels::ModelSIRCONN<> model_tools(
+        "a virus", 500u, 0.05, 4.0, 0.3, 1.0/7.0
+        );
+    model_tools.verbose_off();
+    model_tools.aggregated_infections_on();
+
+    Tool<> mask("Mask", 0.5, true);
+    mask.set_transmission_reduction(.3);
+    model_tools.add_tool(mask);
+
+    // Infectors that lose their virus after the draw infect no one
+    epimodels::ModelSIRCONN<> model_cure(
+        "a virus", 2000u, 0.05, 4.0, 0.5, 1.0/7.0
+        );
+    model_cure.verbose_off();
+    model_cure.aggregated_infections_on();
+    model_cure.add_globalevent([](Model<> * m) -> void {
+        for (auto & a : m->get_agents())
+            if (a.get_virus() != nullptr)
+                a.rm_virus(m);
+    }, "Cure everyone");
+    model_cure.run(5, 12);
+    int infected_cure = model_cure.get_db().get_today_total("Infected");
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE(infected_cure == 0);
+    REQUIRE(same_conn);
+    REQUIRE(same_certain);
+    REQUIRE(same_mix);
+    REQUIRE(counts_0 == counts_1);
+    REQUIRE(model_conn.is_aggregated_infections_on());
+    REQUIRE_THROWS(model_tools.run(10, 1));
+    #endif
+
+    #ifndef CATCH_CONFIG_MAIN
+    return 0;
+    #endif
+
+}
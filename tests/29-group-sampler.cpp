@@ -0,0 +1,92 @@
+#ifndef CATCH_CONFIG_MAIN
+#define EPI_DEBUG
+#endif
+
+#include "tests.hpp"
+
+using namespace epiworld;
+
+EPIWORLD_TEST_CASE("GroupSampler", "[group-sampler]") {
+
+    // Contact matrix (column-major) and infected by group. The third group
+    // has no infected and the last one has many expected contacts
+    std::vector< double > contact_matrix = {
+        0.5, 0.2, 0.1, 0.0,
+        0.2, 0.5, 0.2, 0.1,
+        0.2, 0.2, 0.6, 0.1,
+        0.1, 0.1, 0.1, 0.8
+    };
+
+    std::vector< size_t > ninfected = {10u, 200u, 0u, 30000u};
+    double contact_rate = 0.0005;
+
+    GroupSampler<int> sampler;
+    sampler.update(contact_matrix, ninfected, contact_rate);
+
+    Model<> model;
+    model.seed(1231);
+
+    size_t nsamples = 100000u;
+    size_t origin   = 1u;
+    std::vector< double > mean(4u, 0.0), var(4u, 0.0);
+    std::vector< int > counts(4u);
+    double prop_zero = 0.0;
+    bool in_order = true;
+    for (size_t i = 0u; i < nsamples; ++i)
+    {
+
+        std::fill(counts.begin(), counts.end(), 0);
+        int last = -1;
+        int total = sampler.sample(&model, origin, [&](size_t g, int n) {
+            if (static_cast< int >(g) <= last)
+                in_order = false;
+
+            last = static_cast< int >(g);
+            counts[g] = n;
+        });
+
+        if (total == 0)
+            prop_zero += 1.0 / nsamples;
+
+        for (size_t g = 0u; g < 4u; ++g)
+        {
+            mean[g] += counts[g] / static_cast< double >(nsamples);
+            var[g]  += counts[g] * counts[g] / static_cast< double >(nsamples);
+        }
+
+    }
+
+    // Expected moments (independent binomials)
+    std::vector< double > expected_mean(4u), expected_var(4u);
+    double expected_zero = 1.0;
+    for (size_t g = 0u; g < 4u; ++g)
+    {
+
+        double r = contact_rate * contact_matrix[g * 4u + origin];
+        var[g] -= mean[g] * mean[g];
+        expected_mean[g] = ninfected[g] * r;
+        expected_var[g]  = ninfected[g] * r * (1.0 - r);
+        expected_zero   *= std::pow(1.0 - r, static_cast< double >(ninfected[g]));
+
+    }
+
+    // No infected or no contacts
+    std::vector< size_t > no_infected(4u, 0u);
+    sampler.update(contact_matrix, no_infected, contact_rate);
+    int total_none = sampler.sample(&model, origin, [](size_t, int) {});
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE(in_order);
+    REQUIRE(mean[2u] == 0.0);
+    REQUIRE_THAT(mean, Catch::Approx(expected_mean).margin(0.02));
+    REQUIRE_THAT(var, Catch::Approx(expected_var).margin(0.05));
+    REQUIRE(std::fabs(prop_zero - expected_zero) < 0.005);
+    REQUIRE(total_none == 0);
+    REQUIRE_THROWS(sampler.update({1.0}, ninfected, contact_rate));
+    #endif
+
+    #ifndef CATCH_CONFIG_MAIN
+    return 0;
+    #endif
+
+}
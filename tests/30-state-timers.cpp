@@ -0,0 +1,170 @@
+#ifndef CATCH_CONFIG_MAIN
+#define EPI_DEBUG
+#endif
+
+#include "tests.hpp"
+
+using namespace epiworld;
+
+// Mean and variance of the final counts of each state
+template<typename TModel>
+inline void final_counts_moments(
+    TModel & model,
+    size_t nreps,
+    size_t ndays,
+    std::vector< double > & mean,
+    std::vector< double > & var
+) {
+
+    size_t nstates = model.get_states().size();
+    mean.assign(nstates, 0.0);
+    var.assign(nstates, 0.0);
+
+    std::vector< int > counts;
+    for (size_t r = 0u; r < nreps; ++r)
+    {
+
+        model.run(ndays, 200 + static_cast< int >(r));
+        model.get_db().get_today_total(nullptr, &counts);
+
+        for (size_t s = 0u; s < nstates; ++s)
+        {
+            double c = counts[s];
+            mean[s] += c / nreps;
+            var[s]  += c * c / nreps;
+        }
+
+    }
+
+    for (size_t s = 0u; s < nstates; ++s)
+        var[s] = (var[s] - mean[s] * mean[s]) * nreps / (nreps - 1.0);
+
+}
+
+EPIWORLD_TEST_CASE("State timers", "[state-timers]") {
+
+    // Infected agents die or recover (default_update_exposed), with no new
+    // infections. After k days, P(infected) = P(none)^k (as a proportion of
+    // the 5,000 infected, so the susceptible are 1)
+    Model<> model;
+    model.add_state("Susceptible");
+    model.add_state("Infected", default_update_exposed<>);
+    model.add_state("Recovered");
+    model.add_state("Deceased");
+
+    Virus<> virus("a virus", 0.5, true);
+    virus.set_state(1, 2, 3);
+    virus.set_prob_infecting(0.0);
+    virus.set_prob_death(0.1);
+    virus.set_prob_recovery(0.2);
+    model.add_virus(virus);
+
+    model.agents_empty_graph(10000);
+    model.verbose_off();
+
+    double odds_die = 0.1 / 0.9;
+    double odds_rec = 0.2 / 0.8;
+    double p_inf    = std::pow(1.0 / (1.0 + odds_die + odds_rec), 5.0);
+    std::vector< double > expected = {
+        1.0,
+        p_inf,
+        (1.0 - p_inf) * odds_rec / (odds_die + odds_rec),
+        (1.0 - p_inf) * odds_die / (odds_die + odds_rec)
+    };
+
+    std::vector< double > mean_daily, var_daily, mean_timed, var_timed;
+    final_counts_moments(model, 20u, 5u, mean_daily, var_daily);
+
+    model.set_state_timer(
+        1u, default_timer_exposed<>, default_transition_exposed<>
+        );
+
+    final_counts_moments(model, 20u, 5u, mean_timed, var_timed);
+
+    std::vector< double > prop_daily(4u), prop_timed(4u);
+    for (size_t s = 0u; s < 4u; ++s)
+    {
+        prop_daily[s] = mean_daily[s] / 5000.0;
+        prop_timed[s] = mean_timed[s] / 5000.0;
+    }
+
+    bool timer_on = model.is_state_timer_on(1u);
+    model.state_timers_off();
+    bool timer_off = !model.is_state_timer_on(1u);
+
+    // Connected SEIR: same distribution as the daily update
+    size_t nreps = 100u;
+    epimodels::ModelSEIRCONN<> model_conn(
+        "a virus", 10000, 0.01, 4.0, 0.3, 3.0, 1.0/7.0
+        );
+    model_conn.verbose_off();
+
+    std::vector< double > mean_conn, var_conn;
+    final_counts_moments(model_conn, nreps, 40u, mean_conn, var_conn);
+
+    model_conn.event_driven_on();
+    final_counts_moments(model_conn, nreps, 40u, mean_timed, var_timed);
+
+    bool same_conn = true;
+    for (size_t s = 0u; s < mean_conn.size(); ++s)
+    {
+
+        double se = std::sqrt((var_conn[s] + var_timed[s]) / nreps);
+        if (std::fabs(mean_conn[s] - mean_timed[s]) > 4.0 * se)
+        {
+            printf_epiworld(
+                "State %i: %.2f vs %.2f (se %.2f)\n",
+                static_cast< int >(s), mean_conn[s], mean_timed[s], se
+                );
+            same_conn = false;
+        }
+
+    }
+
+    // Reproducible, also when cloned
+    std::vector< int > hist_0, hist_1, hist_2;
+    model_conn.run(40, 55);
+    model_conn.get_db().get_hist_total(nullptr, nullptr, &hist_0);
+    model_conn.run(40, 55);
+    model_conn.get_db().get_hist_total(nullptr, nullptr, &hist_1);
+
+    epimodels::ModelSEIRCONN<> model_copy(model_conn);
+    model_copy.run(40, 55);
+    model_copy.get_db().get_hist_total(nullptr, nullptr, &hist_2);
+
+    // Results do not depend on the number of threads
+    std::vector< std::vector< int > > hists_parallel(2u);
+    for (int nthreads = 1; nthreads <= 2; ++nthreads)
+    {
+
+        epimodels::ModelSEIR<> model_seir("a virus", 0.01, .5, 4.0, .3);
+        model_seir.agents_smallworld(10000, 5, false, 0.01);
+        model_seir.verbose_off();
+        model_seir.event_driven_on();
+        model_seir.parallel_update_on(nthreads);
+        model_seir.run(50, 1231);
+        model_seir.get_db().get_hist_total(
+            nullptr, nullptr, &hists_parallel[nthreads - 1]
+            );
+
+    }
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE_THAT(prop_daily, Catch::Approx(expected).margin(0.01));
+    REQUIRE_THAT(prop_timed, Catch::Approx(expected).margin(0.01));
+    REQUIRE(timer_on);
+    REQUIRE(timer_off);
+    REQUIRE(same_conn);
+    REQUIRE_THAT(hist_0, Catch::Equals(hist_1));
+    REQUIRE_THAT(hist_0, Catch::Equals(hist_2));
+    REQUIRE_THAT(hists_parallel[0u], Catch::Equals(hists_parallel[1u]));
+    REQUIRE(Model<>().rgeom(1.0) == 1);
+    REQUIRE(Model<>().rgeom(0.0) == std::numeric_limits< int >::max());
+    REQUIRE_THROWS(Model<>().set_state_timer(0u, nullptr, nullptr));
+    #endif
+
+    #ifndef CATCH_CONFIG_MAIN
+    return 0;
+    #endif
+
+}
@@ -0,0 +1,77 @@
+#ifndef CATCH_CONFIG_MAIN
+#define EPI_DEBUG
+#endif
+
+#include "tests.hpp"
+
+using namespace epiworld;
+
+EPIWORLD_TEST_CASE("Queue", "[queue]") {
+
+    // Only the agents in the queue are visited, so the list of active
+    // agents must match the counts
+    epimodels::ModelSIR<> model("a virus", 0.01, 0.5, 0.3);
+    model.agents_smallworld(5000, 4, false, 0.01);
+    model.verbose_off();
+
+    bool matches = true;
+    bool sorted  = true;
+    std::vector< size_t > sizes;
+    model.add_globalevent([&](Model<> * m) -> void {
+
+        auto & queue = m->get_queue();
+        const auto & ids = queue.get_active_sorted();
+
+        std::vector< size_t > expected;
+        for (size_t i = 0u; i < m->size(); ++i)
+            if (queue[i] > 0)
+                expected.push_back(i);
+
+        if (ids != expected)
+            matches = false;
+
+        if (!std::is_sorted(ids.begin(), ids.end()))
+            sorted = false;
+
+        sizes.push_back(queue.size());
+
+    }, "Check queue");
+
+    std::vector< int > hist_0, hist_1, hist_2;
+    model.run(60, 1231);
+    model.get_db().get_hist_total(nullptr, nullptr, &hist_0);
+
+    // Same results without queuing (agents out of the queue draw no
+    // random numbers)
+    model.queuing_off();
+    model.run(60, 1231);
+    model.get_db().get_hist_total(nullptr, nullptr, &hist_1);
+
+    // And with the parallel update
+    std::vector< int > hist_3;
+    model.queuing_on();
+    model.parallel_update_on(2);
+    model.run(60, 1231);
+    model.get_db().get_hist_total(nullptr, nullptr, &hist_2);
+
+    model.queuing_off();
+    model.run(60, 1231);
+    model.get_db().get_hist_total(nullptr, nullptr, &hist_3);
+
+    bool some_active = std::any_of(sizes.begin(), sizes.end(), [](size_t k) {
+        return (k > 0u) && (k < 5000u);
+    });
+
+    #ifdef CATCH_CONFIG_MAIN
+    REQUIRE(matches);
+    REQUIRE(sorted);
+    REQUIRE(some_active);
+    REQUIRE_THAT(hist_0, Catch::Equals(hist_1));
+    REQUIRE_THAT(hist_2, Catch::Equals(hist_3));
+    #endif
+
+    #ifndef CATCH_CONFIG_MAIN
+    return 0;
+    #endif
+
+}
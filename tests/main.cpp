@@ -19,4 +19,25 @@
 #include "06-mixing.cpp"
 #include "07-entitifuns.cpp"
 #include "09-distribute-tools-and-viruses.cpp"
-#include "10-generation-interval.cpp"
\ No newline at end of file
+#include "10-generation-interval.cpp"
+#include "11-roulette.cpp"
+#include "12-network-csr.cpp"
+#include "13-param-handle.cpp"
+#include "14-parallel-update.cpp"
+#include "15-runif-n.cpp"
+#include "16-db-history.cpp"
+#include "17-rgraph-edges.cpp"
+#include "18-edgelist-io.cpp"
+#include "19-write-data.cpp"
+#include "20-run-aggregator.cpp"
+#include "21-transmission-stats.cpp"
+#include "22-transmission-log.cpp"
+#include "23-lfmcmc-chains.cpp"
+#include "24-abcsmc.cpp"
+#include "25-early-rejection.cpp"
+#include "26-lfmcmc-cache.cpp"
+#include "27-state-sets.cpp"
+#include "28-aggregated-infections.cpp"
+#include "29-group-sampler.cpp"
+#include "30-state-timers.cpp"
+#include "31-queue.cpp"